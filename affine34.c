@@ -0,0 +1,163 @@
+#include "affine34.h"
+#include <assert.h>
+#include "batch.h"
+#include "dispatch_table.h"
+#include "scalar.h"
+#include "simd.h"
+
+XMATH_API bool Affine34EqualApprox(Affine34 a, Affine34 b) {
+  const float* as = &a.xx;
+  const float* bs = &b.xx;
+  for (unsigned i = 0; i < 12; i++) {
+    if (!FEqualApprox(as[i], bs[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+XMATH_API Affine34 Affine34Mul(Affine34 a, Affine34 b) {
+  Affine34 r;
+  Affine34MulTo(&r, &a, &b);
+  return r;
+}
+
+XMATH_API void Affine34MulTo(Affine34* XMATH_RESTRICT out,
+                             const Affine34* a,
+                             const Affine34* b) {
+  // Row i of b applied to the rows of a, the implicit (0, 0, 0, 1) row of a
+  // carries the translation of b.
+  F32x4 a0 = F32x4Load(&a->xx);
+  F32x4 a1 = F32x4Load(&a->yx);
+  F32x4 a2 = F32x4Load(&a->zx);
+  F32x4 a3 = F32x4Set(0.0f, 0.0f, 0.0f, 1.0f);
+  for (unsigned i = 0; i < 12; i += 4) {
+    F32x4 row = F32x4Load(&b->xx + i);
+    F32x4 r = F32x4Mul(F32x4Swizzle(row, 0, 0, 0, 0), a0);
+    r = F32x4MulAdd(F32x4Swizzle(row, 1, 1, 1, 1), a1, r);
+    r = F32x4MulAdd(F32x4Swizzle(row, 2, 2, 2, 2), a2, r);
+    r = F32x4MulAdd(F32x4Swizzle(row, 3, 3, 3, 3), a3, r);
+    F32x4Store(&out->xx + i, r);
+  }
+}
+
+XMATH_API bool Affine34Invert(Affine34* XMATH_RESTRICT out, const Affine34* a) {
+  F32x4 mask = F32x4Set(1.0f, 1.0f, 1.0f, 0.0f);
+  F32x4 c[3];
+  if (!BatchInvert3Columns(c, F32x4Mul(F32x4Load(&a->xx), mask),
+                           F32x4Mul(F32x4Load(&a->yx), mask),
+                           F32x4Mul(F32x4Load(&a->zx), mask))) {
+    return false;
+  }
+
+  // The translation becomes -inverse * t, a combination of the columns that
+  // lands in the last lane of every row once transposed.
+  F32x4 t = F32x4Mul(c[0], F32x4Splat(-a->xw));
+  t = F32x4MulAdd(c[1], F32x4Splat(-a->yw), t);
+  t = F32x4MulAdd(c[2], F32x4Splat(-a->zw), t);
+  F32x4Transpose(&c[0], &c[1], &c[2], &t);
+  F32x4Store(&out->xx, c[0]);
+  F32x4Store(&out->yx, c[1]);
+  F32x4Store(&out->zx, c[2]);
+  return true;
+}
+
+XMATH_API Vec3 Affine34TransformPoint(Affine34 a, Vec3 p) {
+  return (Vec3){
+      a.xx * p.x + a.xy * p.y + a.xz * p.z + a.xw,
+      a.yx * p.x + a.yy * p.y + a.yz * p.z + a.yw,
+      a.zx * p.x + a.zy * p.y + a.zz * p.z + a.zw,
+  };
+}
+
+XMATH_API Vec3 Affine34TransformVec3(Affine34 a, Vec3 v) {
+  return (Vec3){
+      a.xx * v.x + a.xy * v.y + a.xz * v.z,
+      a.yx * v.x + a.yy * v.y + a.yz * v.z,
+      a.zx * v.x + a.zy * v.y + a.zz * v.z,
+  };
+}
+
+XMATH_API void Affine34TransformPointArray(Vec3* out,
+                                           const Affine34* a,
+                                           const Vec3* in,
+                                           size_t count) {
+  assert(a != NULL);
+  assert(count == 0 || (in != NULL && out != NULL));
+
+  // The elements are already the rows the affine kernel takes.
+  const float* rows = (const float*)a;
+  DispatchAffineVec3(rows, out, sizeof(Vec3), in, sizeof(Vec3), count);
+}
+
+XMATH_API void Affine34TransformVec3Array(Vec3* out,
+                                          const Affine34* a,
+                                          const Vec3* in,
+                                          size_t count) {
+  assert(a != NULL);
+  assert(count == 0 || (in != NULL && out != NULL));
+
+  Affine34 linear = *a;
+  linear.xw = 0.0f;
+  linear.yw = 0.0f;
+  linear.zw = 0.0f;
+  const float* rows = (const float*)&linear;
+  DispatchAffineVec3(rows, out, sizeof(Vec3), in, sizeof(Vec3), count);
+}
+
+XMATH_API Affine34 Affine34Make(Mat3 m, Vec3 t) {
+  // clang-format off
+  return (Affine34){
+    m.xx, m.yx, m.zx, t.x,
+    m.xy, m.yy, m.zy, t.y,
+    m.xz, m.yz, m.zz, t.z,
+  };
+  // clang-format on
+}
+
+XMATH_API Mat3 Affine34ToMat3(Affine34 a) {
+  // clang-format off
+  return (Mat3){
+    a.xx, a.yx, a.zx,
+    a.xy, a.yy, a.zy,
+    a.xz, a.yz, a.zz,
+  };
+  // clang-format on
+}
+
+XMATH_API Affine34 TransformToAffine34(Transform t) {
+  Affine34 r;
+  BatchAffineRows((float*)&r, &t.rotation.x, t.scale, t.position);
+  return r;
+}
+
+XMATH_API void TransformToAffine34Array(Affine34* out,
+                                        const Transform* in,
+                                        size_t count) {
+  assert(count == 0 || (in != NULL && out != NULL));
+  for (size_t i = 0; i < count; i++) {
+    const Transform* t = &in[i];
+    BatchAffineRows((float*)&out[i], &t->rotation.x, t->scale, t->position);
+  }
+}
+
+XMATH_API Affine34 Mat4ToAffine34(Mat4 m) {
+  // clang-format off
+  return (Affine34){
+    m.xx, m.yx, m.zx, m.wx,
+    m.xy, m.yy, m.zy, m.wy,
+    m.xz, m.yz, m.zz, m.wz,
+  };
+  // clang-format on
+}
+
+XMATH_API Mat4 Affine34ToMat4(Affine34 a) {
+  // clang-format off
+  return (Mat4){
+    a.xx, a.yx, a.zx, 0.0f,
+    a.xy, a.yy, a.zy, 0.0f,
+    a.xz, a.yz, a.zz, 0.0f,
+    a.xw, a.yw, a.zw, 1.0f,
+  };
+  // clang-format on
+}
@@ -0,0 +1,170 @@
+/**
+ * @file affine34.h
+ * @brief Compact affine transforms stored as 3x4 matrices.
+ *
+ * An Affine34 keeps the twelve meaningful floats of an affine Mat4, 48 bytes
+ * instead of 64, in the row major [R | t] layout that shaders take for
+ * instance matrices. Row i computes the i-th component of a point, so
+ * `p'.x = xx * p.x + xy * p.y + xz * p.z + xw`. This is the transpose of the
+ * upper 4x3 part of the matrix made by TransformToMat4 or QuatToMat4, which
+ * keeps the images of the axes in its rows.
+ *
+ * As in mat4.h, the `...To` variants write into an `XMATH_RESTRICT` output
+ * that must not be (or overlap) any input.
+ */
+#ifndef XMATH_AFFINE34_H
+#define XMATH_AFFINE34_H
+#include <stdbool.h>
+#include <stddef.h>
+#include "api.h"
+#include "mat3.h"
+#include "mat4.h"
+#include "transform.h"
+#include "vec3.h"
+// clang-format off
+
+/**
+ * @brief Affine transform of 3x4 elements.
+ */
+typedef struct {
+  float xx, xy, xz, xw;
+  float yx, yy, yz, yw;
+  float zx, zy, zz, zw;
+} Affine34;
+
+//! @brief an identity form of Affine34.
+static const Affine34 Affine34Identity = {
+  1.0f, 0.0f, 0.0f, 0.0f,
+  0.0f, 1.0f, 0.0f, 0.0f,
+  0.0f, 0.0f, 1.0f, 0.0f,
+};
+// clang-format on
+
+/**
+ * @brief Compare the elements of two transforms.
+ * @param a first transform.
+ * @param b second transform.
+ * @return true if a elements are near b elements.
+ */
+XMATH_API bool Affine34EqualApprox(Affine34 a, Affine34 b);
+
+/**
+ * @brief Multiply two transforms.
+ *
+ * Same order as Mat4Mul on the matrices given by Affine34ToMat4: points
+ * transformed by the result go through a first, then b.
+ * @param a first transform.
+ * @param b second transform.
+ * @return the combined transform.
+ */
+XMATH_API Affine34 Affine34Mul(Affine34 a, Affine34 b);
+
+/**
+ * @brief Multiply two transforms into out.
+ * @param out the combined transform, must not be a or b.
+ * @param a first transform.
+ * @param b second transform.
+ */
+XMATH_API void Affine34MulTo(Affine34* XMATH_RESTRICT out,
+                             const Affine34* a,
+                             const Affine34* b);
+
+/**
+ * @brief Invert a transform.
+ * @param out inverse of a, must not be a.
+ * @param a transform to invert.
+ * @return false if the linear part is singular, out is untouched then.
+ */
+XMATH_API bool Affine34Invert(Affine34* XMATH_RESTRICT out, const Affine34* a);
+
+/**
+ * @brief Transform a point, translation included.
+ * @param a transform to apply.
+ * @param p point to transform.
+ * @return the transformed point.
+ */
+XMATH_API Vec3 Affine34TransformPoint(Affine34 a, Vec3 p);
+
+/**
+ * @brief Transform a direction, translation ignored.
+ * @param a transform to apply.
+ * @param v direction to transform.
+ * @return the transformed direction.
+ */
+XMATH_API Vec3 Affine34TransformVec3(Affine34 a, Vec3 v);
+
+/**
+ * @brief Transform an array of points, translation included.
+ * @param out destination of count points, can be the same as in.
+ * @param a transform to apply.
+ * @param in source of count points.
+ * @param count number of points.
+ */
+XMATH_API void Affine34TransformPointArray(Vec3* out,
+                                           const Affine34* a,
+                                           const Vec3* in,
+                                           size_t count);
+
+/**
+ * @brief Transform an array of directions, translation ignored.
+ * @param out destination of count directions, can be the same as in.
+ * @param a transform to apply.
+ * @param in source of count directions.
+ * @param count number of directions.
+ */
+XMATH_API void Affine34TransformVec3Array(Vec3* out,
+                                          const Affine34* a,
+                                          const Vec3* in,
+                                          size_t count);
+
+/**
+ * @brief Build a transform from a linear part and a translation.
+ * @param m rotation and scale, in the layout of mat3.h.
+ * @param t translation.
+ * @return the transform applying m then t.
+ */
+XMATH_API Affine34 Affine34Make(Mat3 m, Vec3 t);
+
+/**
+ * @brief Take the linear part of a transform.
+ * @param a transform (unaffected).
+ * @return the rotation and scale of a in the layout of mat3.h.
+ */
+XMATH_API Mat3 Affine34ToMat3(Affine34 a);
+
+/**
+ * @brief Convert a Transform.
+ * @param t transform (unaffected).
+ * @return the same transform as TransformToMat4(t).
+ */
+XMATH_API Affine34 TransformToAffine34(Transform t);
+
+/**
+ * @brief Convert an array of Transform, e.g. to fill an instance buffer.
+ * @param out destination of count transforms.
+ * @param in source of count transforms.
+ * @param count number of transforms.
+ */
+XMATH_API void TransformToAffine34Array(Affine34* out,
+                                        const Transform* in,
+                                        size_t count);
+
+/**
+ * @brief Convert an affine Mat4, its last column is ignored.
+ * @param m matrix (unaffected).
+ * @return the affine part of m.
+ */
+XMATH_API Affine34 Mat4ToAffine34(Mat4 m);
+
+/**
+ * @brief Expand into a Mat4.
+ * @param a transform (unaffected).
+ * @return the matrix with a last column of (0, 0, 0, 1).
+ */
+XMATH_API Mat4 Affine34ToMat4(Affine34 a);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "affine34.c"
+#endif
+
+#endif /* XMATH_AFFINE34_H */
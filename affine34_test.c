@@ -0,0 +1,139 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "affine34.h"
+#include "common_testing.h"
+#include "scalar.h"
+
+static Transform SampleTransform(float angle, Vec3 position, Vec3 scale) {
+  return (Transform){
+      .position = position,
+      .rotation = QuatMakeAngleAxis(FDeg2Rad(angle),
+                                    Vec3Norm((Vec3){1.0f, 2.0f, 3.0f})),
+      .scale = scale,
+  };
+}
+
+void test_TransformToAffine34(void** state) {
+  UNUSED(state);
+
+  Transform t = SampleTransform(40.0f, (Vec3){1.0f, -2.0f, 0.5f},
+                                (Vec3){0.5f, 1.5f, 1.0f});
+  Affine34 a = TransformToAffine34(t);
+  assert_true(Mat4EqualApprox(Affine34ToMat4(a), TransformToMat4(t)));
+  assert_true(Affine34EqualApprox(Mat4ToAffine34(TransformToMat4(t)), a));
+
+  Vec3 p = {0.3f, -0.4f, 0.9f};
+  assert_true(Vec3EqualApprox(Affine34TransformPoint(a, p),
+                              TransformPoint(t, p)));
+  assert_true(Vec3EqualApprox(Affine34TransformVec3(a, p),
+                              TransformVec3(t, p)));
+
+  // The linear part round trips through Mat3.
+  Mat3 m = Affine34ToMat3(a);
+  assert_true(Mat3EqualApprox(m, Mat4ToMat3(TransformToMat4(t))));
+  assert_true(Affine34EqualApprox(Affine34Make(m, t.position), a));
+
+  Transform ts[5];
+  Affine34 as[5];
+  for (unsigned i = 0; i < 5; i++) {
+    ts[i] = SampleTransform(20.0f * (float)i, (Vec3){(float)i, 0.5f, -1.0f},
+                            (Vec3){1.0f, 0.5f + 0.1f * (float)i, 2.0f});
+  }
+  TransformToAffine34Array(as, ts, 5);
+  for (unsigned i = 0; i < 5; i++) {
+    assert_true(Affine34EqualApprox(as[i], TransformToAffine34(ts[i])));
+  }
+}
+
+void test_Affine34Mul(void** state) {
+  UNUSED(state);
+
+  Affine34 a = TransformToAffine34(SampleTransform(
+      30.0f, (Vec3){0.5f, 0.25f, -0.5f}, (Vec3){1.0f, 0.5f, 1.0f}));
+  Affine34 b = TransformToAffine34(SampleTransform(
+      -60.0f, (Vec3){-0.25f, 1.0f, 0.0f}, (Vec3){0.8f, 0.8f, 1.2f}));
+
+  // Same as Mat4Mul on the expanded matrices.
+  Mat4 e = Mat4Mul(Affine34ToMat4(a), Affine34ToMat4(b));
+  Affine34 r = Affine34Mul(a, b);
+  assert_true(Mat4EqualApprox(Affine34ToMat4(r), e));
+
+  r = Affine34Identity;
+  Affine34MulTo(&r, &a, &b);
+  assert_true(Mat4EqualApprox(Affine34ToMat4(r), e));
+
+  // Points go through a first, then b.
+  Vec3 p = {0.2f, 0.4f, -0.6f};
+  Vec3 ep = Affine34TransformPoint(b, Affine34TransformPoint(a, p));
+  assert_true(Vec3EqualApprox(Affine34TransformPoint(r, p), ep));
+}
+
+void test_Affine34Invert(void** state) {
+  UNUSED(state);
+
+  Affine34 a = TransformToAffine34(SampleTransform(
+      75.0f, (Vec3){1.0f, -0.5f, 0.25f}, (Vec3){0.5f, 1.0f, 2.0f}));
+  Affine34 r;
+  assert_true(Affine34Invert(&r, &a));
+  assert_true(Affine34EqualApprox(Affine34Mul(a, r), Affine34Identity));
+
+  Mat4 e;
+  assert_true(Mat4Invert(&e, Affine34ToMat4(a)));
+  assert_true(Mat4EqualApprox(Affine34ToMat4(r), e));
+
+  // A singular transform leaves the output untouched.
+  Affine34 s = a;
+  s.xx = 0.0f;
+  s.yx = 0.0f;
+  s.zx = 0.0f;
+  r = Affine34Identity;
+  assert_false(Affine34Invert(&r, &s));
+  assert_true(Affine34EqualApprox(r, Affine34Identity));
+}
+
+void test_Affine34TransformArray(void** state) {
+  UNUSED(state);
+
+  Affine34 a = TransformToAffine34(SampleTransform(
+      15.0f, (Vec3){0.5f, 0.5f, -0.25f}, (Vec3){1.0f, 0.75f, 0.5f}));
+
+  // Not a multiple of four, so the tail of the kernel is exercised.
+  Vec3 in[9];
+  Vec3 points[9];
+  Vec3 dirs[9];
+  for (unsigned i = 0; i < 9; i++) {
+    in[i] = (Vec3){0.1f * (float)i, -0.5f, 1.0f - 0.1f * (float)i};
+  }
+
+  Affine34TransformPointArray(points, &a, in, 9);
+  Affine34TransformVec3Array(dirs, &a, in, 9);
+  for (unsigned i = 0; i < 9; i++) {
+    assert_true(Vec3EqualApprox(points[i], Affine34TransformPoint(a, in[i])));
+    assert_true(Vec3EqualApprox(dirs[i], Affine34TransformVec3(a, in[i])));
+  }
+
+  // In place.
+  Affine34TransformPointArray(in, &a, in, 9);
+  for (unsigned i = 0; i < 9; i++) {
+    assert_true(Vec3EqualApprox(in[i], points[i]));
+  }
+}
+
+int main() {
+  UNUSED_TYPE(jmp_buf);
+  UNUSED_TYPE(va_list);
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_TransformToAffine34),
+      cmocka_unit_test(test_Affine34Mul),
+      cmocka_unit_test(test_Affine34Invert),
+      cmocka_unit_test(test_Affine34TransformArray),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,120 @@
+#include "animation.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "batch.h"
+#include "dispatch_table.h"
+#include "scalar.h"
+
+// Joints located before every call to the interpolation kernel.
+#define XMATH_CLIP_BLOCK 64
+
+// Keys stepped forward from the cursor before falling back to a search.
+#define XMATH_CLIP_SCAN 4
+
+XMATH_API float ClipDuration(const Clip* clip) {
+  assert(clip != NULL);
+  float duration = 0.0f;
+  for (size_t j = 0; j < clip->jointCount; j++) {
+    const ClipTrack* track = &clip->tracks[j];
+    float last = track->times[track->count - 1];
+    duration = last > duration ? last : duration;
+  }
+  return duration;
+}
+
+XMATH_API bool ClipCursorMake(ClipCursor* cursor, size_t jointCount) {
+  assert(cursor != NULL);
+  uint32_t* keys = calloc(jointCount > 0 ? jointCount : 1, sizeof(uint32_t));
+  if (keys == NULL) {
+    *cursor = (ClipCursor){0};
+    return false;
+  }
+
+  cursor->keys = keys;
+  cursor->jointCount = jointCount;
+  return true;
+}
+
+XMATH_API void ClipCursorFree(ClipCursor* cursor) {
+  assert(cursor != NULL);
+  free(cursor->keys);
+  *cursor = (ClipCursor){0};
+}
+
+XMATH_API void ClipCursorReset(ClipCursor* cursor) {
+  assert(cursor != NULL);
+  memset(cursor->keys, 0, cursor->jointCount * sizeof(uint32_t));
+}
+
+// Last key in [lo, count) at or before time, or lo when there is none.
+static inline uint32_t ClipTrackSearch(const ClipTrack* track,
+                                       uint32_t lo,
+                                       float time) {
+  uint32_t hi = track->count;
+  while (hi - lo > 1) {
+    uint32_t mid = lo + (hi - lo) / 2;
+    if (track->times[mid] <= time) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// Last key at or before time, starting from the one of the cursor.
+static inline uint32_t ClipTrackSeek(const ClipTrack* track,
+                                     uint32_t key,
+                                     float time) {
+  const float* times = track->times;
+  uint32_t last = track->count - 1;
+  if (key > last || times[key] > time) {
+    return ClipTrackSearch(track, 0, time);
+  }
+
+  for (unsigned step = 0; step < XMATH_CLIP_SCAN; step++) {
+    if (key == last || times[key + 1] > time) {
+      return key;
+    }
+    key++;
+  }
+  return ClipTrackSearch(track, key, time);
+}
+
+XMATH_API void ClipSample(const Clip* clip,
+                          ClipCursor* cursor,
+                          float time,
+                          Transform* outPose) {
+  assert(clip != NULL && cursor != NULL && outPose != NULL);
+  assert(cursor->jointCount == clip->jointCount);
+
+  const float* a[XMATH_CLIP_BLOCK];
+  const float* b[XMATH_CLIP_BLOCK];
+  float t[XMATH_CLIP_BLOCK];
+  for (size_t first = 0; first < clip->jointCount; first += XMATH_CLIP_BLOCK) {
+    size_t count = clip->jointCount - first;
+    count = count < XMATH_CLIP_BLOCK ? count : XMATH_CLIP_BLOCK;
+    for (size_t i = 0; i < count; i++) {
+      const ClipTrack* track = &clip->tracks[first + i];
+      assert(track->count > 0);
+      uint32_t key = ClipTrackSeek(track, cursor->keys[first + i], time);
+      cursor->keys[first + i] = key;
+
+      // Past the last key both ends are the last key, before the first one
+      // the factor is clamped to zero.
+      uint32_t next = key + 1 < track->count ? key + 1 : key;
+      float f = 0.0f;
+      if (next != key) {
+        float t0 = track->times[key];
+        f = (time - t0) / (track->times[next] - t0);
+        f = FMin(FMax(f, 0.0f), 1.0f);
+      }
+      // Transform is 10 packed floats, the layout the kernel reads.
+      a[i] = (const float*)&track->keys[key];
+      b[i] = (const float*)&track->keys[next];
+      t[i] = f;
+    }
+    DispatchTransformLerpGather((float*)(outPose + first), a, b, t, count);
+  }
+}
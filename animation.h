@@ -0,0 +1,103 @@
+/**
+ * @file animation.h
+ * @brief Keyframed animation clips of transforms.
+ *
+ * A Clip holds one ClipTrack per joint, every track a list of Transform keys
+ * sorted by time. ClipSample interpolates every joint like TransformLerp
+ * between the keys around the sample time: positions and scales linearly,
+ * rotations with QuatNLerp along the short way.
+ *
+ * Finding the keys is done through a ClipCursor, one per playing instance,
+ * that remembers the last key of every joint. Playback moving forward only
+ * steps a few keys from there; seeking far or backwards falls back to a
+ * binary search. The interpolation itself runs four joints at a time.
+ */
+#ifndef XMATH_ANIMATION_H
+#define XMATH_ANIMATION_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+#include "transform.h"
+
+/**
+ * @brief Keys of one joint.
+ *
+ * times holds count strictly increasing times and keys the transform of the
+ * joint at each of them, count is at least one. Before the first key and
+ * after the last one the track holds its end key.
+ */
+typedef struct {
+  const float* times;
+  const Transform* keys;
+  uint32_t count;
+} ClipTrack;
+
+/**
+ * @brief Animation of a skeleton, one track per joint.
+ *
+ * The clip only points to the tracks, which are not copied, and can be
+ * sampled from many threads at once with a cursor each.
+ */
+typedef struct {
+  const ClipTrack* tracks;
+  size_t jointCount;
+} Clip;
+
+/**
+ * @brief Playback position of a clip.
+ *
+ * keys[j] is the key of joint j at or before the last sampled time.
+ */
+typedef struct {
+  uint32_t* keys;
+  size_t jointCount;
+} ClipCursor;
+
+/**
+ * @brief Get the time of the last key of a clip.
+ * @param clip clip to measure.
+ * @return the largest time of every track, zero without joints.
+ */
+XMATH_API float ClipDuration(const Clip* clip);
+
+/**
+ * @brief Allocate a cursor at the start of the clips of jointCount joints.
+ * @param cursor cursor to initialize.
+ * @param jointCount number of joints of the clips it will sample.
+ * @return false if the memory could not be allocated.
+ */
+XMATH_API bool ClipCursorMake(ClipCursor* cursor, size_t jointCount);
+
+/**
+ * @brief Release the memory of a cursor made by ClipCursorMake.
+ * @param cursor cursor to release, left empty.
+ */
+XMATH_API void ClipCursorFree(ClipCursor* cursor);
+
+/**
+ * @brief Move a cursor back to the first key of every joint.
+ *
+ * Needed when the cursor moves to another clip, sampling keeps working
+ * without it but starts with a binary search on every joint.
+ * @param cursor cursor to reset.
+ */
+XMATH_API void ClipCursorReset(ClipCursor* cursor);
+
+/**
+ * @brief Sample every joint of a clip.
+ * @param clip clip to sample.
+ * @param cursor cursor of the same joint count, updated to time.
+ * @param time sample time, clamped to the keys of every track.
+ * @param outPose destination of clip->jointCount transforms.
+ */
+XMATH_API void ClipSample(const Clip* clip,
+                          ClipCursor* cursor,
+                          float time,
+                          Transform* outPose);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "animation.c"
+#endif
+
+#endif /* XMATH_ANIMATION_H */
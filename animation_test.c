@@ -0,0 +1,171 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "animation.h"
+#include "common_testing.h"
+#include "scalar.h"
+
+// More joints than one block of ClipSample, and not a multiple of four.
+#define JOINTS 70
+#define MAX_KEYS 9
+
+static float gTimes[JOINTS][MAX_KEYS];
+static Transform gKeys[JOINTS][MAX_KEYS];
+static ClipTrack gTracks[JOINTS];
+
+// Joint j has 1 + j % MAX_KEYS keys, starting and spaced differently.
+static Clip MakeClip(void) {
+  for (unsigned j = 0; j < JOINTS; j++) {
+    uint32_t count = 1 + j % MAX_KEYS;
+    float step = 0.1f + 0.05f * (float)(j % 4);
+    for (uint32_t k = 0; k < count; k++) {
+      float f = (float)(j + k);
+      gTimes[j][k] = 0.02f * (float)(j % 3) + step * (float)k;
+      gKeys[j][k] = (Transform){
+          .position = {0.01f * f, -0.005f * f, 1.0f},
+          .rotation = QuatMakeAngleAxis(0.7f * f, Vec3Norm((Vec3){1, f, 2})),
+          .scale = {1.0f + 0.1f * (float)k, 1.0f, 0.5f},
+      };
+    }
+    gTracks[j] = (ClipTrack){gTimes[j], gKeys[j], count};
+  }
+  return (Clip){gTracks, JOINTS};
+}
+
+// Linear search and TransformLerp, what ClipSample replaces.
+static Transform Expected(const ClipTrack* track, float time, uint32_t* key) {
+  uint32_t k = 0;
+  while (k + 1 < track->count && track->times[k + 1] <= time) {
+    k++;
+  }
+  *key = k;
+  if (k + 1 == track->count) {
+    return track->keys[k];
+  }
+
+  float t0 = track->times[k];
+  float f = (time - t0) / (track->times[k + 1] - t0);
+  f = FMin(FMax(f, 0.0f), 1.0f);
+  return TransformLerp(track->keys[k], track->keys[k + 1], f);
+}
+
+static void AssertPose(const Clip* clip,
+                       const ClipCursor* cursor,
+                       float time,
+                       const Transform* pose) {
+  for (unsigned j = 0; j < JOINTS; j++) {
+    uint32_t key;
+    Transform e = Expected(&clip->tracks[j], time, &key);
+    assert_true(TransformEqualApprox(pose[j], e));
+    assert_int_equal(cursor->keys[j], key);
+  }
+}
+
+static void test_ClipDuration(void** state) {
+  UNUSED(state);
+
+  Clip clip = MakeClip();
+  float duration = 0.0f;
+  for (unsigned j = 0; j < JOINTS; j++) {
+    duration = FMax(duration, gTimes[j][gTracks[j].count - 1]);
+  }
+  assert_float_equal(ClipDuration(&clip), duration, XMATH_EPSILON);
+
+  Clip empty = {NULL, 0};
+  assert_float_equal(ClipDuration(&empty), 0.0f, XMATH_EPSILON);
+}
+
+static void test_ClipCursor(void** state) {
+  UNUSED(state);
+
+  ClipCursor cursor;
+  assert_true(ClipCursorMake(&cursor, JOINTS));
+  assert_int_equal(cursor.jointCount, JOINTS);
+  for (unsigned j = 0; j < JOINTS; j++) {
+    assert_int_equal(cursor.keys[j], 0);
+    cursor.keys[j] = j;
+  }
+
+  ClipCursorReset(&cursor);
+  for (unsigned j = 0; j < JOINTS; j++) {
+    assert_int_equal(cursor.keys[j], 0);
+  }
+
+  ClipCursorFree(&cursor);
+  assert_true(cursor.keys == NULL);
+  assert_int_equal(cursor.jointCount, 0);
+}
+
+static void test_ClipSample(void** state) {
+  UNUSED(state);
+
+  Clip clip = MakeClip();
+  ClipCursor cursor;
+  Transform pose[JOINTS];
+  assert_true(ClipCursorMake(&cursor, JOINTS));
+
+  // Forward playback, on and between keys and past the end.
+  float duration = ClipDuration(&clip);
+  for (float time = -0.1f; time < duration + 0.2f; time += 0.013f) {
+    ClipSample(&clip, &cursor, time, pose);
+    AssertPose(&clip, &cursor, time, pose);
+  }
+  ClipSample(&clip, &cursor, 0.2f, pose);
+  AssertPose(&clip, &cursor, 0.2f, pose);
+
+  // Seeking backwards and far forward.
+  float seeks[] = {duration, 0.05f, 0.9f * duration, -1.0f, 0.5f, 100.0f};
+  for (unsigned i = 0; i < sizeof(seeks) / sizeof(seeks[0]); i++) {
+    ClipSample(&clip, &cursor, seeks[i], pose);
+    AssertPose(&clip, &cursor, seeks[i], pose);
+  }
+
+  // A stale cursor from another clip still samples right.
+  for (unsigned j = 0; j < JOINTS; j++) {
+    cursor.keys[j] = 1000;
+  }
+  ClipSample(&clip, &cursor, 0.3f, pose);
+  AssertPose(&clip, &cursor, 0.3f, pose);
+
+  ClipCursorFree(&cursor);
+}
+
+static void test_ClipSampleShortWay(void** state) {
+  UNUSED(state);
+
+  // Keys in opposite hemispheres interpolate like TransformLerp.
+  float times[2] = {0.0f, 1.0f};
+  Quat q = QuatMakeAngleAxis(0.4f, Vec3Norm((Vec3){0, 1, 1}));
+  Transform keys[2] = {
+      {Vec3Zero, q, Vec3One},
+      {Vec3One, QuatNeg(QuatMakeAngleAxis(1.2f, Vec3Up)), Vec3One},
+  };
+  ClipTrack track = {times, keys, 2};
+  Clip clip = {&track, 1};
+  ClipCursor cursor;
+  Transform pose;
+  assert_true(ClipCursorMake(&cursor, 1));
+  ClipSample(&clip, &cursor, 0.3f, &pose);
+  Transform expected = TransformLerp(keys[0], keys[1], 0.3f);
+  assert_true(TransformEqualApprox(pose, expected));
+  ClipCursorFree(&cursor);
+}
+
+int main() {
+  UNUSED_TYPE(jmp_buf);
+  UNUSED_TYPE(va_list);
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_ClipDuration),
+      cmocka_unit_test(test_ClipCursor),
+      cmocka_unit_test(test_ClipSample),
+      cmocka_unit_test(test_ClipSampleShortWay),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
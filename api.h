@@ -0,0 +1,37 @@
+/**
+ * @file api.h
+ * @brief Linkage of the library functions.
+ *
+ * By default every function is an external symbol of the compiled library.
+ * Defining `XMATH_HEADER_ONLY` (or its alias `XMATH_INLINE`) before including
+ * any xmath header turns every function into a `static inline` definition
+ * instead, so the compiler can inline and fuse them in the calling code. The
+ * implementation files must then be reachable in the include path, next to
+ * the headers.
+ *
+ * `XMATH_RESTRICT` qualifies the output pointers of the `...To` functions:
+ * the memory written through them must not be reachable through any other
+ * argument.
+ */
+#ifndef XMATH_API_H
+#define XMATH_API_H
+
+#if defined(XMATH_INLINE) && !defined(XMATH_HEADER_ONLY)
+#define XMATH_HEADER_ONLY
+#endif
+
+#if defined(XMATH_HEADER_ONLY)
+#define XMATH_API static inline
+#else
+#define XMATH_API
+#endif
+
+#if defined(_MSC_VER)
+#define XMATH_RESTRICT __restrict
+#elif defined(__cplusplus)
+#define XMATH_RESTRICT __restrict__
+#else
+#define XMATH_RESTRICT restrict
+#endif
+
+#endif /* XMATH_API_H */
@@ -0,0 +1,1081 @@
+/**
+ * @file batch.h
+ * @brief Batch kernels shared by the modules.
+ *
+ * The affine kernels walk arrays of Vec3 given as a base pointer plus a
+ * stride in bytes, so they work on fields of interleaved vertex structs. Four
+ * elements are gathered at a time and transposed into x, y and z lanes.
+ *
+ * The bodies are compiled once per CPU tier by dispatch_kernels.h, so they
+ * only take pointers and plain floats: the SIMD types change with the tier.
+ *
+ * All the functions are `static inline` and meant to be used by the library
+ * implementation, they are not part of the stable public API.
+ */
+#ifndef XMATH_BATCH_H
+#define XMATH_BATCH_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "mat4_type.h"
+#include "scalar.h"
+#include "simd.h"
+#include "vec3.h"
+#include "vec4.h"
+
+/**
+ * @brief Affine map of Vec3, every coefficient broadcast into a register.
+ *
+ * Row major 3x4: lanes m[0..3] compute x as m0 * x + m1 * y + m2 * z + m3,
+ * then m[4..7] compute y and m[8..11] compute z.
+ */
+typedef struct {
+  F32x4 m[12];
+} BatchAffine;
+
+/**
+ * @brief Coefficients of the map scaling by s, rotating by q and translating
+ * by t.
+ *
+ * The rotation uses the same expansion as QuatTransformVec3, so q does not
+ * need to be normalized to match it.
+ * @param rows destination of the 12 row major coefficients.
+ * @param q quaternion as x, y, z and w.
+ * @param s scale.
+ * @param t translation.
+ */
+static inline void BatchAffineRows(float rows[12],
+                                   const float* q,
+                                   Vec3 s,
+                                   Vec3 t) {
+  float x = q[0];
+  float y = q[1];
+  float z = q[2];
+  float w = q[3];
+  float k = w * w - (x * x + y * y + z * z);
+  rows[0] = (2.0f * x * x + k) * s.x;
+  rows[1] = (2.0f * x * y - 2.0f * w * z) * s.y;
+  rows[2] = (2.0f * x * z + 2.0f * w * y) * s.z;
+  rows[3] = t.x;
+  rows[4] = (2.0f * y * x + 2.0f * w * z) * s.x;
+  rows[5] = (2.0f * y * y + k) * s.y;
+  rows[6] = (2.0f * y * z - 2.0f * w * x) * s.z;
+  rows[7] = t.y;
+  rows[8] = (2.0f * z * x - 2.0f * w * y) * s.x;
+  rows[9] = (2.0f * z * y + 2.0f * w * x) * s.y;
+  rows[10] = (2.0f * z * z + k) * s.z;
+  rows[11] = t.z;
+}
+
+//! @brief Broadcast the coefficients made by BatchAffineRows.
+static inline BatchAffine BatchAffineLoad(const float rows[12]) {
+  BatchAffine r;
+  for (unsigned i = 0; i < 12; i++) {
+    r.m[i] = F32x4Splat(rows[i]);
+  }
+  return r;
+}
+
+// Cross product of the xyz lanes, the w lane is left at zero.
+static inline F32x4 BatchCrossLanes(F32x4 a, F32x4 b) {
+  F32x4 l = F32x4Mul(F32x4Swizzle(a, 1, 2, 0, 3), F32x4Swizzle(b, 2, 0, 1, 3));
+  F32x4 r = F32x4Mul(F32x4Swizzle(a, 2, 0, 1, 3), F32x4Swizzle(b, 1, 2, 0, 3));
+  return F32x4Sub(l, r);
+}
+
+/**
+ * @brief Invert a 3x3 matrix given as three rows.
+ *
+ * The columns of the inverse are the cross products of the rows over the
+ * determinant.
+ * @param c destination of the three columns of the inverse, w lanes zero.
+ * @param r0 first row, its w lane must be zero.
+ * @param r1 second row, its w lane must be zero.
+ * @param r2 third row, its w lane must be zero.
+ * @return false if the determinant is zero, c is then not written.
+ */
+static inline bool BatchInvert3Columns(F32x4 c[3],
+                                       F32x4 r0,
+                                       F32x4 r1,
+                                       F32x4 r2) {
+  F32x4 c0 = BatchCrossLanes(r1, r2);
+  float det = F32x4Dot(r0, c0);
+  if (det == 0) {
+    return false;
+  }
+
+  F32x4 k = F32x4Splat(1.0f / det);
+  c[0] = F32x4Mul(c0, k);
+  c[1] = F32x4Mul(BatchCrossLanes(r2, r0), k);
+  c[2] = F32x4Mul(BatchCrossLanes(r0, r1), k);
+  return true;
+}
+
+//! @brief Address of the i-th element of a strided array.
+static inline Vec3* BatchVec3At(const void* base, size_t stride, size_t i) {
+  return (Vec3*)((const char*)base + i * stride);
+}
+
+// Transform four elements into x, y and z lanes.
+static inline void BatchAffineVec3Lanes(const BatchAffine* a,
+                                        F32x4* rx,
+                                        F32x4* ry,
+                                        F32x4* rz,
+                                        const void* in,
+                                        size_t inStride) {
+  F32x4 x = F32x4Load3(&BatchVec3At(in, inStride, 0)->x);
+  F32x4 y = F32x4Load3(&BatchVec3At(in, inStride, 1)->x);
+  F32x4 z = F32x4Load3(&BatchVec3At(in, inStride, 2)->x);
+  F32x4 w = F32x4Load3(&BatchVec3At(in, inStride, 3)->x);
+  F32x4Transpose(&x, &y, &z, &w);
+
+  const F32x4* m = a->m;
+  F32x4 ox = F32x4MulAdd(m[0], x, m[3]);
+  F32x4 oy = F32x4MulAdd(m[4], x, m[7]);
+  F32x4 oz = F32x4MulAdd(m[8], x, m[11]);
+  ox = F32x4MulAdd(m[1], y, ox);
+  oy = F32x4MulAdd(m[5], y, oy);
+  oz = F32x4MulAdd(m[9], y, oz);
+  *rx = F32x4MulAdd(m[2], z, ox);
+  *ry = F32x4MulAdd(m[6], z, oy);
+  *rz = F32x4MulAdd(m[10], z, oz);
+}
+
+// Transform exactly four elements, all of them are read before any write.
+static inline void BatchAffineVec3Block(const BatchAffine* a,
+                                        void* out,
+                                        size_t outStride,
+                                        const void* in,
+                                        size_t inStride) {
+  F32x4 rx;
+  F32x4 ry;
+  F32x4 rz;
+  BatchAffineVec3Lanes(a, &rx, &ry, &rz, in, inStride);
+
+  F32x4 rw = F32x4Splat(0.0f);
+  F32x4Transpose(&rx, &ry, &rz, &rw);
+  F32x4Store3(&BatchVec3At(out, outStride, 0)->x, rx);
+  F32x4Store3(&BatchVec3At(out, outStride, 1)->x, ry);
+  F32x4Store3(&BatchVec3At(out, outStride, 2)->x, rz);
+  F32x4Store3(&BatchVec3At(out, outStride, 3)->x, rw);
+}
+
+/**
+ * @brief Apply the map made by BatchAffineRows to count strided Vec3.
+ *
+ * out can be the same as in when both use the same stride.
+ */
+static inline void BatchAffineVec3(const float rows[12],
+                                   void* out,
+                                   size_t outStride,
+                                   const void* in,
+                                   size_t inStride,
+                                   size_t count) {
+  BatchAffine m = BatchAffineLoad(rows);
+  const BatchAffine* a = &m;
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    BatchAffineVec3Block(a, BatchVec3At(out, outStride, i), outStride,
+                         BatchVec3At(in, inStride, i), inStride);
+  }
+
+  // Run the remainder through a zero padded block.
+  size_t rest = count - i;
+  if (rest > 0) {
+    Vec3 tail[4] = {0};
+    for (size_t j = 0; j < rest; j++) {
+      tail[j] = *BatchVec3At(in, inStride, i + j);
+    }
+    BatchAffineVec3Block(a, tail, sizeof(Vec3), tail, sizeof(Vec3));
+    for (size_t j = 0; j < rest; j++) {
+      *BatchVec3At(out, outStride, i + j) = tail[j];
+    }
+  }
+}
+
+/**
+ * @brief Apply the map made by BatchAffineRows to count strided Vec3, writing
+ * the results into separate x, y and z streams.
+ *
+ * The streams are written in whole blocks of four, up to count rounded up to
+ * a multiple of four; the extra lanes hold the map of a zero vector.
+ */
+static inline void BatchAffineVec3SoA(const float rows[12],
+                                      float* x,
+                                      float* y,
+                                      float* z,
+                                      const void* in,
+                                      size_t inStride,
+                                      size_t count) {
+  BatchAffine m = BatchAffineLoad(rows);
+  F32x4 rx;
+  F32x4 ry;
+  F32x4 rz;
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    BatchAffineVec3Lanes(&m, &rx, &ry, &rz, BatchVec3At(in, inStride, i),
+                         inStride);
+    F32x4Store(x + i, rx);
+    F32x4Store(y + i, ry);
+    F32x4Store(z + i, rz);
+  }
+
+  size_t rest = count - i;
+  if (rest > 0) {
+    Vec3 tail[4] = {0};
+    for (size_t j = 0; j < rest; j++) {
+      tail[j] = *BatchVec3At(in, inStride, i + j);
+    }
+    BatchAffineVec3Lanes(&m, &rx, &ry, &rz, tail, sizeof(Vec3));
+    F32x4Store(x + i, rx);
+    F32x4Store(y + i, ry);
+    F32x4Store(z + i, rz);
+  }
+}
+
+// Rotate four vectors in x, y and z lanes by four unit quaternions,
+// t = 2 (q x v), r = v + w t + q x t.
+static inline void BatchQuatRotateLanes(const F32x4 q[4],
+                                        F32x4* x,
+                                        F32x4* y,
+                                        F32x4* z) {
+  F32x4 two = F32x4Splat(2.0f);
+  F32x4 tx = F32x4Mul(two, F32x4Sub(F32x4Mul(q[1], *z), F32x4Mul(q[2], *y)));
+  F32x4 ty = F32x4Mul(two, F32x4Sub(F32x4Mul(q[2], *x), F32x4Mul(q[0], *z)));
+  F32x4 tz = F32x4Mul(two, F32x4Sub(F32x4Mul(q[0], *y), F32x4Mul(q[1], *x)));
+  F32x4 rx = F32x4MulAdd(q[3], tx, *x);
+  F32x4 ry = F32x4MulAdd(q[3], ty, *y);
+  F32x4 rz = F32x4MulAdd(q[3], tz, *z);
+  *x = F32x4Add(rx, F32x4Sub(F32x4Mul(q[1], tz), F32x4Mul(q[2], ty)));
+  *y = F32x4Add(ry, F32x4Sub(F32x4Mul(q[2], tx), F32x4Mul(q[0], tz)));
+  *z = F32x4Add(rz, F32x4Sub(F32x4Mul(q[0], ty), F32x4Mul(q[1], tx)));
+}
+
+// Rotate exactly four vectors by their own quaternions, all of them are read
+// before any write.
+static inline void BatchQuatVec3Block(Vec3* out,
+                                      const float* qs,
+                                      const Vec3* vs) {
+  F32x4 q[4] = {F32x4Load(qs), F32x4Load(qs + 4), F32x4Load(qs + 8),
+                F32x4Load(qs + 12)};
+  F32x4Transpose(&q[0], &q[1], &q[2], &q[3]);
+  F32x4 vx = F32x4Load3(&vs[0].x);
+  F32x4 vy = F32x4Load3(&vs[1].x);
+  F32x4 vz = F32x4Load3(&vs[2].x);
+  F32x4 vw = F32x4Load3(&vs[3].x);
+  F32x4Transpose(&vx, &vy, &vz, &vw);
+  BatchQuatRotateLanes(q, &vx, &vy, &vz);
+
+  vw = F32x4Splat(0.0f);
+  F32x4Transpose(&vx, &vy, &vz, &vw);
+  F32x4Store3(&out[0].x, vx);
+  F32x4Store3(&out[1].x, vy);
+  F32x4Store3(&out[2].x, vz);
+  F32x4Store3(&out[3].x, vw);
+}
+
+/**
+ * @brief Rotate vs[i] by the i-th unit quaternion of qs.
+ *
+ * qs holds count quaternions as x, y, z and w. out can be the same as vs.
+ */
+static inline void BatchQuatVec3Pairwise(Vec3* out,
+                                         const float* qs,
+                                         const Vec3* vs,
+                                         size_t count) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    BatchQuatVec3Block(out + i, qs + 4 * i, vs + i);
+  }
+
+  // Run the remainder through a zero padded block.
+  size_t rest = count - i;
+  if (rest > 0) {
+    float qtail[16] = {0};
+    Vec3 vtail[4] = {0};
+    for (size_t j = 0; j < rest; j++) {
+      for (size_t k = 0; k < 4; k++) {
+        qtail[4 * j + k] = qs[4 * (i + j) + k];
+      }
+      vtail[j] = vs[i + j];
+    }
+    BatchQuatVec3Block(vtail, qtail, vtail);
+    for (size_t j = 0; j < rest; j++) {
+      out[i + j] = vtail[j];
+    }
+  }
+}
+
+// Map vertex i by the columns of a blended bone, c3 is the translation.
+static inline void BatchSkinLinearVertex(F32x4 c0,
+                                         F32x4 c1,
+                                         F32x4 c2,
+                                         F32x4 c3,
+                                         size_t i,
+                                         const Vec3* positions,
+                                         const Vec3* normals,
+                                         Vec3* outPositions,
+                                         Vec3* outNormals) {
+  F32x4 p = F32x4Load3(&positions[i].x);
+  F32x4 rp = F32x4MulAdd(c0, F32x4Swizzle(p, 0, 0, 0, 0), c3);
+  rp = F32x4MulAdd(c1, F32x4Swizzle(p, 1, 1, 1, 1), rp);
+  rp = F32x4MulAdd(c2, F32x4Swizzle(p, 2, 2, 2, 2), rp);
+  F32x4Store3(&outPositions[i].x, rp);
+
+  if (normals != NULL) {
+    F32x4 n = F32x4Load3(&normals[i].x);
+    F32x4 rn = F32x4Mul(c0, F32x4Swizzle(n, 0, 0, 0, 0));
+    rn = F32x4MulAdd(c1, F32x4Swizzle(n, 1, 1, 1, 1), rn);
+    rn = F32x4MulAdd(c2, F32x4Swizzle(n, 2, 2, 2, 2), rn);
+    F32x4Store3(&outNormals[i].x, rn);
+  }
+}
+
+/**
+ * @brief Linear blend skinning of count vertices.
+ *
+ * Every vertex blends four palette entries, paletteStride floats apart. A
+ * stride of 16 reads Mat4 in the TransformToMat4 layout, whose rows x, y, z
+ * and w are already the columns of the map. A stride of 12 reads Affine34,
+ * three rows that are transposed after the blend. The point is mapped with
+ * w = 1 and the normal with w = 0; normals is NULL to skip them.
+ *
+ * Vertex i is fully read before it is written, so the outputs can be the
+ * inputs.
+ */
+static inline void BatchSkinLinear(const float* palette,
+                                   size_t paletteStride,
+                                   const uint16_t* joints,
+                                   const float* weights,
+                                   const Vec3* positions,
+                                   const Vec3* normals,
+                                   Vec3* outPositions,
+                                   Vec3* outNormals,
+                                   size_t count) {
+  if (paletteStride == 16) {
+    for (size_t i = 0; i < count; i++) {
+      const uint16_t* j = joints + 4 * i;
+      const float* w = weights + 4 * i;
+
+      // Rows x and y, then rows z and w, eight floats each.
+      F32x8 xy = F32x8Splat(0.0f);
+      F32x8 zw = F32x8Splat(0.0f);
+      for (unsigned k = 0; k < 4; k++) {
+        const float* m = palette + j[k] * paletteStride;
+        F32x8 wk = F32x8Splat(w[k]);
+        xy = F32x8MulAdd(F32x8Load(m), wk, xy);
+        zw = F32x8MulAdd(F32x8Load(m + 8), wk, zw);
+      }
+      BatchSkinLinearVertex(F32x8Lo(xy), F32x8Hi(xy), F32x8Lo(zw),
+                            F32x8Hi(zw), i, positions, normals, outPositions,
+                            outNormals);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    const uint16_t* j = joints + 4 * i;
+    const float* w = weights + 4 * i;
+
+    // Rows x and y of an entry are eight consecutive floats, row z is blended
+    // on its own.
+    F32x8 xy = F32x8Splat(0.0f);
+    F32x4 z = F32x4Splat(0.0f);
+    for (unsigned k = 0; k < 4; k++) {
+      const float* m = palette + j[k] * paletteStride;
+      xy = F32x8MulAdd(F32x8Load(m), F32x8Splat(w[k]), xy);
+      z = F32x4MulAdd(F32x4Load(m + 8), F32x4Splat(w[k]), z);
+    }
+
+    // Columns of the blended rows, c3 is the translation.
+    F32x4 c0 = F32x8Lo(xy);
+    F32x4 c1 = F32x8Hi(xy);
+    F32x4 c2 = z;
+    F32x4 c3 = F32x4Splat(0.0f);
+    F32x4Transpose(&c0, &c1, &c2, &c3);
+    BatchSkinLinearVertex(c0, c1, c2, c3, i, positions, normals, outPositions,
+                          outNormals);
+  }
+}
+
+// Dual quaternion skinning of exactly four vertices, all of them are read
+// before any write. normals is NULL to skip them.
+static inline void BatchSkinDualQuatBlock(const float* palette,
+                                          const uint16_t* joints,
+                                          const float* weights,
+                                          const Vec3* positions,
+                                          const Vec3* normals,
+                                          Vec3* outPositions,
+                                          Vec3* outNormals) {
+  // Blend each vertex in one register, real part in the low lanes and dual
+  // part in the high ones. Influences whose real part is in the opposite
+  // hemisphere of the first are subtracted.
+  F32x4 real[4];
+  F32x4 dual[4];
+  F32x4 zero = F32x4Splat(0.0f);
+  for (unsigned v = 0; v < 4; v++) {
+    const uint16_t* j = joints + 4 * v;
+    F32x8 dq[4];
+    for (unsigned k = 0; k < 4; k++) {
+      dq[k] = F32x8Load(palette + 8 * j[k]);
+    }
+
+    // Dot products of the real parts against the first one, summed by a
+    // transpose into lanes 1 to 3.
+    F32x4 r0 = F32x8Lo(dq[0]);
+    F32x4 d0 = zero;
+    F32x4 d1 = F32x4Mul(r0, F32x8Lo(dq[1]));
+    F32x4 d2 = F32x4Mul(r0, F32x8Lo(dq[2]));
+    F32x4 d3 = F32x4Mul(r0, F32x8Lo(dq[3]));
+    F32x4Transpose(&d0, &d1, &d2, &d3);
+    F32x4 d = F32x4Add(F32x4Add(d0, d1), F32x4Add(d2, d3));
+    F32x4 w = F32x4Load(weights + 4 * v);
+    w = F32x4Select(F32x4Less(d, zero), F32x4Sub(zero, w), w);
+
+    F32x4 w0 = F32x4Swizzle(w, 0, 0, 0, 0);
+    F32x4 w1 = F32x4Swizzle(w, 1, 1, 1, 1);
+    F32x4 w2 = F32x4Swizzle(w, 2, 2, 2, 2);
+    F32x4 w3 = F32x4Swizzle(w, 3, 3, 3, 3);
+    F32x8 b = F32x8Mul(dq[0], F32x8Combine(w0, w0));
+    b = F32x8MulAdd(dq[1], F32x8Combine(w1, w1), b);
+    b = F32x8MulAdd(dq[2], F32x8Combine(w2, w2), b);
+    b = F32x8MulAdd(dq[3], F32x8Combine(w3, w3), b);
+    real[v] = F32x8Lo(b);
+    dual[v] = F32x8Hi(b);
+  }
+  F32x4Transpose(&real[0], &real[1], &real[2], &real[3]);
+  F32x4Transpose(&dual[0], &dual[1], &dual[2], &dual[3]);
+
+  // Normalize by the length of the real part and get the translation,
+  // t = 2 (w_r d - w_d r + r x d).
+  F32x4 len = F32x4Mul(real[0], real[0]);
+  len = F32x4MulAdd(real[1], real[1], len);
+  len = F32x4MulAdd(real[2], real[2], len);
+  len = F32x4MulAdd(real[3], real[3], len);
+  F32x4 k = F32x4Div(F32x4Splat(1.0f), F32x4Sqrt(len));
+  for (unsigned i = 0; i < 4; i++) {
+    real[i] = F32x4Mul(real[i], k);
+    dual[i] = F32x4Mul(dual[i], k);
+  }
+  F32x4 two = F32x4Splat(2.0f);
+  F32x4 t[3];
+  for (unsigned i = 0; i < 3; i++) {
+    unsigned a = (i + 1) % 3;
+    unsigned b = (i + 2) % 3;
+    F32x4 c = F32x4Sub(F32x4Mul(real[a], dual[b]), F32x4Mul(real[b], dual[a]));
+    c = F32x4MulAdd(real[3], dual[i], c);
+    c = F32x4Sub(c, F32x4Mul(dual[3], real[i]));
+    t[i] = F32x4Mul(two, c);
+  }
+
+  F32x4 x = F32x4Load3(&positions[0].x);
+  F32x4 y = F32x4Load3(&positions[1].x);
+  F32x4 z = F32x4Load3(&positions[2].x);
+  F32x4 w = F32x4Load3(&positions[3].x);
+  F32x4Transpose(&x, &y, &z, &w);
+  BatchQuatRotateLanes(real, &x, &y, &z);
+  x = F32x4Add(x, t[0]);
+  y = F32x4Add(y, t[1]);
+  z = F32x4Add(z, t[2]);
+
+  F32x4 nx;
+  F32x4 ny;
+  F32x4 nz;
+  if (normals != NULL) {
+    nx = F32x4Load3(&normals[0].x);
+    ny = F32x4Load3(&normals[1].x);
+    nz = F32x4Load3(&normals[2].x);
+    F32x4 nw = F32x4Load3(&normals[3].x);
+    F32x4Transpose(&nx, &ny, &nz, &nw);
+    BatchQuatRotateLanes(real, &nx, &ny, &nz);
+  }
+
+  w = F32x4Splat(0.0f);
+  F32x4Transpose(&x, &y, &z, &w);
+  F32x4Store3(&outPositions[0].x, x);
+  F32x4Store3(&outPositions[1].x, y);
+  F32x4Store3(&outPositions[2].x, z);
+  F32x4Store3(&outPositions[3].x, w);
+  if (normals != NULL) {
+    F32x4 nw = F32x4Splat(0.0f);
+    F32x4Transpose(&nx, &ny, &nz, &nw);
+    F32x4Store3(&outNormals[0].x, nx);
+    F32x4Store3(&outNormals[1].x, ny);
+    F32x4Store3(&outNormals[2].x, nz);
+    F32x4Store3(&outNormals[3].x, nw);
+  }
+}
+
+/**
+ * @brief Dual quaternion skinning of count vertices.
+ *
+ * palette holds 8 floats per bone, the real and the dual part of a unit dual
+ * quaternion as x, y, z and w. Every vertex blends four bones as
+ * DualQuatBlend does and maps its point and its normal; normals is NULL to
+ * skip them. The weights of a vertex must not add up to zero.
+ *
+ * Vertex i is fully read before it is written, so the outputs can be the
+ * inputs.
+ */
+static inline void BatchSkinDualQuat(const float* palette,
+                                     const uint16_t* joints,
+                                     const float* weights,
+                                     const Vec3* positions,
+                                     const Vec3* normals,
+                                     Vec3* outPositions,
+                                     Vec3* outNormals,
+                                     size_t count) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const Vec3* n = normals != NULL ? normals + i : NULL;
+    Vec3* outN = normals != NULL ? outNormals + i : NULL;
+    BatchSkinDualQuatBlock(palette, joints + 4 * i, weights + 4 * i,
+                           positions + i, n, outPositions + i, outN);
+  }
+
+  // Pad the remainder with vertices fully bound to the first bone.
+  size_t rest = count - i;
+  if (rest > 0) {
+    uint16_t jtail[16] = {0};
+    float wtail[16] = {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f,
+                       1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f};
+    Vec3 ptail[4] = {0};
+    Vec3 ntail[4] = {0};
+    for (size_t j = 0; j < rest; j++) {
+      for (size_t k = 0; k < 4; k++) {
+        jtail[4 * j + k] = joints[4 * (i + j) + k];
+        wtail[4 * j + k] = weights[4 * (i + j) + k];
+      }
+      ptail[j] = positions[i + j];
+      if (normals != NULL) {
+        ntail[j] = normals[i + j];
+      }
+    }
+    BatchSkinDualQuatBlock(palette, jtail, wtail, ptail,
+                           normals ? ntail : NULL, ptail, ntail);
+    for (size_t j = 0; j < rest; j++) {
+      outPositions[i + j] = ptail[j];
+      if (normals != NULL) {
+        outNormals[i + j] = ntail[j];
+      }
+    }
+  }
+}
+
+// Interpolate exactly four transforms of 10 floats (position, rotation and
+// scale), all of them are read before any write.
+static inline void BatchTransformLerpBlock(float* const out[4],
+                                           const float* const a[4],
+                                           const float* const b[4],
+                                           const float* t) {
+  F32x4 ap[4];
+  F32x4 bp[4];
+  F32x4 aq[4];
+  F32x4 bq[4];
+  F32x4 as[4];
+  F32x4 bs[4];
+  for (unsigned i = 0; i < 4; i++) {
+    ap[i] = F32x4Load3(a[i]);
+    bp[i] = F32x4Load3(b[i]);
+    aq[i] = F32x4Load(a[i] + 3);
+    bq[i] = F32x4Load(b[i] + 3);
+    as[i] = F32x4Load3(a[i] + 7);
+    bs[i] = F32x4Load3(b[i] + 7);
+  }
+  F32x4Transpose(&aq[0], &aq[1], &aq[2], &aq[3]);
+  F32x4Transpose(&bq[0], &bq[1], &bq[2], &bq[3]);
+
+  // Take the short way as TransformLerp, then QuatNLerp.
+  F32x4 f = F32x4Load(t);
+  F32x4 g = F32x4Sub(F32x4Splat(1.0f), f);
+  F32x4 d = F32x4Mul(aq[0], bq[0]);
+  for (unsigned i = 1; i < 4; i++) {
+    d = F32x4MulAdd(aq[i], bq[i], d);
+  }
+  F32x4 zero = F32x4Splat(0.0f);
+  F32x4 fb = F32x4Select(F32x4Less(d, zero), F32x4Sub(zero, f), f);
+  F32x4 len = zero;
+  for (unsigned i = 0; i < 4; i++) {
+    aq[i] = F32x4MulAdd(bq[i], fb, F32x4Mul(aq[i], g));
+    len = F32x4MulAdd(aq[i], aq[i], len);
+  }
+  len = F32x4Sqrt(len);
+  F32x4 one = F32x4Splat(1.0f);
+  F32x4 k = F32x4Select(F32x4Less(len, F32x4Splat(XMATH_EPSILON)), one,
+                        F32x4Div(one, len));
+  for (unsigned i = 0; i < 4; i++) {
+    aq[i] = F32x4Mul(aq[i], k);
+  }
+  F32x4Transpose(&aq[0], &aq[1], &aq[2], &aq[3]);
+
+  // Position and scale lerp lane by lane within each transform.
+  F32x4 lanes[4] = {
+      F32x4Swizzle(f, 0, 0, 0, 0),
+      F32x4Swizzle(f, 1, 1, 1, 1),
+      F32x4Swizzle(f, 2, 2, 2, 2),
+      F32x4Swizzle(f, 3, 3, 3, 3),
+  };
+  for (unsigned i = 0; i < 4; i++) {
+    ap[i] = F32x4MulAdd(F32x4Sub(bp[i], ap[i]), lanes[i], ap[i]);
+    as[i] = F32x4MulAdd(F32x4Sub(bs[i], as[i]), lanes[i], as[i]);
+  }
+  for (unsigned i = 0; i < 4; i++) {
+    F32x4Store3(out[i], ap[i]);
+    F32x4Store(out[i] + 3, aq[i]);
+    F32x4Store3(out[i] + 7, as[i]);
+  }
+}
+
+/**
+ * @brief Same as TransformLerp(*a[i], *b[i], t[i]) into out[i].
+ *
+ * a and b hold count pointers to transforms of 10 floats: position, rotation
+ * and scale as in Transform. out holds count transforms and must not
+ * overlap the inputs.
+ */
+static inline void BatchTransformLerpGather(float* out,
+                                            const float* const* a,
+                                            const float* const* b,
+                                            const float* t,
+                                            size_t count) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    float* o[4] = {out + 10 * i, out + 10 * i + 10, out + 10 * i + 20,
+                   out + 10 * i + 30};
+    BatchTransformLerpBlock(o, a + i, b + i, t + i);
+  }
+
+  // Run the remainder through a block padded with the first element.
+  size_t rest = count - i;
+  if (rest > 0) {
+    float tail[40];
+    float* o[4] = {tail, tail + 10, tail + 20, tail + 30};
+    const float* ta[4] = {a[i], a[i], a[i], a[i]};
+    const float* tb[4] = {b[i], b[i], b[i], b[i]};
+    float tt[4] = {t[i], t[i], t[i], t[i]};
+    for (size_t j = 1; j < rest; j++) {
+      ta[j] = a[i + j];
+      tb[j] = b[i + j];
+      tt[j] = t[i + j];
+    }
+    BatchTransformLerpBlock(o, ta, tb, tt);
+    for (size_t j = 0; j < 10 * rest; j++) {
+      out[10 * i + j] = tail[j];
+    }
+  }
+}
+
+// Four cubic curves of 12 floats, the control points k0..k3 in the order of
+// the curve structs, weighted lane by lane by the basis of f.
+static inline void BatchCurveBlock(Vec3* out,
+                                   const float* curves,
+                                   F32x4 f,
+                                   bool hermit) {
+  // Each curve is three quads: k0.xyz k1.x | k1.yz k2.xy | k2.z k3.xyz, a
+  // transpose per quad gives each component of the four curves in a lane.
+  F32x4 r[3][4];
+  for (unsigned q = 0; q < 3; q++) {
+    for (unsigned i = 0; i < 4; i++) {
+      r[q][i] = F32x4Load(curves + 12 * i + 4 * q);
+    }
+    F32x4Transpose(&r[q][0], &r[q][1], &r[q][2], &r[q][3]);
+  }
+
+  F32x4 one = F32x4Splat(1.0f);
+  F32x4 g = F32x4Sub(one, f);
+  F32x4 f2 = F32x4Mul(f, f);
+  F32x4 g2 = F32x4Mul(g, g);
+  F32x4 w[4];
+  if (hermit) {
+    // Same basis as HermitInterpolate.
+    w[0] = F32x4Mul(F32x4MulAdd(F32x4Splat(2.0f), f, one), g2);
+    w[1] = F32x4Mul(f, g2);
+    w[2] = F32x4Mul(f2, F32x4Sub(F32x4Splat(3.0f), F32x4Add(f, f)));
+    w[3] = F32x4Mul(f2, F32x4Sub(f, one));
+  } else {
+    // Same basis as BeizerInterpolate, k2 is p2 and k3 is c2.
+    F32x4 three = F32x4Splat(3.0f);
+    w[0] = F32x4Mul(g2, g);
+    w[1] = F32x4Mul(F32x4Mul(three, g2), f);
+    w[2] = F32x4Mul(f2, f);
+    w[3] = F32x4Mul(F32x4Mul(three, g), f2);
+  }
+
+  F32x4 x = F32x4Mul(w[0], r[0][0]);
+  x = F32x4MulAdd(w[1], r[0][3], x);
+  x = F32x4MulAdd(w[2], r[1][2], x);
+  x = F32x4MulAdd(w[3], r[2][1], x);
+  F32x4 y = F32x4Mul(w[0], r[0][1]);
+  y = F32x4MulAdd(w[1], r[1][0], y);
+  y = F32x4MulAdd(w[2], r[1][3], y);
+  y = F32x4MulAdd(w[3], r[2][2], y);
+  F32x4 z = F32x4Mul(w[0], r[0][2]);
+  z = F32x4MulAdd(w[1], r[1][1], z);
+  z = F32x4MulAdd(w[2], r[2][0], z);
+  z = F32x4MulAdd(w[3], r[2][3], z);
+
+  F32x4 pad = F32x4Splat(0.0f);
+  F32x4Transpose(&x, &y, &z, &pad);
+  F32x4Store3(&out[0].x, x);
+  F32x4Store3(&out[1].x, y);
+  F32x4Store3(&out[2].x, z);
+  F32x4Store3(&out[3].x, pad);
+}
+
+static inline void BatchCurveArray(Vec3* out,
+                                   const float* curves,
+                                   const float* t,
+                                   size_t count,
+                                   bool hermit) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    BatchCurveBlock(out + i, curves + 12 * i, F32x4Load(t + i), hermit);
+  }
+
+  // Run the remainder through a block padded with the first element.
+  size_t rest = count - i;
+  if (rest > 0) {
+    float block[48];
+    float tt[4];
+    Vec3 tail[4];
+    for (size_t j = 0; j < 4; j++) {
+      size_t k = j < rest ? i + j : i;
+      for (size_t e = 0; e < 12; e++) {
+        block[12 * j + e] = curves[12 * k + e];
+      }
+      tt[j] = t[k];
+    }
+    BatchCurveBlock(tail, block, F32x4Load(tt), hermit);
+    for (size_t j = 0; j < rest; j++) {
+      out[i + j] = tail[j];
+    }
+  }
+}
+
+/**
+ * @brief Same as BeizerInterpolate(curves[i], t[i]) into out[i].
+ *
+ * curves holds count beizer curves of 12 floats, out must not overlap the
+ * inputs. Each lane of the block evaluates a different curve.
+ */
+static inline void BatchBeizerArray(Vec3* out,
+                                    const float* curves,
+                                    const float* t,
+                                    size_t count) {
+  BatchCurveArray(out, curves, t, count, false);
+}
+
+/**
+ * @brief Same as HermitInterpolate(curves[i], t[i]) into out[i].
+ *
+ * curves holds count hermit curves of 12 floats, out must not overlap the
+ * inputs. Each lane of the block evaluates a different curve.
+ */
+static inline void BatchHermitArray(Vec3* out,
+                                    const float* curves,
+                                    const float* t,
+                                    size_t count) {
+  BatchCurveArray(out, curves, t, count, true);
+}
+
+/**
+ * @brief Product of two matrices, same as Mat4Mul.
+ *
+ * r must not be b.
+ */
+static inline void BatchMat4Mul(Mat4* r, const Mat4* a, const Mat4* b) {
+  const float* as = &a->xx;
+  const float* bs = &b->xx;
+  float* rs = &r->xx;
+
+  // Each row of the result is the sum of the rows of b scaled by the
+  // broadcast elements of the same row of a.
+#if defined(XMATH_SIMD_AVX)
+  F32x8 b0 = F32x8Broadcast4(bs);
+  F32x8 b1 = F32x8Broadcast4(bs + 4);
+  F32x8 b2 = F32x8Broadcast4(bs + 8);
+  F32x8 b3 = F32x8Broadcast4(bs + 12);
+  for (unsigned i = 0; i < 16; i += 8) {
+    // Two 128 bit loads so the caller's stores of a can be forwarded.
+    F32x8 ar = F32x8Combine(F32x4Load(as + i), F32x4Load(as + i + 4));
+    F32x8 acc = F32x8Mul(F32x8SplatLane(ar, 0), b0);
+    acc = F32x8MulAdd(F32x8SplatLane(ar, 1), b1, acc);
+    acc = F32x8MulAdd(F32x8SplatLane(ar, 2), b2, acc);
+    acc = F32x8MulAdd(F32x8SplatLane(ar, 3), b3, acc);
+    F32x8Store(rs + i, acc);
+  }
+#else
+  F32x4 b0 = F32x4Load(bs);
+  F32x4 b1 = F32x4Load(bs + 4);
+  F32x4 b2 = F32x4Load(bs + 8);
+  F32x4 b3 = F32x4Load(bs + 12);
+  for (unsigned i = 0; i < 16; i += 4) {
+    F32x4 acc = F32x4Mul(F32x4Splat(as[i]), b0);
+    acc = F32x4MulAdd(F32x4Splat(as[i + 1]), b1, acc);
+    acc = F32x4MulAdd(F32x4Splat(as[i + 2]), b2, acc);
+    acc = F32x4MulAdd(F32x4Splat(as[i + 3]), b3, acc);
+    F32x4Store(rs + i, acc);
+  }
+#endif
+}
+
+//! @brief Columns of m in the four lanes of both halves.
+static inline void BatchMat4Columns8(const Mat4* m, F32x8 c[4]) {
+  F32x4 c0 = F32x4Load(&m->xx);
+  F32x4 c1 = F32x4Load(&m->yx);
+  F32x4 c2 = F32x4Load(&m->zx);
+  F32x4 c3 = F32x4Load(&m->wx);
+  F32x4Transpose(&c0, &c1, &c2, &c3);
+  c[0] = F32x8Combine(c0, c0);
+  c[1] = F32x8Combine(c1, c1);
+  c[2] = F32x8Combine(c2, c2);
+  c[3] = F32x8Combine(c3, c3);
+}
+
+//! @brief Multiply the vector at v by the columns c, same as Mat4MulVec4.
+static inline F32x4 BatchMat4MulVec4One(const F32x8 c[4], F32x4 v) {
+  F32x4 acc = F32x4Mul(F32x8Lo(c[0]), F32x4Swizzle(v, 0, 0, 0, 0));
+  acc = F32x4MulAdd(F32x8Lo(c[1]), F32x4Swizzle(v, 1, 1, 1, 1), acc);
+  acc = F32x4MulAdd(F32x8Lo(c[2]), F32x4Swizzle(v, 2, 2, 2, 2), acc);
+  return F32x4MulAdd(F32x8Lo(c[3]), F32x4Swizzle(v, 3, 3, 3, 3), acc);
+}
+
+//! @brief Multiply two vectors at once by the columns c.
+static inline F32x8 BatchMat4MulVec4Two(const F32x8 c[4], F32x8 v) {
+  F32x8 acc = F32x8Mul(c[0], F32x8SplatLane(v, 0));
+  acc = F32x8MulAdd(c[1], F32x8SplatLane(v, 1), acc);
+  acc = F32x8MulAdd(c[2], F32x8SplatLane(v, 2), acc);
+  return F32x8MulAdd(c[3], F32x8SplatLane(v, 3), acc);
+}
+
+/**
+ * @brief Same as Mat4MulVec4Array.
+ *
+ * out can be the same as in.
+ */
+static inline void BatchMat4MulVec4Array(Vec4* out,
+                                         const Mat4* m,
+                                         const Vec4* in,
+                                         size_t count) {
+  // Two vectors per iteration, each half scales the columns of m by the
+  // broadcast components of its own vector.
+  F32x8 c[4];
+  BatchMat4Columns8(m, c);
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    F32x8Store(&out[i].x, BatchMat4MulVec4Two(c, F32x8Load(&in[i].x)));
+  }
+
+  if (i < count) {
+    F32x4Store(&out[i].x, BatchMat4MulVec4One(c, F32x4Load(&in[i].x)));
+  }
+}
+
+/**
+ * @brief Same as Mat4MulVec4Strided.
+ *
+ * out can be the same as in when both use the same stride.
+ */
+static inline void BatchMat4MulVec4Strided(Vec4* out,
+                                           size_t outStride,
+                                           const Mat4* m,
+                                           const Vec4* in,
+                                           size_t inStride,
+                                           size_t count) {
+  const char* src = (const char*)in;
+  char* dst = (char*)out;
+  F32x8 c[4];
+  BatchMat4Columns8(m, c);
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    const float* p0 = (const float*)(src + i * inStride);
+    const float* p1 = (const float*)(src + (i + 1) * inStride);
+    F32x8 v = F32x8Combine(F32x4Load(p0), F32x4Load(p1));
+    F32x8 acc = BatchMat4MulVec4Two(c, v);
+    F32x4Store((float*)(dst + i * outStride), F32x8Lo(acc));
+    F32x4Store((float*)(dst + (i + 1) * outStride), F32x8Hi(acc));
+  }
+
+  if (i < count) {
+    F32x4 v = F32x4Load((const float*)(src + i * inStride));
+    F32x4Store((float*)(dst + i * outStride), BatchMat4MulVec4One(c, v));
+  }
+}
+
+//! @brief Matrices inverted together by BatchMat4InvertArray.
+#define BATCH_INVERT_LANES 8
+
+// Element e of matrix k goes to lane k of a[e], the 4x4 blocks of two
+// groups of four matrices are transposed and joined in registers.
+static inline void BatchMat4Gather(F32x8 a[16], const Mat4* in) {
+  for (unsigned b = 0; b < 16; b += 4) {
+    F32x4 l0 = F32x4Load(&in[0].xx + b);
+    F32x4 l1 = F32x4Load(&in[1].xx + b);
+    F32x4 l2 = F32x4Load(&in[2].xx + b);
+    F32x4 l3 = F32x4Load(&in[3].xx + b);
+    F32x4 h0 = F32x4Load(&in[4].xx + b);
+    F32x4 h1 = F32x4Load(&in[5].xx + b);
+    F32x4 h2 = F32x4Load(&in[6].xx + b);
+    F32x4 h3 = F32x4Load(&in[7].xx + b);
+    F32x4Transpose(&l0, &l1, &l2, &l3);
+    F32x4Transpose(&h0, &h1, &h2, &h3);
+    a[b] = F32x8Combine(l0, h0);
+    a[b + 1] = F32x8Combine(l1, h1);
+    a[b + 2] = F32x8Combine(l2, h2);
+    a[b + 3] = F32x8Combine(l3, h3);
+  }
+}
+
+static inline void BatchMat4Scatter(Mat4* out, const F32x8 a[16]) {
+  for (unsigned b = 0; b < 16; b += 4) {
+    F32x4 l0 = F32x8Lo(a[b]);
+    F32x4 l1 = F32x8Lo(a[b + 1]);
+    F32x4 l2 = F32x8Lo(a[b + 2]);
+    F32x4 l3 = F32x8Lo(a[b + 3]);
+    F32x4 h0 = F32x8Hi(a[b]);
+    F32x4 h1 = F32x8Hi(a[b + 1]);
+    F32x4 h2 = F32x8Hi(a[b + 2]);
+    F32x4 h3 = F32x8Hi(a[b + 3]);
+    F32x4Transpose(&l0, &l1, &l2, &l3);
+    F32x4Transpose(&h0, &h1, &h2, &h3);
+    F32x4Store(&out[0].xx + b, l0);
+    F32x4Store(&out[1].xx + b, l1);
+    F32x4Store(&out[2].xx + b, l2);
+    F32x4Store(&out[3].xx + b, l3);
+    F32x4Store(&out[4].xx + b, h0);
+    F32x4Store(&out[5].xx + b, h1);
+    F32x4Store(&out[6].xx + b, h2);
+    F32x4Store(&out[7].xx + b, h3);
+  }
+}
+
+// a * b - c * d
+static inline F32x8 BatchDiffOfProducts(F32x8 a, F32x8 b, F32x8 c, F32x8 d) {
+  return F32x8Sub(F32x8Mul(a, b), F32x8Mul(c, d));
+}
+
+/**
+ * @brief Invert BATCH_INVERT_LANES matrices, one per lane.
+ *
+ * Singular matrices are left as they are in out.
+ * @return bit k set when matrix k was inverted.
+ */
+static inline uint32_t BatchMat4InvertBlock(Mat4* out, const Mat4* in) {
+  F32x8 a[16];
+  BatchMat4Gather(a, in);
+
+  // Same cofactors as Mat4Invert, grouped in the 2x2 minors of the two top
+  // rows (s) and of the two bottom rows (c).
+  F32x8 s0 = BatchDiffOfProducts(a[0], a[5], a[1], a[4]);
+  F32x8 s1 = BatchDiffOfProducts(a[0], a[6], a[2], a[4]);
+  F32x8 s2 = BatchDiffOfProducts(a[0], a[7], a[3], a[4]);
+  F32x8 s3 = BatchDiffOfProducts(a[1], a[6], a[2], a[5]);
+  F32x8 s4 = BatchDiffOfProducts(a[1], a[7], a[3], a[5]);
+  F32x8 s5 = BatchDiffOfProducts(a[2], a[7], a[3], a[6]);
+  F32x8 c0 = BatchDiffOfProducts(a[8], a[13], a[9], a[12]);
+  F32x8 c1 = BatchDiffOfProducts(a[8], a[14], a[10], a[12]);
+  F32x8 c2 = BatchDiffOfProducts(a[8], a[15], a[11], a[12]);
+  F32x8 c3 = BatchDiffOfProducts(a[9], a[14], a[10], a[13]);
+  F32x8 c4 = BatchDiffOfProducts(a[9], a[15], a[11], a[13]);
+  F32x8 c5 = BatchDiffOfProducts(a[10], a[15], a[11], a[14]);
+
+  F32x8 det = F32x8Sub(F32x8Mul(s0, c5), F32x8Mul(s1, c4));
+  det = F32x8MulAdd(s2, c3, det);
+  det = F32x8MulAdd(s3, c2, det);
+  det = F32x8Sub(det, F32x8Mul(s4, c1));
+  det = F32x8MulAdd(s5, c0, det);
+
+  _Alignas(32) float dets[BATCH_INVERT_LANES];
+  F32x8Store(dets, det);
+  uint32_t ok = 0;
+  for (unsigned k = 0; k < BATCH_INVERT_LANES; k++) {
+    ok |= (uint32_t)(dets[k] != 0.0f) << k;
+  }
+  if (ok == 0) {
+    return 0;
+  }
+
+  // Singular lanes divide by zero, their results are dropped below.
+  F32x8 k = F32x8Div(F32x8Splat(1.0f), det);
+  F32x8 r[16];
+  r[0] = F32x8MulAdd(a[7], c3, BatchDiffOfProducts(a[5], c5, a[6], c4));
+  r[1] = F32x8Sub(BatchDiffOfProducts(a[2], c4, a[1], c5), F32x8Mul(a[3], c3));
+  r[2] = F32x8MulAdd(a[15], s3, BatchDiffOfProducts(a[13], s5, a[14], s4));
+  r[3] = F32x8Sub(BatchDiffOfProducts(a[10], s4, a[9], s5),
+                  F32x8Mul(a[11], s3));
+  r[4] = F32x8Sub(BatchDiffOfProducts(a[6], c2, a[4], c5), F32x8Mul(a[7], c1));
+  r[5] = F32x8MulAdd(a[3], c1, BatchDiffOfProducts(a[0], c5, a[2], c2));
+  r[6] = F32x8Sub(BatchDiffOfProducts(a[14], s2, a[12], s5),
+                  F32x8Mul(a[15], s1));
+  r[7] = F32x8MulAdd(a[11], s1, BatchDiffOfProducts(a[8], s5, a[10], s2));
+  r[8] = F32x8MulAdd(a[7], c0, BatchDiffOfProducts(a[4], c4, a[5], c2));
+  r[9] = F32x8Sub(BatchDiffOfProducts(a[1], c2, a[0], c4), F32x8Mul(a[3], c0));
+  r[10] = F32x8MulAdd(a[15], s0, BatchDiffOfProducts(a[12], s4, a[13], s2));
+  r[11] = F32x8Sub(BatchDiffOfProducts(a[9], s2, a[8], s4),
+                   F32x8Mul(a[11], s0));
+  r[12] = F32x8Sub(BatchDiffOfProducts(a[5], c1, a[4], c3), F32x8Mul(a[6], c0));
+  r[13] = F32x8MulAdd(a[2], c0, BatchDiffOfProducts(a[0], c3, a[1], c1));
+  r[14] = F32x8Sub(BatchDiffOfProducts(a[13], s1, a[12], s3),
+                   F32x8Mul(a[14], s0));
+  r[15] = F32x8MulAdd(a[10], s0, BatchDiffOfProducts(a[8], s3, a[9], s1));
+  for (unsigned i = 0; i < 16; i++) {
+    r[i] = F32x8Mul(r[i], k);
+  }
+
+  if (ok == (1u << BATCH_INVERT_LANES) - 1) {
+    BatchMat4Scatter(out, r);
+  } else {
+    Mat4 res[BATCH_INVERT_LANES];
+    BatchMat4Scatter(res, r);
+    for (unsigned i = 0; i < BATCH_INVERT_LANES; i++) {
+      if (ok & (1u << i)) {
+        out[i] = res[i];
+      }
+    }
+  }
+  return ok;
+}
+
+/**
+ * @brief Same as Mat4InvertArray.
+ *
+ * out can be the same as in.
+ */
+static inline bool BatchMat4InvertArray(Mat4* out,
+                                        const Mat4* in,
+                                        uint32_t* okMask,
+                                        size_t count) {
+  bool all = true;
+  for (size_t i = 0; i < count; i += BATCH_INVERT_LANES) {
+    size_t rest = count - i;
+    uint32_t ok;
+    if (rest >= BATCH_INVERT_LANES) {
+      rest = BATCH_INVERT_LANES;
+      ok = BatchMat4InvertBlock(out + i, in + i);
+    } else {
+      // The missing lanes invert identities and are never written back.
+      Mat4 pad[BATCH_INVERT_LANES];
+      for (size_t j = 0; j < BATCH_INVERT_LANES; j++) {
+        pad[j] = j < rest ? in[i + j] : Mat4Identity;
+      }
+      ok = BatchMat4InvertBlock(pad, pad) & ((1u << rest) - 1);
+      for (size_t j = 0; j < rest; j++) {
+        if (ok & (1u << j)) {
+          out[i + j] = pad[j];
+        }
+      }
+    }
+
+    all = all && ok == (1u << rest) - 1;
+    if (okMask != NULL) {
+      // Blocks never straddle two words of the mask.
+      if (i % 32 == 0) {
+        okMask[i / 32] = 0;
+      }
+      okMask[i / 32] |= ok << (i % 32);
+    }
+  }
+  return all;
+}
+
+#endif /* XMATH_BATCH_H */
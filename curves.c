@@ -1,6 +1,10 @@
 #include "curves.h"
+#include <math.h>
+#include "dispatch_table.h"
+#include "scalar.h"
+#include "simd.h"
 
-Vec3 BeizerInterpolate(BeizerCurve curve, float t) {
+XMATH_API Vec3 BeizerInterpolate(BeizerCurve curve, float t) {
   float it = 1.0f - t;
   Vec3 a = Vec3Scale(curve.p1, it * it * it);
   Vec3 b = Vec3Scale(curve.c1, 3.0f * it * it * t);
@@ -9,10 +13,233 @@ Vec3 BeizerInterpolate(BeizerCurve curve, float t) {
   return Vec3Add(Vec3Add(Vec3Add(a, b), c), d);
 }
 
-Vec3 HermitInterpolate(HermitCurve curve, float t) {
+XMATH_API Vec3 HermitInterpolate(HermitCurve curve, float t) {
   Vec3 a = Vec3Scale(curve.p1, (1.0f + 2.0f * t) * (1.0f - t) * (1.0f - t));
   Vec3 b = Vec3Scale(curve.s1, t * (1.0f - t) * (1.0f - t));
   Vec3 c = Vec3Scale(curve.p2, (t * t) * (3.0f - 2.0f * t));
   Vec3 d = Vec3Scale(curve.s2, (t * t) * (t - 1.0f));
   return Vec3Add(Vec3Add(Vec3Add(a, b), c), d);
 }
+
+XMATH_API void BeizerInterpolateArray(Vec3* out,
+                                      const BeizerCurve* curves,
+                                      const float* t,
+                                      size_t count) {
+  DispatchBeizerArray(out, (const float*)curves, t, count);
+}
+
+XMATH_API void HermitInterpolateArray(Vec3* out,
+                                      const HermitCurve* curves,
+                                      const float* t,
+                                      size_t count) {
+  DispatchHermitArray(out, (const float*)curves, t, count);
+}
+
+XMATH_API void BeizerPowerBasis(Vec3 k[4], BeizerCurve curve) {
+  Vec3 p1 = curve.p1;
+  Vec3 c1 = curve.c1;
+  Vec3 c2 = curve.c2;
+  Vec3 p2 = curve.p2;
+  k[0] = Vec3Add(Vec3Sub(p2, p1), Vec3Scale(Vec3Sub(c1, c2), 3.0f));
+  k[1] = Vec3Scale(Vec3Add(Vec3Sub(p1, Vec3Scale(c1, 2.0f)), c2), 3.0f);
+  k[2] = Vec3Scale(Vec3Sub(c1, p1), 3.0f);
+  k[3] = p1;
+}
+
+XMATH_API void HermitPowerBasis(Vec3 k[4], HermitCurve curve) {
+  Vec3 p1 = curve.p1;
+  Vec3 s1 = curve.s1;
+  Vec3 p2 = curve.p2;
+  Vec3 s2 = curve.s2;
+  Vec3 dp = Vec3Sub(p2, p1);
+  k[0] = Vec3Sub(Vec3Add(s1, s2), Vec3Scale(dp, 2.0f));
+  k[1] = Vec3Sub(Vec3Scale(dp, 3.0f), Vec3Add(Vec3Scale(s1, 2.0f), s2));
+  k[2] = s1;
+  k[3] = p1;
+}
+
+// Points between two restarts of the forward differences, the rounding error
+// of the additions grows with the cube of the run so it is kept short.
+#define XMATH_CURVE_RUN 64
+
+// Forward differences of the power basis k at t, with step h.
+static inline void CurvesDifferences(F32x4 d[4],
+                                     const F32x4 k[4],
+                                     float t,
+                                     float h) {
+  float h2 = h * h;
+  float h3 = h2 * h;
+  float t2 = t * t;
+
+  // p = a t^3 + b t^2 + c t + d
+  // d1 = a (3 t^2 h + 3 t h^2 + h^3) + b (2 t h + h^2) + c h
+  // d2 = a (6 t h^2 + 6 h^3) + b 2 h^2
+  // d3 = a 6 h^3
+  F32x4 p = F32x4MulAdd(k[0], F32x4Splat(t), k[1]);
+  p = F32x4MulAdd(p, F32x4Splat(t), k[2]);
+  d[0] = F32x4MulAdd(p, F32x4Splat(t), k[3]);
+  F32x4 d1 = F32x4Mul(k[0], F32x4Splat(3.0f * (t2 * h + t * h2) + h3));
+  d1 = F32x4MulAdd(k[1], F32x4Splat(2.0f * t * h + h2), d1);
+  d[1] = F32x4MulAdd(k[2], F32x4Splat(h), d1);
+  F32x4 d2 = F32x4Mul(k[0], F32x4Splat(6.0f * (t * h2 + h3)));
+  d[2] = F32x4MulAdd(k[1], F32x4Splat(2.0f * h2), d2);
+  d[3] = F32x4Mul(k[0], F32x4Splat(6.0f * h3));
+}
+
+// Forward differencing of a power basis at count uniform steps. Every run
+// starts from an exact point and the last point is set to the end of the
+// curve, so the error does not build up with count.
+static inline void CurvesTessellate(Vec3* out,
+                                    const Vec3 basis[4],
+                                    size_t count) {
+  if (count < 2) {
+    if (count == 1) {
+      out[0] = basis[3];
+    }
+    return;
+  }
+
+  F32x4 k[4];
+  for (unsigned i = 0; i < 4; i++) {
+    k[i] = F32x4Load3(&basis[i].x);
+  }
+
+  float h = 1.0f / (float)(count - 1);
+  for (size_t first = 0; first + 1 < count; first += XMATH_CURVE_RUN) {
+    F32x4 d[4];
+    CurvesDifferences(d, k, (float)first * h, h);
+    size_t last = first + XMATH_CURVE_RUN;
+    if (last > count - 1) {
+      last = count - 1;
+    }
+
+    F32x4Store3(&out[first].x, d[0]);
+    for (size_t i = first + 1; i < last; i++) {
+      d[0] = F32x4Add(d[0], d[1]);
+      d[1] = F32x4Add(d[1], d[2]);
+      d[2] = F32x4Add(d[2], d[3]);
+      F32x4Store3(&out[i].x, d[0]);
+    }
+  }
+
+  out[count - 1] =
+      Vec3Add(Vec3Add(basis[0], basis[1]), Vec3Add(basis[2], basis[3]));
+}
+
+XMATH_API void BeizerTessellate(Vec3* out, BeizerCurve curve, size_t count) {
+  Vec3 k[4];
+  BeizerPowerBasis(k, curve);
+  CurvesTessellate(out, k, count);
+}
+
+XMATH_API void HermitTessellate(Vec3* out, HermitCurve curve, size_t count) {
+  Vec3 k[4];
+  HermitPowerBasis(k, curve);
+  CurvesTessellate(out, k, count);
+}
+
+// Newton steps of BeizerArcParameter, the guess inside a span is close enough
+// for two of them to reach the precision of the quadrature.
+#define XMATH_ARC_NEWTON 2
+
+// Derivative of a beizer curve, 3 a t^2 + 2 b t + c on its power basis.
+typedef struct {
+  Vec3 a;
+  Vec3 b;
+  Vec3 c;
+} BeizerArcSpeed;
+
+static inline BeizerArcSpeed BeizerArcSpeedMake(const BeizerCurve* curve) {
+  Vec3 k[4];
+  BeizerPowerBasis(k, *curve);
+  return (BeizerArcSpeed){
+      .a = Vec3Scale(k[0], 3.0f),
+      .b = Vec3Scale(k[1], 2.0f),
+      .c = k[2],
+  };
+}
+
+static inline float BeizerArcSpeedAt(const BeizerArcSpeed* s, float t) {
+  // Written out, this runs dozens of times per lookup.
+  float x = (s->a.x * t + s->b.x) * t + s->c.x;
+  float y = (s->a.y * t + s->b.y) * t + s->c.y;
+  float z = (s->a.z * t + s->b.z) * t + s->c.z;
+  return sqrtf(x * x + y * y + z * z);
+}
+
+// Length between t0 and t1 with a five point Gauss-Legendre quadrature.
+static inline float BeizerArcIntegrate(const BeizerArcSpeed* s,
+                                       float t0,
+                                       float t1) {
+  static const float nodes[5] = {
+      0.0f, -0.5384693101f, 0.5384693101f, -0.9061798459f, 0.9061798459f,
+  };
+  static const float weights[5] = {
+      0.5688888889f, 0.4786286705f, 0.4786286705f, 0.2369268851f, 0.2369268851f,
+  };
+
+  float half = 0.5f * (t1 - t0);
+  float mid = 0.5f * (t1 + t0);
+  float sum = 0.0f;
+  for (unsigned i = 0; i < 5; i++) {
+    sum += weights[i] * BeizerArcSpeedAt(s, mid + half * nodes[i]);
+  }
+  return half * sum;
+}
+
+XMATH_API void BeizerArcTableMake(BeizerArcTable* r, BeizerCurve curve) {
+  BeizerArcSpeed s = BeizerArcSpeedMake(&curve);
+  float step = 1.0f / (float)XMATH_ARC_SPANS;
+  float length = 0.0f;
+  for (unsigned i = 0; i < XMATH_ARC_SPANS; i++) {
+    length += BeizerArcIntegrate(&s, (float)i * step, (float)(i + 1) * step);
+    r->lengths[i] = length;
+  }
+}
+
+XMATH_API float BeizerArcLength(const BeizerArcTable* table) {
+  return table->lengths[XMATH_ARC_SPANS - 1];
+}
+
+XMATH_API float BeizerArcParameter(const BeizerArcTable* table,
+                                   BeizerCurve curve,
+                                   float distance) {
+  float length = BeizerArcLength(table);
+  if (distance <= 0.0f || length <= XMATH_EPSILON) {
+    return 0.0f;
+  }
+  if (distance >= length) {
+    return 1.0f;
+  }
+
+  // First span that ends past the distance.
+  unsigned lo = 0;
+  unsigned hi = XMATH_ARC_SPANS - 1;
+  while (lo < hi) {
+    unsigned mid = (lo + hi) / 2;
+    if (table->lengths[mid] < distance) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  float step = 1.0f / (float)XMATH_ARC_SPANS;
+  float t0 = (float)lo * step;
+  float t1 = t0 + step;
+  float start = lo > 0 ? table->lengths[lo - 1] : 0.0f;
+  float span = table->lengths[lo] - start;
+  float t = span > XMATH_EPSILON ? t0 + step * (distance - start) / span : t0;
+
+  // Newton on length(t0, t) - (distance - start), kept inside the span.
+  BeizerArcSpeed s = BeizerArcSpeedMake(&curve);
+  for (unsigned i = 0; i < XMATH_ARC_NEWTON; i++) {
+    float error = BeizerArcIntegrate(&s, t0, t) - (distance - start);
+    float speed = BeizerArcSpeedAt(&s, t);
+    if (fabsf(error) <= XMATH_EPSILON * length || speed <= XMATH_EPSILON) {
+      break;
+    }
+    t = FMin(FMax(t - error / speed, t0), t1);
+  }
+  return t;
+}
@@ -5,6 +5,8 @@
 #ifndef XMATH_CURVES_H
 #define XMATH_CURVES_H
 
+#include <stddef.h>
+#include "api.h"
 #include "vec3.h"
 
 /**
@@ -27,13 +29,28 @@ typedef struct {
   Vec3 s2;
 } HermitCurve;
 
+//! @brief Number of spans of a BeizerArcTable.
+#define XMATH_ARC_SPANS 16
+
+/**
+ * @brief Arc length table of a beizer curve.
+ *
+ * The curve is split in XMATH_ARC_SPANS spans of t, lengths[i] holds the
+ * length of the curve from t = 0 to t = (i + 1) / XMATH_ARC_SPANS, so the
+ * last entry is the length of the whole curve. The table takes 64 bytes and
+ * holds no pointers, it can be stored and copied along its curve.
+ */
+typedef struct {
+  float lengths[XMATH_ARC_SPANS];
+} BeizerArcTable;
+
 /**
  * @brief Interpolates a beizer curve at point t.
  * @param curve any valid beizer curve.
  * @param t point of interpolation.
  * @return the Vec3 after applying lerp on all points and controls.
  */
-Vec3 BeizerInterpolate(BeizerCurve curve, float t);
+XMATH_API Vec3 BeizerInterpolate(BeizerCurve curve, float t);
 
 /**
  * @brief Interpolates a hermit curve at point t.
@@ -41,6 +58,115 @@ Vec3 BeizerInterpolate(BeizerCurve curve, float t);
  * @param t point of interpolation.
  * @return the Vec3 after applying lerp on all points and controls.
  */
-Vec3 HermitInterpolate(HermitCurve curve, float t);
+XMATH_API Vec3 HermitInterpolate(HermitCurve curve, float t);
+
+/**
+ * @brief Coefficients of a beizer curve as a cubic polynomial of t.
+ *
+ * The curve is k[0] t^3 + k[1] t^2 + k[2] t + k[3], which takes three
+ * multiply adds to evaluate (Horner) and is the form used by the spline and
+ * tessellation functions.
+ * @param k destination of the four coefficients.
+ * @param curve any valid beizer curve.
+ */
+XMATH_API void BeizerPowerBasis(Vec3 k[4], BeizerCurve curve);
+
+/**
+ * @brief Coefficients of a hermit curve as a cubic polynomial of t.
+ *
+ * Same form as BeizerPowerBasis.
+ * @param k destination of the four coefficients.
+ * @param curve any valid hermit curve.
+ */
+XMATH_API void HermitPowerBasis(Vec3 k[4], HermitCurve curve);
+
+/**
+ * @brief Interpolates many beizer curves, each at its own point.
+ *
+ * Same as BeizerInterpolate(curves[i], t[i]) into out[i]. The curves are
+ * evaluated four at a time, one per vector lane, so the basis weights are
+ * computed once for the four of them.
+ * @param out destination of count points, must not overlap the inputs.
+ * @param curves list of count curves.
+ * @param t list of count points of interpolation.
+ * @param count number of curves.
+ */
+XMATH_API void BeizerInterpolateArray(Vec3* out,
+                                      const BeizerCurve* curves,
+                                      const float* t,
+                                      size_t count);
+
+/**
+ * @brief Interpolates many hermit curves, each at its own point.
+ *
+ * Same as HermitInterpolate(curves[i], t[i]) into out[i], four curves at a
+ * time like BeizerInterpolateArray.
+ * @param out destination of count points, must not overlap the inputs.
+ * @param curves list of count curves.
+ * @param t list of count points of interpolation.
+ * @param count number of curves.
+ */
+XMATH_API void HermitInterpolateArray(Vec3* out,
+                                      const HermitCurve* curves,
+                                      const float* t,
+                                      size_t count);
+
+/**
+ * @brief Evaluate a beizer curve at count uniform steps.
+ *
+ * out[i] is the curve at t = i / (count - 1), so the first and last points
+ * are p1 and p2. Each point costs three vector additions (forward
+ * differencing), restarted from an exact point every few dozen steps so the
+ * error stays near 1e-6 of the size of the curve for any count.
+ * @param out destination of count points.
+ * @param curve any valid beizer curve.
+ * @param count number of points, one gives p1 only.
+ */
+XMATH_API void BeizerTessellate(Vec3* out, BeizerCurve curve, size_t count);
+
+/**
+ * @brief Evaluate a hermit curve at count uniform steps.
+ *
+ * Same as BeizerTessellate: out[i] is the curve at t = i / (count - 1).
+ * @param out destination of count points.
+ * @param curve any valid hermit curve.
+ * @param count number of points, one gives p1 only.
+ */
+XMATH_API void HermitTessellate(Vec3* out, HermitCurve curve, size_t count);
+
+/**
+ * @brief Measure the arc length table of a beizer curve.
+ *
+ * Every span is integrated with a five point Gauss-Legendre quadrature.
+ * @param r destination table.
+ * @param curve any valid beizer curve.
+ */
+XMATH_API void BeizerArcTableMake(BeizerArcTable* r, BeizerCurve curve);
+
+/**
+ * @brief Length of the whole curve measured by a table.
+ * @param table table made by BeizerArcTableMake.
+ * @return the length of the curve.
+ */
+XMATH_API float BeizerArcLength(const BeizerArcTable* table);
+
+/**
+ * @brief Find the point t of a curve at a distance from its start.
+ *
+ * The span holding the distance is found by binary search on the table, then
+ * a few Newton steps refine t from a linear guess inside the span. Moving the
+ * distance at a constant rate moves along the curve at a constant speed.
+ * @param table table made by BeizerArcTableMake for curve.
+ * @param curve the measured curve.
+ * @param distance distance along the curve, clamped to [0, length].
+ * @return the point t (between 0 and 1).
+ */
+XMATH_API float BeizerArcParameter(const BeizerArcTable* table,
+                                   BeizerCurve curve,
+                                   float distance);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "curves.c"
+#endif
 
 #endif /* XMATH_CURVES_H */
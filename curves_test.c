@@ -5,8 +5,11 @@
 #include <cmocka.h>
 // clang-format on
 
+#include <math.h>
+
 #include "curves.h"
 #include "common_testing.h"
+#include "scalar.h"
 
 static void test_BeizerInterpolate(void** state) {
   UNUSED(state);
@@ -90,6 +93,201 @@ static void test_HermitInterpolate(void** state) {
   assert_true(Vec3EqualApprox(r, e));
 }
 
+// Not a multiple of the vector width, so the padded block is exercised.
+#define CURVES 11
+
+static void test_BeizerInterpolateArray(void** state) {
+  UNUSED(state);
+  BeizerCurve curves[CURVES];
+  float t[CURVES];
+  Vec3 out[CURVES + 1];
+  for (unsigned i = 0; i < CURVES; i++) {
+    float f = 0.1f * (float)i;
+    curves[i] = (BeizerCurve){
+        .p1 = {-1.0f + f, 0.0f, 0.5f * f},
+        .c1 = {-1.0f, 1.0f - f, 0.0f},
+        .p2 = {1.0f, f * f, -0.5f},
+        .c2 = {1.0f - f, 1.0f, 0.25f},
+    };
+    t[i] = (float)((i * 7) % CURVES) / (float)(CURVES - 1);
+  }
+
+  out[CURVES] = (Vec3){42.0f, 42.0f, 42.0f};
+  for (size_t count = 0; count <= CURVES; count++) {
+    BeizerInterpolateArray(out, curves, t, count);
+    for (size_t i = 0; i < count; i++) {
+      assert_true(Vec3EqualApprox(out[i], BeizerInterpolate(curves[i], t[i])));
+    }
+  }
+  assert_float_equal(out[CURVES].x, 42.0f, XMATH_EPSILON);
+}
+
+static void test_HermitInterpolateArray(void** state) {
+  UNUSED(state);
+  HermitCurve curves[CURVES];
+  float t[CURVES];
+  Vec3 out[CURVES + 1];
+  for (unsigned i = 0; i < CURVES; i++) {
+    float f = 0.1f * (float)i;
+    curves[i] = (HermitCurve){
+        .p1 = {-1.0f + f, 1.0f, 0.0f},
+        .s1 = {0.0f, 1.0f - f, 0.5f},
+        .p2 = {1.0f, -f, 0.25f},
+        .s2 = {1.5f * f, 0.0f, -1.0f},
+    };
+    t[i] = (float)((i * 7) % CURVES) / (float)(CURVES - 1);
+  }
+
+  out[CURVES] = (Vec3){42.0f, 42.0f, 42.0f};
+  for (size_t count = 0; count <= CURVES; count++) {
+    HermitInterpolateArray(out, curves, t, count);
+    for (size_t i = 0; i < count; i++) {
+      assert_true(Vec3EqualApprox(out[i], HermitInterpolate(curves[i], t[i])));
+    }
+  }
+  assert_float_equal(out[CURVES].x, 42.0f, XMATH_EPSILON);
+}
+
+// Counts around the edge cases and a long run to see the drift.
+static const size_t gCounts[] = {0, 1, 2, 3, 17, 1000};
+
+static void test_BeizerTessellate(void** state) {
+  UNUSED(state);
+  Vec3 out[1001];
+  BeizerCurve c = {
+      .p1 = {-1.0f, 0.0f, 0.5f},
+      .c1 = {-1.0f, 1.0f, 0.0f},
+      .p2 = {1.0f, 0.0f, -0.5f},
+      .c2 = {1.0f, 1.0f, 0.25f},
+  };
+
+  for (size_t n = 0; n < sizeof(gCounts) / sizeof(gCounts[0]); n++) {
+    size_t count = gCounts[n];
+    out[count] = (Vec3){42.0f, 42.0f, 42.0f};
+    BeizerTessellate(out, c, count);
+    for (size_t i = 0; i < count; i++) {
+      float t = count > 1 ? (float)i / (float)(count - 1) : 0.0f;
+      Vec3 e = BeizerInterpolate(c, t);
+      assert_float_equal(out[i].x, e.x, 1e-5f);
+      assert_float_equal(out[i].y, e.y, 1e-5f);
+      assert_float_equal(out[i].z, e.z, 1e-5f);
+    }
+
+    // Nothing is written past the last point.
+    assert_float_equal(out[count].x, 42.0f, XMATH_EPSILON);
+  }
+
+  // The ends are exact.
+  BeizerTessellate(out, c, 1000);
+  assert_true(Vec3EqualApprox(out[0], c.p1));
+  assert_true(Vec3EqualApprox(out[999], c.p2));
+}
+
+static void test_HermitTessellate(void** state) {
+  UNUSED(state);
+  Vec3 out[1001];
+  HermitCurve c = {
+      .p1 = {-1.0f, 1.0f, 0.0f},
+      .s1 = {0.0f, 1.0f, 0.5f},
+      .p2 = {1.0f, 0.0f, 0.25f},
+      .s2 = {1.5f, 0.0f, -1.0f},
+  };
+
+  for (size_t n = 0; n < sizeof(gCounts) / sizeof(gCounts[0]); n++) {
+    size_t count = gCounts[n];
+    out[count] = (Vec3){42.0f, 42.0f, 42.0f};
+    HermitTessellate(out, c, count);
+    for (size_t i = 0; i < count; i++) {
+      float t = count > 1 ? (float)i / (float)(count - 1) : 0.0f;
+      Vec3 e = HermitInterpolate(c, t);
+      assert_float_equal(out[i].x, e.x, 1e-5f);
+      assert_float_equal(out[i].y, e.y, 1e-5f);
+      assert_float_equal(out[i].z, e.z, 1e-5f);
+    }
+    assert_float_equal(out[count].x, 42.0f, XMATH_EPSILON);
+  }
+
+  HermitTessellate(out, c, 1000);
+  assert_true(Vec3EqualApprox(out[0], c.p1));
+  assert_true(Vec3EqualApprox(out[999], c.p2));
+}
+
+// Length of the curve between 0 and t along a fine polyline.
+static double PolylineLength(BeizerCurve c, float t) {
+  const unsigned steps = 4096;
+  double length = 0.0;
+  Vec3 prev = c.p1;
+  for (unsigned i = 1; i <= steps; i++) {
+    Vec3 next = BeizerInterpolate(c, t * (float)i / (float)steps);
+    double dx = (double)next.x - (double)prev.x;
+    double dy = (double)next.y - (double)prev.y;
+    double dz = (double)next.z - (double)prev.z;
+    length += sqrt(dx * dx + dy * dy + dz * dz);
+    prev = next;
+  }
+  return length;
+}
+
+static void test_BeizerArcTable(void** state) {
+  UNUSED(state);
+  BeizerArcTable table;
+
+  // Evenly spaced controls on a line move at a constant speed.
+  BeizerCurve line = {
+      .p1 = {-1.0f, 0.0f, 0.0f},
+      .c1 = {-1.0f / 3.0f, 0.0f, 0.0f},
+      .p2 = {1.0f, 0.0f, 0.0f},
+      .c2 = {1.0f / 3.0f, 0.0f, 0.0f},
+  };
+  BeizerArcTableMake(&table, line);
+  assert_float_equal(BeizerArcLength(&table), 2.0f, XMATH_EPSILON);
+  for (unsigned i = 0; i <= 10; i++) {
+    float d = 0.2f * (float)i;
+    assert_float_equal(BeizerArcParameter(&table, line, d), 0.5f * d, 1e-5f);
+  }
+
+  // A curve whose speed changes a lot along the way.
+  BeizerCurve c = {
+      .p1 = {-1.0f, 0.0f, 0.0f},
+      .c1 = {-0.9f, 1.0f, 0.2f},
+      .p2 = {1.0f, 0.0f, -0.5f},
+      .c2 = {0.0f, 1.0f, 0.0f},
+  };
+  BeizerArcTableMake(&table, c);
+  float length = BeizerArcLength(&table);
+  assert_float_equal(length, (float)PolylineLength(c, 1.0f), 1e-5f);
+  for (unsigned i = 0; i < XMATH_ARC_SPANS; i++) {
+    float t = (float)(i + 1) / (float)XMATH_ARC_SPANS;
+    assert_float_equal(table.lengths[i], (float)PolylineLength(c, t), 1e-5f);
+  }
+
+  float prev = 0.0f;
+  for (unsigned i = 1; i < 37; i++) {
+    float d = length * (float)i / 37.0f;
+    float t = BeizerArcParameter(&table, c, d);
+    assert_true(t > prev);
+    assert_float_equal((float)PolylineLength(c, t), d, 1e-5f);
+    prev = t;
+  }
+
+  // Distances out of the curve are clamped.
+  assert_float_equal(BeizerArcParameter(&table, c, -1.0f), 0.0f, 0.0f);
+  assert_float_equal(BeizerArcParameter(&table, c, 0.0f), 0.0f, 0.0f);
+  assert_float_equal(BeizerArcParameter(&table, c, length), 1.0f, 0.0f);
+  assert_float_equal(BeizerArcParameter(&table, c, 9.0f), 1.0f, 0.0f);
+
+  // A curve collapsed into a point has no length.
+  BeizerCurve point = {
+      .p1 = {0.5f, 0.5f, 0.5f},
+      .c1 = {0.5f, 0.5f, 0.5f},
+      .p2 = {0.5f, 0.5f, 0.5f},
+      .c2 = {0.5f, 0.5f, 0.5f},
+  };
+  BeizerArcTableMake(&table, point);
+  assert_float_equal(BeizerArcLength(&table), 0.0f, XMATH_EPSILON);
+  assert_float_equal(BeizerArcParameter(&table, point, 0.5f), 0.0f, 0.0f);
+}
+
 int main() {
   UNUSED_TYPE(jmp_buf);
   UNUSED_TYPE(va_list);
@@ -97,6 +295,11 @@ int main() {
   const struct CMUnitTest tests[] = {
       cmocka_unit_test(test_BeizerInterpolate),
       cmocka_unit_test(test_HermitInterpolate),
+      cmocka_unit_test(test_BeizerInterpolateArray),
+      cmocka_unit_test(test_HermitInterpolateArray),
+      cmocka_unit_test(test_BeizerTessellate),
+      cmocka_unit_test(test_HermitTessellate),
+      cmocka_unit_test(test_BeizerArcTable),
   };
 
   return cmocka_run_group_tests(tests, NULL, NULL);
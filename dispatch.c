@@ -0,0 +1,125 @@
+#include "dispatch.h"
+#include <stdlib.h>
+#include <string.h>
+#include "simd.h"
+
+#if defined(XMATH_DISPATCH)
+#include "dispatch_table.h"
+
+#define DISPATCH_TABLE gXmathDispatchBaseline
+#include "dispatch_kernels.h"
+#undef DISPATCH_TABLE
+
+// Starts as the baseline so the kernels work even before the constructor
+// (e.g. from the constructors of other libraries).
+DispatchTable gXmathDispatch = {
+    .mat4Mul = BatchMat4Mul,
+    .mat4MulVec4Array = BatchMat4MulVec4Array,
+    .mat4MulVec4Strided = BatchMat4MulVec4Strided,
+    .affineVec3 = BatchAffineVec3,
+    .affineVec3SoA = BatchAffineVec3SoA,
+    .quatVec3Pairwise = BatchQuatVec3Pairwise,
+    .skinLinear = BatchSkinLinear,
+    .skinDualQuat = BatchSkinDualQuat,
+    .transformLerpGather = BatchTransformLerpGather,
+    .mat4InvertArray = BatchMat4InvertArray,
+    .beizerArray = BatchBeizerArray,
+    .hermitArray = BatchHermitArray,
+};
+static CpuTier gDispatchTier = CpuTierBaseline;
+#endif
+
+XMATH_API CpuTier CpuTierDetect(void) {
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+  // Also checks that the OS saves the wide registers (XGETBV).
+  __builtin_cpu_init();
+  bool fma = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  if (fma && __builtin_cpu_supports("avx512f")) {
+    return CpuTierAVX512;
+  }
+  if (fma) {
+    return CpuTierAVX2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return CpuTierSSE4;
+  }
+#endif
+  return CpuTierBaseline;
+}
+
+XMATH_API CpuTier CpuTierActive(void) {
+#if defined(XMATH_DISPATCH)
+  return gDispatchTier;
+#elif defined(__AVX512F__) && defined(__AVX2__) && defined(XMATH_SIMD_FMA)
+  return CpuTierAVX512;
+#elif defined(__AVX2__) && defined(XMATH_SIMD_FMA)
+  return CpuTierAVX2;
+#elif defined(XMATH_SIMD_SSE4)
+  return CpuTierSSE4;
+#else
+  return CpuTierBaseline;
+#endif
+}
+
+XMATH_API bool CpuTierForce(CpuTier tier) {
+#if defined(XMATH_DISPATCH)
+  if (tier > CpuTierDetect()) {
+    return false;
+  }
+
+  switch (tier) {
+    case CpuTierBaseline:
+      gXmathDispatch = gXmathDispatchBaseline;
+      break;
+    case CpuTierSSE4:
+      gXmathDispatch = gXmathDispatchSSE4;
+      break;
+    case CpuTierAVX2:
+      gXmathDispatch = gXmathDispatchAVX2;
+      break;
+    case CpuTierAVX512:
+      gXmathDispatch = gXmathDispatchAVX512;
+      break;
+    default:
+      return false;
+  }
+  gDispatchTier = tier;
+  return true;
+#else
+  // Only the tier the code was compiled for is available.
+  return tier == CpuTierActive();
+#endif
+}
+
+XMATH_API const char* CpuTierName(CpuTier tier) {
+  switch (tier) {
+    case CpuTierBaseline:
+      return "baseline";
+    case CpuTierSSE4:
+      return "sse4";
+    case CpuTierAVX2:
+      return "avx2";
+    case CpuTierAVX512:
+      return "avx512";
+    default:
+      return "unknown";
+  }
+}
+
+#if defined(XMATH_DISPATCH)
+// Picks the best tier once, when the library is loaded.
+__attribute__((constructor)) static void DispatchInit(void) {
+  CpuTier tier = CpuTierDetect();
+  const char* name = getenv("XMATH_CPU_TIER");
+  if (name != NULL) {
+    for (CpuTier t = CpuTierBaseline; t < tier; t++) {
+      if (strcmp(name, CpuTierName(t)) == 0) {
+        tier = t;
+        break;
+      }
+    }
+  }
+  CpuTierForce(tier);
+}
+#endif
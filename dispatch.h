@@ -0,0 +1,66 @@
+/**
+ * @file dispatch.h
+ * @brief Runtime selection of the SIMD kernels for the running CPU.
+ *
+ * When the library is built with `XMATH_DISPATCH` (the default for GCC and
+ * Clang on x86-64 with `XMATH_SIMD=AUTO`) the hot kernels are compiled once
+ * per CPU tier and the best tier supported by the running CPU is picked at
+ * load time: Mat4Mul, Mat4MulVec4Array, Mat4MulVec4Strided, Mat4InvertArray,
+ * QuatTransformVec3Strided, TransformPointStrided, TransformVec3Strided,
+ * SkinLinearMat4, SkinLinearAffine34, SkinDualQuat, ClipSample,
+ * BeizerInterpolateArray and HermitInterpolateArray.
+ *
+ * The `XMATH_CPU_TIER` environment variable (`baseline`, `sse4`, `avx2` or
+ * `avx512`) lowers the tier picked at load time, tiers above the detected one
+ * are ignored. CpuTierForce does the same from code.
+ *
+ * Without dispatch (header only mode, other compilers or an explicit
+ * `XMATH_SIMD`) the tier is fixed by the compiler flags.
+ */
+#ifndef XMATH_DISPATCH_H
+#define XMATH_DISPATCH_H
+#include <stdbool.h>
+#include "api.h"
+
+//! @brief Instruction set levels the kernels are compiled for.
+typedef enum {
+  CpuTierBaseline,  //!< What the compiler targets by default (SSE2 on x86-64).
+  CpuTierSSE4,      //!< SSE4.2.
+  CpuTierAVX2,      //!< AVX2 and FMA.
+  CpuTierAVX512,    //!< AVX-512F, AVX2 and FMA.
+} CpuTier;
+
+/**
+ * @brief Best tier supported by the running CPU and operating system.
+ * @return the detected tier, CpuTierBaseline when it can not be detected.
+ */
+XMATH_API CpuTier CpuTierDetect(void);
+
+/**
+ * @brief Tier of the kernels in use.
+ * @return the active tier.
+ */
+XMATH_API CpuTier CpuTierActive(void);
+
+/**
+ * @brief Switch the kernels to another tier, meant for tests and benchmarks.
+ *
+ * Not thread safe: call it while no other thread uses the library.
+ * @param tier tier to use.
+ * @return false (and nothing changes) when the tier is not supported by the
+ * CPU or was not compiled in.
+ */
+XMATH_API bool CpuTierForce(CpuTier tier);
+
+/**
+ * @brief Name of a tier, as accepted by `XMATH_CPU_TIER`.
+ * @param tier tier to name.
+ * @return a static string.
+ */
+XMATH_API const char* CpuTierName(CpuTier tier);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "dispatch.c"
+#endif
+
+#endif /* XMATH_DISPATCH_H */
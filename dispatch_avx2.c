@@ -0,0 +1,3 @@
+// Kernels of CpuTierAVX2, compiled with -mavx2 -mfma.
+#define DISPATCH_TABLE gXmathDispatchAVX2
+#include "dispatch_kernels.h"
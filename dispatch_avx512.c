@@ -0,0 +1,5 @@
+// Kernels of CpuTierAVX512, compiled with -mavx512f -mavx2 -mfma. simd.h has
+// no 512 bit backend, the 256 bit code gets the wider register file and the
+// EVEX encodings only.
+#define DISPATCH_TABLE gXmathDispatchAVX512
+#include "dispatch_kernels.h"
@@ -0,0 +1,30 @@
+/**
+ * @file dispatch_kernels.h
+ * @brief Kernel table of one tier, included once per tier source.
+ *
+ * Define DISPATCH_TABLE to the name of the table before including it, the
+ * batch.h bodies are then compiled with the flags of the including file.
+ * There is no include guard on purpose.
+ */
+#include "dispatch_table.h"
+
+#if !defined(DISPATCH_TABLE)
+#error "DISPATCH_TABLE must name the table to define"
+#endif
+
+// The batch.h bodies are static inline, the table takes their address so
+// every tier source gets its own copy compiled for its instruction set.
+const DispatchTable DISPATCH_TABLE = {
+    .mat4Mul = BatchMat4Mul,
+    .mat4MulVec4Array = BatchMat4MulVec4Array,
+    .mat4MulVec4Strided = BatchMat4MulVec4Strided,
+    .affineVec3 = BatchAffineVec3,
+    .affineVec3SoA = BatchAffineVec3SoA,
+    .quatVec3Pairwise = BatchQuatVec3Pairwise,
+    .skinLinear = BatchSkinLinear,
+    .skinDualQuat = BatchSkinDualQuat,
+    .transformLerpGather = BatchTransformLerpGather,
+    .mat4InvertArray = BatchMat4InvertArray,
+    .beizerArray = BatchBeizerArray,
+    .hermitArray = BatchHermitArray,
+};
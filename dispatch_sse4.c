@@ -0,0 +1,3 @@
+// Kernels of CpuTierSSE4, compiled with -msse4.2.
+#define DISPATCH_TABLE gXmathDispatchSSE4
+#include "dispatch_kernels.h"
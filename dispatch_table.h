@@ -0,0 +1,211 @@
+/**
+ * @file dispatch_table.h
+ * @brief Kernel table behind dispatch.h.
+ *
+ * The Dispatch functions call the kernels of the active tier through
+ * gXmathDispatch when the library is built with `XMATH_DISPATCH`, otherwise
+ * they are the batch.h bodies compiled with the flags of the caller.
+ *
+ * Not part of the stable public API.
+ */
+#ifndef XMATH_DISPATCH_TABLE_H
+#define XMATH_DISPATCH_TABLE_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "batch.h"
+#include "mat4_type.h"
+#include "vec3.h"
+#include "vec4.h"
+
+#if defined(XMATH_DISPATCH)
+//! @brief Kernels of one tier.
+typedef struct {
+  void (*mat4Mul)(Mat4* r, const Mat4* a, const Mat4* b);
+  void (*mat4MulVec4Array)(Vec4* out,
+                           const Mat4* m,
+                           const Vec4* in,
+                           size_t count);
+  void (*mat4MulVec4Strided)(Vec4* out,
+                             size_t outStride,
+                             const Mat4* m,
+                             const Vec4* in,
+                             size_t inStride,
+                             size_t count);
+  void (*affineVec3)(const float rows[12],
+                     void* out,
+                     size_t outStride,
+                     const void* in,
+                     size_t inStride,
+                     size_t count);
+  void (*affineVec3SoA)(const float rows[12],
+                        float* x,
+                        float* y,
+                        float* z,
+                        const void* in,
+                        size_t inStride,
+                        size_t count);
+  void (*quatVec3Pairwise)(Vec3* out,
+                           const float* qs,
+                           const Vec3* vs,
+                           size_t count);
+  void (*skinLinear)(const float* palette,
+                     size_t paletteStride,
+                     const uint16_t* joints,
+                     const float* weights,
+                     const Vec3* positions,
+                     const Vec3* normals,
+                     Vec3* outPositions,
+                     Vec3* outNormals,
+                     size_t count);
+  void (*skinDualQuat)(const float* palette,
+                       const uint16_t* joints,
+                       const float* weights,
+                       const Vec3* positions,
+                       const Vec3* normals,
+                       Vec3* outPositions,
+                       Vec3* outNormals,
+                       size_t count);
+  void (*transformLerpGather)(float* out,
+                              const float* const* a,
+                              const float* const* b,
+                              const float* t,
+                              size_t count);
+  bool (*mat4InvertArray)(Mat4* out,
+                          const Mat4* in,
+                          uint32_t* okMask,
+                          size_t count);
+  void (*beizerArray)(Vec3* out,
+                      const float* curves,
+                      const float* t,
+                      size_t count);
+  void (*hermitArray)(Vec3* out,
+                      const float* curves,
+                      const float* t,
+                      size_t count);
+} DispatchTable;
+
+//! @brief Kernels in use, set at load time and by CpuTierForce.
+extern DispatchTable gXmathDispatch;
+
+// Kernel table of every tier, defined by dispatch_kernels.h.
+extern const DispatchTable gXmathDispatchBaseline;
+extern const DispatchTable gXmathDispatchSSE4;
+extern const DispatchTable gXmathDispatchAVX2;
+extern const DispatchTable gXmathDispatchAVX512;
+
+static inline void DispatchMat4Mul(Mat4* r, const Mat4* a, const Mat4* b) {
+  gXmathDispatch.mat4Mul(r, a, b);
+}
+
+static inline void DispatchMat4MulVec4Array(Vec4* out,
+                                            const Mat4* m,
+                                            const Vec4* in,
+                                            size_t count) {
+  gXmathDispatch.mat4MulVec4Array(out, m, in, count);
+}
+
+static inline void DispatchMat4MulVec4Strided(Vec4* out,
+                                              size_t outStride,
+                                              const Mat4* m,
+                                              const Vec4* in,
+                                              size_t inStride,
+                                              size_t count) {
+  gXmathDispatch.mat4MulVec4Strided(out, outStride, m, in, inStride, count);
+}
+
+static inline void DispatchAffineVec3(const float rows[12],
+                                      void* out,
+                                      size_t outStride,
+                                      const void* in,
+                                      size_t inStride,
+                                      size_t count) {
+  gXmathDispatch.affineVec3(rows, out, outStride, in, inStride, count);
+}
+
+static inline void DispatchAffineVec3SoA(const float rows[12],
+                                         float* x,
+                                         float* y,
+                                         float* z,
+                                         const void* in,
+                                         size_t inStride,
+                                         size_t count) {
+  gXmathDispatch.affineVec3SoA(rows, x, y, z, in, inStride, count);
+}
+
+static inline void DispatchQuatVec3Pairwise(Vec3* out,
+                                            const float* qs,
+                                            const Vec3* vs,
+                                            size_t count) {
+  gXmathDispatch.quatVec3Pairwise(out, qs, vs, count);
+}
+
+static inline void DispatchSkinLinear(const float* palette,
+                                      size_t paletteStride,
+                                      const uint16_t* joints,
+                                      const float* weights,
+                                      const Vec3* positions,
+                                      const Vec3* normals,
+                                      Vec3* outPositions,
+                                      Vec3* outNormals,
+                                      size_t count) {
+  gXmathDispatch.skinLinear(palette, paletteStride, joints, weights, positions,
+                            normals, outPositions, outNormals, count);
+}
+
+static inline void DispatchSkinDualQuat(const float* palette,
+                                        const uint16_t* joints,
+                                        const float* weights,
+                                        const Vec3* positions,
+                                        const Vec3* normals,
+                                        Vec3* outPositions,
+                                        Vec3* outNormals,
+                                        size_t count) {
+  gXmathDispatch.skinDualQuat(palette, joints, weights, positions, normals,
+                              outPositions, outNormals, count);
+}
+
+static inline void DispatchTransformLerpGather(float* out,
+                                               const float* const* a,
+                                               const float* const* b,
+                                               const float* t,
+                                               size_t count) {
+  gXmathDispatch.transformLerpGather(out, a, b, t, count);
+}
+
+static inline bool DispatchMat4InvertArray(Mat4* out,
+                                           const Mat4* in,
+                                           uint32_t* okMask,
+                                           size_t count) {
+  return gXmathDispatch.mat4InvertArray(out, in, okMask, count);
+}
+
+static inline void DispatchBeizerArray(Vec3* out,
+                                       const float* curves,
+                                       const float* t,
+                                       size_t count) {
+  gXmathDispatch.beizerArray(out, curves, t, count);
+}
+
+static inline void DispatchHermitArray(Vec3* out,
+                                       const float* curves,
+                                       const float* t,
+                                       size_t count) {
+  gXmathDispatch.hermitArray(out, curves, t, count);
+}
+#else
+#define DispatchMat4Mul BatchMat4Mul
+#define DispatchMat4MulVec4Array BatchMat4MulVec4Array
+#define DispatchMat4MulVec4Strided BatchMat4MulVec4Strided
+#define DispatchAffineVec3 BatchAffineVec3
+#define DispatchAffineVec3SoA BatchAffineVec3SoA
+#define DispatchQuatVec3Pairwise BatchQuatVec3Pairwise
+#define DispatchSkinLinear BatchSkinLinear
+#define DispatchSkinDualQuat BatchSkinDualQuat
+#define DispatchTransformLerpGather BatchTransformLerpGather
+#define DispatchMat4InvertArray BatchMat4InvertArray
+#define DispatchBeizerArray BatchBeizerArray
+#define DispatchHermitArray BatchHermitArray
+#endif
+
+#endif /* XMATH_DISPATCH_TABLE_H */
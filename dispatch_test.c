@@ -0,0 +1,196 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+#include <string.h>
+// clang-format on
+
+#include "dispatch.h"
+#include "common_testing.h"
+#include "curves.h"
+#include "mat4.h"
+#include "quat.h"
+#include "scalar.h"
+#include "skinning.h"
+#include "transform.h"
+#include "vec3soa.h"
+
+#define COUNT 7
+
+static void test_CpuTierName(void** state) {
+  UNUSED(state);
+
+  assert_true(strcmp(CpuTierName(CpuTierBaseline), "baseline") == 0);
+  assert_true(strcmp(CpuTierName(CpuTierSSE4), "sse4") == 0);
+  assert_true(strcmp(CpuTierName(CpuTierAVX2), "avx2") == 0);
+  assert_true(strcmp(CpuTierName(CpuTierAVX512), "avx512") == 0);
+}
+
+static void test_CpuTierForce(void** state) {
+  UNUSED(state);
+
+  CpuTier active = CpuTierActive();
+  assert_true(active <= CpuTierDetect());
+  assert_true(CpuTierForce(active));
+  assert_int_equal(CpuTierActive(), active);
+}
+
+// Every available tier must give the results of the active one.
+static void test_CpuTierKernels(void** state) {
+  UNUSED(state);
+
+  CpuTier active = CpuTierActive();
+  Mat4 a = {0.5f, 0.1f, -0.2f, 0.3f, 0.0f,  0.9f, 0.4f, -0.1f,
+            0.2f, 0.3f, 0.7f,  0.5f, -0.4f, 0.1f, 0.2f, 1.0f};
+  Mat4 b = Mat4Transpose(a);
+  Transform t = {.position = {0.1f, -0.2f, 0.3f},
+                 .rotation = QuatMakeAngleAxis(0.7f, Vec3Norm((Vec3){1, 2, 3})),
+                 .scale = {0.5f, 0.25f, 0.75f}};
+  Vec4 in4[COUNT];
+  Vec3 in3[COUNT];
+  for (unsigned i = 0; i < COUNT; i++) {
+    float f = 0.1f * (float)i;
+    in4[i] = (Vec4){f, 1.0f - f, 0.5f * f, 1.0f};
+    in3[i] = (Vec3){-f, 0.25f, f * f};
+  }
+
+  Mat4 ab = Mat4Mul(a, b);
+  Mat4 inv[COUNT];
+  Mat4 mats[COUNT];
+  for (unsigned i = 0; i < COUNT; i++) {
+    mats[i] = Mat4Add(Mat4Identity, Mat4Scale(a, 0.1f * (float)i));
+  }
+  Mat4InvertArray(inv, mats, NULL, COUNT);
+  Vec4 out4[COUNT];
+  Vec3 out3[COUNT];
+  Vec3 rot3[COUNT];
+  Mat4MulVec4Array(out4, &a, in4, COUNT);
+  TransformPointStrided(out3, sizeof(Vec3), &t, in3, sizeof(Vec3), COUNT);
+  QuatTransformVec3Strided(rot3, sizeof(Vec3), t.rotation, in3, sizeof(Vec3),
+                           COUNT);
+  Quat qs[COUNT];
+  Vec3 pair3[COUNT];
+  for (unsigned i = 0; i < COUNT; i++) {
+    qs[i] = QuatMakeAngleAxis(0.3f * (float)i, Vec3Norm((Vec3){1, -1, 2}));
+  }
+  QuatTransformVec3Pairwise(pair3, qs, in3, COUNT);
+  Mat4 palette[2] = {a, b};
+  uint16_t joints[4 * COUNT];
+  float weights[4 * COUNT];
+  for (unsigned i = 0; i < 4 * COUNT; i++) {
+    joints[i] = (uint16_t)(i % 3 == 0);
+    weights[i] = 0.1f * (float)(i % 5);
+  }
+  Vec3 skin3[COUNT];
+  Vec3 skinNormals[COUNT];
+  SkinMesh mesh = {in3, rot3, joints, weights, skin3, skinNormals, COUNT};
+  SkinLinearMat4(&mesh, palette, 0, COUNT);
+  DualQuat bones[2] = {TransformToDualQuat(t), DualQuatIdentity};
+  Vec3 dq3[COUNT];
+  Vec3 dqNormals[COUNT];
+  SkinMesh dqMesh = {in3, rot3, joints, weights, dq3, dqNormals, COUNT};
+  SkinDualQuat(&dqMesh, bones, 0, COUNT);
+  BeizerCurve beizers[COUNT];
+  HermitCurve hermits[COUNT];
+  float ts[COUNT];
+  for (unsigned i = 0; i < COUNT; i++) {
+    beizers[i] = (BeizerCurve){in3[i], rot3[i], out3[i], pair3[i]};
+    hermits[i] = (HermitCurve){pair3[i], in3[i], rot3[i], out3[i]};
+    ts[i] = 0.15f * (float)i;
+  }
+  Vec3 beizer3[COUNT];
+  Vec3 hermit3[COUNT];
+  BeizerInterpolateArray(beizer3, beizers, ts, COUNT);
+  HermitInterpolateArray(hermit3, hermits, ts, COUNT);
+  Vec3SoA soa;
+  assert_true(Vec3SoAMake(&soa, COUNT));
+
+  for (CpuTier tier = CpuTierBaseline; tier <= CpuTierAVX512; tier++) {
+    if (!CpuTierForce(tier)) {
+      continue;
+    }
+
+    assert_true(Mat4EqualApprox(Mat4Mul(a, b), ab));
+
+    Mat4 m[COUNT];
+    assert_true(Mat4InvertArray(m, mats, NULL, COUNT));
+    for (unsigned i = 0; i < COUNT; i++) {
+      assert_true(Mat4EqualApprox(m[i], inv[i]));
+    }
+
+    Vec4 o4[COUNT];
+    Vec3 o3[COUNT];
+    Mat4MulVec4Array(o4, &a, in4, COUNT);
+    for (unsigned i = 0; i < COUNT; i++) {
+      assert_true(Vec4EqualApprox(o4[i], out4[i]));
+    }
+
+    Mat4MulVec4Strided(o4, sizeof(Vec4), &a, in4, sizeof(Vec4), COUNT);
+    for (unsigned i = 0; i < COUNT; i++) {
+      assert_true(Vec4EqualApprox(o4[i], out4[i]));
+    }
+
+    TransformPointStrided(o3, sizeof(Vec3), &t, in3, sizeof(Vec3), COUNT);
+    for (unsigned i = 0; i < COUNT; i++) {
+      assert_true(Vec3EqualApprox(o3[i], out3[i]));
+    }
+
+    QuatTransformVec3Strided(o3, sizeof(Vec3), t.rotation, in3, sizeof(Vec3),
+                             COUNT);
+    for (unsigned i = 0; i < COUNT; i++) {
+      assert_true(Vec3EqualApprox(o3[i], rot3[i]));
+    }
+
+    QuatTransformVec3Pairwise(o3, qs, in3, COUNT);
+    for (unsigned i = 0; i < COUNT; i++) {
+      assert_true(Vec3EqualApprox(o3[i], pair3[i]));
+    }
+
+    Vec3 n3[COUNT];
+    SkinMesh tierMesh = {in3, rot3, joints, weights, o3, n3, COUNT};
+    SkinLinearMat4(&tierMesh, palette, 0, COUNT);
+    for (unsigned i = 0; i < COUNT; i++) {
+      assert_true(Vec3EqualApprox(o3[i], skin3[i]));
+      assert_true(Vec3EqualApprox(n3[i], skinNormals[i]));
+    }
+
+    SkinDualQuat(&tierMesh, bones, 0, COUNT);
+    for (unsigned i = 0; i < COUNT; i++) {
+      assert_true(Vec3EqualApprox(o3[i], dq3[i]));
+      assert_true(Vec3EqualApprox(n3[i], dqNormals[i]));
+    }
+
+    BeizerInterpolateArray(o3, beizers, ts, COUNT);
+    for (unsigned i = 0; i < COUNT; i++) {
+      assert_true(Vec3EqualApprox(o3[i], beizer3[i]));
+    }
+
+    HermitInterpolateArray(o3, hermits, ts, COUNT);
+    for (unsigned i = 0; i < COUNT; i++) {
+      assert_true(Vec3EqualApprox(o3[i], hermit3[i]));
+    }
+
+    TransformPointArrayToSoA(&soa, &t, in3, COUNT);
+    Vec3SoAToArray(o3, &soa);
+    for (unsigned i = 0; i < COUNT; i++) {
+      assert_true(Vec3EqualApprox(o3[i], out3[i]));
+    }
+  }
+
+  Vec3SoAFree(&soa);
+  assert_true(CpuTierForce(active));
+}
+
+int main() {
+  UNUSED_TYPE(jmp_buf);
+  UNUSED_TYPE(va_list);
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_CpuTierName),
+      cmocka_unit_test(test_CpuTierForce),
+      cmocka_unit_test(test_CpuTierKernels),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,77 @@
+#include "dualquat.h"
+#include <assert.h>
+#include "scalar.h"
+
+XMATH_API bool DualQuatEqualApprox(DualQuat a, DualQuat b) {
+  return QuatEqualApprox(a.real, b.real) && QuatEqualApprox(a.dual, b.dual);
+}
+
+XMATH_API DualQuat DualQuatMake(Quat rotation, Vec3 translation) {
+  Quat t = {translation.x, translation.y, translation.z, 0.0f};
+  return (DualQuat){rotation, QuatScale(QuatCross(t, rotation), 0.5f)};
+}
+
+XMATH_API DualQuat TransformToDualQuat(Transform t) {
+  return DualQuatMake(t.rotation, t.position);
+}
+
+XMATH_API Transform DualQuatToTransform(DualQuat dq) {
+  return (Transform){
+      .position = DualQuatGetTranslation(dq),
+      .rotation = dq.real,
+      .scale = Vec3One,
+  };
+}
+
+XMATH_API Vec3 DualQuatGetTranslation(DualQuat dq) {
+  // t = 2 * dual * conjugate(real), expanded to its imaginary part.
+  Vec3 r = QuatGetImgPart(dq.real);
+  Vec3 d = QuatGetImgPart(dq.dual);
+  Vec3 t = Vec3Scale(d, dq.real.w);
+  t = Vec3Sub(t, Vec3Scale(r, dq.dual.w));
+  t = Vec3Add(t, Vec3Cross(r, d));
+  return Vec3Scale(t, 2.0f);
+}
+
+XMATH_API DualQuat DualQuatMul(DualQuat a, DualQuat b) {
+  Quat dual = QuatAdd(QuatCross(a.real, b.dual), QuatCross(a.dual, b.real));
+  return (DualQuat){QuatCross(a.real, b.real), dual};
+}
+
+XMATH_API DualQuat DualQuatNorm(DualQuat dq) {
+  float len = QuatLen(dq.real);
+  if (len < XMATH_EPSILON) {
+    return dq;
+  }
+
+  float k = 1.0f / len;
+  Quat real = QuatScale(dq.real, k);
+  Quat dual = QuatScale(dq.dual, k);
+  dual = QuatSub(dual, QuatScale(real, QuatDot(real, dual)));
+  return (DualQuat){real, dual};
+}
+
+XMATH_API DualQuat DualQuatBlend(const DualQuat* dqs,
+                                 const float* weights,
+                                 size_t count) {
+  assert(count > 0);
+
+  DualQuat r = {QuatZero, QuatZero};
+  for (size_t i = 0; i < count; i++) {
+    float w = weights[i];
+    if (QuatDot(dqs[0].real, dqs[i].real) < 0.0f) {
+      w = -w;
+    }
+    r.real = QuatAdd(r.real, QuatScale(dqs[i].real, w));
+    r.dual = QuatAdd(r.dual, QuatScale(dqs[i].dual, w));
+  }
+  return DualQuatNorm(r);
+}
+
+XMATH_API Vec3 DualQuatTransformPoint(DualQuat dq, Vec3 p) {
+  return Vec3Add(QuatTransformVec3(dq.real, p), DualQuatGetTranslation(dq));
+}
+
+XMATH_API Vec3 DualQuatTransformVec3(DualQuat dq, Vec3 v) {
+  return QuatTransformVec3(dq.real, v);
+}
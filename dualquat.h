@@ -0,0 +1,130 @@
+/**
+ * @file dualquat.h
+ * @brief Dual quaternions for rigid transforms.
+ *
+ * A unit dual quaternion real + e dual holds the rotation real and the
+ * translation t as dual = 0.5 * t * real, with t taken as a pure quaternion.
+ * It maps a point like TransformPoint with a scale of one, in 8 floats
+ * instead of the 16 of a Mat4. Blending dual quaternions keeps the result
+ * rigid, so skinning with them does not collapse twisted joints the way
+ * blended matrices do.
+ */
+#ifndef XMATH_DUALQUAT_H
+#define XMATH_DUALQUAT_H
+#include <stdbool.h>
+#include <stddef.h>
+#include "api.h"
+#include "quat.h"
+#include "transform.h"
+#include "vec3.h"
+
+/**
+ * @brief Dual quaternion, real and dual parts as x, y, z and w.
+ */
+typedef struct {
+  Quat real;
+  Quat dual;
+} DualQuat;
+
+//! @brief a DualQuat that maps every point to itself.
+static const DualQuat DualQuatIdentity = {
+    {0.0f, 0.0f, 0.0f, 1.0f},
+    {0.0f, 0.0f, 0.0f, 0.0f},
+};
+
+/**
+ * @brief Compare two dual quaternions.
+ * @param a first dual quaternion.
+ * @param b second dual quaternion.
+ * @return true if both parts are approximately equal.
+ */
+XMATH_API bool DualQuatEqualApprox(DualQuat a, DualQuat b);
+
+/**
+ * @brief Make a dual quaternion that rotates and then translates.
+ * @param rotation unit quaternion.
+ * @param translation applied after the rotation.
+ * @return the rigid transform as a unit dual quaternion.
+ */
+XMATH_API DualQuat DualQuatMake(Quat rotation, Vec3 translation);
+
+/**
+ * @brief Convert from a Transform into a DualQuat.
+ *
+ * Dual quaternions only hold rigid transforms, the scale of t is dropped.
+ * @param t transform to convert (unaffected).
+ * @return the rotation and position of t.
+ */
+XMATH_API DualQuat TransformToDualQuat(Transform t);
+
+/**
+ * @brief Convert from a unit DualQuat into a Transform.
+ * @param dq unit dual quaternion (unaffected).
+ * @return transform with the same map and a scale of one.
+ */
+XMATH_API Transform DualQuatToTransform(DualQuat dq);
+
+/**
+ * @brief Get the translation of a unit dual quaternion.
+ * @param dq unit dual quaternion (unaffected).
+ * @return the translation applied after the rotation.
+ */
+XMATH_API Vec3 DualQuatGetTranslation(DualQuat dq);
+
+/**
+ * @brief Multiply two dual quaternions.
+ *
+ * As with QuatCross the product maps by b first and then by a.
+ * @param a any dual quaternion (unaffected).
+ * @param b any dual quaternion (unaffected).
+ * @return product of a by b.
+ */
+XMATH_API DualQuat DualQuatMul(DualQuat a, DualQuat b);
+
+/**
+ * @brief Normalize a dual quaternion.
+ *
+ * Both parts are divided by the length of the real part and the dual part is
+ * made orthogonal to the real one. Real parts shorter than XMATH_EPSILON are
+ * returned as is, like QuatNorm.
+ * @param dq dual quaternion (unaffected).
+ * @return unit dual quaternion.
+ */
+XMATH_API DualQuat DualQuatNorm(DualQuat dq);
+
+/**
+ * @brief Weighted blend of dual quaternions.
+ *
+ * Each dual quaternion is negated when its real part is in the opposite
+ * hemisphere of the first one, so the blend takes the short way, and the sum
+ * is normalized.
+ * @param dqs count unit dual quaternions.
+ * @param weights count weights, usually adding up to one.
+ * @param count number of dual quaternions, at least one.
+ * @return the normalized blend.
+ */
+XMATH_API DualQuat DualQuatBlend(const DualQuat* dqs,
+                                 const float* weights,
+                                 size_t count);
+
+/**
+ * @brief Transform a point using a unit dual quaternion.
+ * @param dq unit dual quaternion (unaffected).
+ * @param p point to rotate and translate.
+ * @return p rotated and then translated by dq.
+ */
+XMATH_API Vec3 DualQuatTransformPoint(DualQuat dq, Vec3 p);
+
+/**
+ * @brief Transform a direction using a unit dual quaternion.
+ * @param dq unit dual quaternion (unaffected).
+ * @param v direction, only rotated.
+ * @return v rotated by dq.
+ */
+XMATH_API Vec3 DualQuatTransformVec3(DualQuat dq, Vec3 v);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "dualquat.c"
+#endif
+
+#endif /* XMATH_DUALQUAT_H */
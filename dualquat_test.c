@@ -0,0 +1,126 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "dualquat.h"
+#include "common_testing.h"
+#include "scalar.h"
+
+static const Vec3 gPoint = {0.3f, -1.2f, 0.7f};
+
+static Transform SampleTransform(float f) {
+  return (Transform){
+      .position = {1.0f + f, -0.5f, 2.0f * f},
+      .rotation = QuatMakeAngleAxis(0.8f + f, Vec3Norm((Vec3){1, 2, -f})),
+      .scale = Vec3One,
+  };
+}
+
+static void test_DualQuatMake(void** state) {
+  UNUSED(state);
+
+  Transform t = SampleTransform(0.5f);
+  DualQuat dq = TransformToDualQuat(t);
+  assert_true(DualQuatEqualApprox(dq, DualQuatMake(t.rotation, t.position)));
+  assert_true(QuatEqualApprox(dq.real, t.rotation));
+  assert_float_equal(QuatDot(dq.real, dq.dual), 0.0f, XMATH_EPSILON);
+  assert_true(Vec3EqualApprox(DualQuatGetTranslation(dq), t.position));
+  assert_true(TransformEqualApprox(DualQuatToTransform(dq), t));
+
+  assert_true(Vec3EqualApprox(DualQuatTransformPoint(dq, gPoint),
+                              TransformPoint(t, gPoint)));
+  assert_true(Vec3EqualApprox(DualQuatTransformVec3(dq, gPoint),
+                              QuatTransformVec3(t.rotation, gPoint)));
+  assert_true(Vec3EqualApprox(
+      DualQuatTransformPoint(DualQuatIdentity, gPoint), gPoint));
+
+  // The scale is dropped.
+  t.scale = (Vec3){2.0f, 3.0f, 4.0f};
+  assert_true(DualQuatEqualApprox(TransformToDualQuat(t), dq));
+}
+
+static void test_DualQuatMul(void** state) {
+  UNUSED(state);
+
+  DualQuat a = TransformToDualQuat(SampleTransform(0.2f));
+  DualQuat b = TransformToDualQuat(SampleTransform(-0.7f));
+  DualQuat ab = DualQuatMul(a, b);
+  Vec3 expected = DualQuatTransformPoint(a, DualQuatTransformPoint(b, gPoint));
+  assert_true(Vec3EqualApprox(DualQuatTransformPoint(ab, gPoint), expected));
+  assert_float_equal(QuatLen(ab.real), 1.0f, XMATH_EPSILON);
+  assert_true(DualQuatEqualApprox(DualQuatMul(a, DualQuatIdentity), a));
+  assert_true(DualQuatEqualApprox(DualQuatMul(DualQuatIdentity, a), a));
+}
+
+static void test_DualQuatNorm(void** state) {
+  UNUSED(state);
+
+  DualQuat dq = TransformToDualQuat(SampleTransform(0.4f));
+  DualQuat scaled = {QuatScale(dq.real, 3.0f), QuatScale(dq.dual, 3.0f)};
+  assert_true(DualQuatEqualApprox(DualQuatNorm(scaled), dq));
+
+  // The dual part is made orthogonal to the real one.
+  DualQuat skewed = {dq.real, QuatAdd(dq.dual, QuatScale(dq.real, 0.25f))};
+  DualQuat r = DualQuatNorm(skewed);
+  assert_float_equal(QuatDot(r.real, r.dual), 0.0f, XMATH_EPSILON);
+  assert_true(DualQuatEqualApprox(r, dq));
+
+  DualQuat zero = {QuatZero, {1.0f, 2.0f, 3.0f, 4.0f}};
+  assert_true(DualQuatEqualApprox(DualQuatNorm(zero), zero));
+}
+
+static void test_DualQuatBlend(void** state) {
+  UNUSED(state);
+
+  DualQuat dqs[3] = {
+      TransformToDualQuat(SampleTransform(0.1f)),
+      TransformToDualQuat(SampleTransform(0.9f)),
+      DualQuatIdentity,
+  };
+  float one[3] = {0.0f, 1.0f, 0.0f};
+  assert_true(DualQuatEqualApprox(DualQuatBlend(dqs, one, 3), dqs[1]));
+
+  // A negated dual quaternion is the same transform and blends as such.
+  DualQuat same[2] = {dqs[0], {QuatNeg(dqs[0].real), QuatNeg(dqs[0].dual)}};
+  float half[2] = {0.5f, 0.5f};
+  assert_true(DualQuatEqualApprox(DualQuatBlend(same, half, 2), dqs[0]));
+
+  // Translations alone blend linearly.
+  DualQuat moves[2] = {
+      DualQuatMake(QuatIdentity, (Vec3){2.0f, 0.0f, 0.0f}),
+      DualQuatMake(QuatIdentity, (Vec3){0.0f, 4.0f, -2.0f}),
+  };
+  float w[2] = {0.25f, 0.75f};
+  DualQuat m = DualQuatBlend(moves, w, 2);
+  assert_true(Vec3EqualApprox(DualQuatGetTranslation(m),
+                              (Vec3){0.5f, 3.0f, -1.5f}));
+
+  // Rotations about the origin blend like QuatNLerp and stay rigid.
+  Vec3 axis = Vec3Norm((Vec3){0, 1, 1});
+  DualQuat turns[2] = {
+      DualQuatMake(QuatMakeAngleAxis(0.2f, axis), Vec3Zero),
+      DualQuatMake(QuatMakeAngleAxis(1.4f, axis), Vec3Zero),
+  };
+  DualQuat r = DualQuatBlend(turns, half, 2);
+  assert_true(QuatEqualApprox(r.real, QuatMakeAngleAxis(0.8f, axis)));
+  assert_float_equal(Vec3Len(DualQuatTransformPoint(r, gPoint)),
+                     Vec3Len(gPoint), XMATH_EPSILON);
+}
+
+int main() {
+  UNUSED_TYPE(jmp_buf);
+  UNUSED_TYPE(va_list);
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_DualQuatMake),
+      cmocka_unit_test(test_DualQuatMul),
+      cmocka_unit_test(test_DualQuatNorm),
+      cmocka_unit_test(test_DualQuatBlend),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
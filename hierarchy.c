@@ -0,0 +1,221 @@
+#include "hierarchy.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "batch.h"
+#include "dispatch_table.h"
+
+XMATH_API bool HierarchyMake(Hierarchy* h, size_t capacity) {
+  assert(h != NULL);
+  assert(capacity < XMATH_HIERARCHY_NONE);
+
+  // One block holds every array, ordered by decreasing alignment.
+  size_t size = capacity * (sizeof(Mat4) + 2 * sizeof(Transform) +
+                            4 * sizeof(uint32_t) + sizeof(uint8_t)) +
+                sizeof(uint32_t);
+  char* block = malloc(size > 0 ? size : 1);
+  if (block == NULL) {
+    *h = (Hierarchy){0};
+    return false;
+  }
+
+  h->worldMatrix = (Mat4*)block;
+  h->local = (Transform*)(h->worldMatrix + capacity);
+  h->world = h->local + capacity;
+  h->parent = (uint32_t*)(h->world + capacity);
+  h->depth = h->parent + capacity;
+  h->order = h->depth + capacity;
+  h->levels = h->order + capacity;
+  h->dirty = (uint8_t*)(h->levels + capacity + 1);
+  h->count = 0;
+  h->capacity = capacity;
+  h->firstDirty = 0;
+  h->levelCount = 0;
+  h->orderCount = 0;
+  return true;
+}
+
+XMATH_API void HierarchyFree(Hierarchy* h) {
+  assert(h != NULL);
+  free(h->worldMatrix);
+  *h = (Hierarchy){0};
+}
+
+XMATH_API uint32_t HierarchyAdd(Hierarchy* h,
+                                uint32_t parent,
+                                Transform local) {
+  assert(h != NULL);
+  assert(parent == XMATH_HIERARCHY_NONE || parent < h->count);
+  if (h->count == h->capacity) {
+    return XMATH_HIERARCHY_NONE;
+  }
+
+  uint32_t node = (uint32_t)h->count++;
+  h->local[node] = local;
+  h->parent[node] = parent;
+  h->depth[node] = parent == XMATH_HIERARCHY_NONE ? 0 : h->depth[parent] + 1;
+  h->dirty[node] = 1;
+  if (node < h->firstDirty) {
+    h->firstDirty = node;
+  }
+  return node;
+}
+
+XMATH_API void HierarchySetLocal(Hierarchy* h,
+                                 uint32_t node,
+                                 Transform local) {
+  assert(h != NULL && node < h->count);
+  h->local[node] = local;
+  HierarchyMarkDirty(h, node);
+}
+
+XMATH_API void HierarchyMarkDirty(Hierarchy* h, uint32_t node) {
+  assert(h != NULL && node < h->count);
+  h->dirty[node] = 1;
+  if (node < h->firstDirty) {
+    h->firstDirty = node;
+  }
+}
+
+// Same as TransformToMat4.
+static inline void HierarchyLocalMatrix(Mat4* out, const Transform* t) {
+  float r[12];
+  BatchAffineRows(r, &t->rotation.x, t->scale, t->position);
+  // clang-format off
+  *out = (Mat4){
+    r[0], r[4], r[8],  0.0f,
+    r[1], r[5], r[9],  0.0f,
+    r[2], r[6], r[10], 0.0f,
+    r[3], r[7], r[11], 1.0f,
+  };
+  // clang-format on
+}
+
+static inline void HierarchyUpdateNode(Hierarchy* h, size_t i) {
+  const Transform* l = &h->local[i];
+  uint32_t p = h->parent[i];
+  if (p == XMATH_HIERARCHY_NONE) {
+    h->world[i] = *l;
+    HierarchyLocalMatrix(&h->worldMatrix[i], l);
+    return;
+  }
+
+  Mat4 m;
+  Mat4* w = &h->worldMatrix[i];
+  HierarchyLocalMatrix(&m, l);
+  DispatchMat4Mul(w, &m, &h->worldMatrix[p]);
+
+  // Like TransformCombine with the scales multiplied component by component,
+  // the position is the translation row of the world matrix.
+  const Transform* pw = &h->world[p];
+  h->world[i] = (Transform){
+      .position = {w->wx, w->wy, w->wz},
+      .rotation = QuatCross(pw->rotation, l->rotation),
+      .scale = Vec3InnerMul(pw->scale, l->scale),
+  };
+}
+
+// Recompute node i when it was marked or its parent was recomputed in the
+// same update, the parent is always visited first.
+static inline void HierarchyVisit(Hierarchy* h, size_t i) {
+  if (!h->dirty[i]) {
+    uint32_t p = h->parent[i];
+    if (p == XMATH_HIERARCHY_NONE || !h->dirty[p]) {
+      return;
+    }
+    h->dirty[i] = 1;
+  }
+  HierarchyUpdateNode(h, i);
+}
+
+static inline void HierarchyClean(Hierarchy* h) {
+  if (h->firstDirty < h->count) {
+    memset(h->dirty + h->firstDirty, 0, h->count - h->firstDirty);
+  }
+  h->firstDirty = h->count;
+}
+
+XMATH_API void HierarchyUpdate(Hierarchy* h) {
+  assert(h != NULL);
+
+  // Parents come first and nodes before firstDirty are all clean.
+  for (size_t i = h->firstDirty; i < h->count; i++) {
+    HierarchyVisit(h, i);
+  }
+  HierarchyClean(h);
+}
+
+// Counting sort of the nodes by depth, stable so each level stays sorted by
+// index.
+static void HierarchySortLevels(Hierarchy* h) {
+  size_t levelCount = 0;
+  for (size_t i = 0; i < h->count; i++) {
+    if (h->depth[i] + 1 > levelCount) {
+      levelCount = h->depth[i] + 1;
+    }
+  }
+
+  uint32_t* levels = h->levels;
+  memset(levels, 0, (levelCount + 1) * sizeof(uint32_t));
+  for (size_t i = 0; i < h->count; i++) {
+    levels[h->depth[i] + 1]++;
+  }
+  for (size_t d = 0; d < levelCount; d++) {
+    levels[d + 1] += levels[d];
+  }
+
+  // levels[d] is used as the insertion point of depth d, then shifted back.
+  for (size_t i = 0; i < h->count; i++) {
+    h->order[levels[h->depth[i]]++] = (uint32_t)i;
+  }
+  for (size_t d = levelCount; d > 0; d--) {
+    levels[d] = levels[d - 1];
+  }
+  levels[0] = 0;
+
+  h->levelCount = levelCount;
+  h->orderCount = h->count;
+}
+
+typedef struct {
+  Hierarchy* h;
+  const uint32_t* nodes;
+} HierarchyLevel;
+
+static void HierarchyLevelTask(void* user, size_t first, size_t count) {
+  HierarchyLevel* level = user;
+  for (size_t k = first; k < first + count; k++) {
+    HierarchyVisit(level->h, level->nodes[k]);
+  }
+}
+
+XMATH_API void HierarchyUpdateParallel(Hierarchy* h, ThreadPool* pool) {
+  assert(h != NULL);
+  if (h->firstDirty == h->count) {
+    return;
+  }
+  if (h->orderCount != h->count) {
+    HierarchySortLevels(h);
+  }
+
+  for (size_t d = 0; d < h->levelCount; d++) {
+    // Nodes before firstDirty are clean and so are their parents, a binary
+    // search skips them.
+    size_t lo = h->levels[d];
+    size_t hi = h->levels[d + 1];
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      if (h->order[mid] < h->firstDirty) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+
+    HierarchyLevel level = {h, h->order + lo};
+    size_t count = h->levels[d + 1] - lo;
+    ThreadPoolFor(pool, count, XMATH_HIERARCHY_GRAIN, HierarchyLevelTask,
+                  &level);
+  }
+  HierarchyClean(h);
+}
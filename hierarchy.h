@@ -0,0 +1,121 @@
+/**
+ * @file hierarchy.h
+ * @brief Flat transform hierarchies with dirty propagation.
+ *
+ * Nodes live in parallel arrays indexed by node, every node is stored after
+ * its parent. HierarchyUpdate walks the arrays once in order and recomputes
+ * the world transform and world matrix of the dirty nodes and of everything
+ * below them, the rest of the nodes are not touched.
+ *
+ * HierarchyUpdateParallel does the same work one depth level at a time, the
+ * nodes of a level are split across the threads of a ThreadPool.
+ */
+#ifndef XMATH_HIERARCHY_H
+#define XMATH_HIERARCHY_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+#include "mat4.h"
+#include "threadpool.h"
+#include "transform.h"
+
+//! @brief Parent of the root nodes, also returned by a failed HierarchyAdd.
+#define XMATH_HIERARCHY_NONE UINT32_MAX
+
+//! @brief Nodes per chunk of HierarchyUpdateParallel.
+#define XMATH_HIERARCHY_GRAIN 512
+
+/**
+ * @brief Transform hierarchy stored as parallel arrays.
+ *
+ * world[i] is local[i] in the space of world[parent[i]], worldMatrix[i] is
+ * the same map as a matrix. The world scale is the component product of the
+ * scales, which is exact for uniform scales; the world matrix is the product
+ * of the local matrices and stays exact with non uniform scales too.
+ *
+ * The arrays can be read freely, local and parent must be written through
+ * HierarchySetLocal and HierarchyAdd so the dirty flags stay correct.
+ * depth, order and levels are kept for HierarchyUpdateParallel: order lists
+ * the nodes by depth and levels[d] is the position in order of the first
+ * node of depth d.
+ */
+typedef struct {
+  Transform* local;
+  Transform* world;
+  Mat4* worldMatrix;
+  uint32_t* parent;
+  uint32_t* depth;
+  uint32_t* order;
+  uint32_t* levels;
+  uint8_t* dirty;
+  size_t count;
+  size_t capacity;
+  size_t firstDirty;
+  size_t levelCount;
+  size_t orderCount;
+} Hierarchy;
+
+/**
+ * @brief Allocate an empty hierarchy.
+ * @param h hierarchy to initialize.
+ * @param capacity maximum number of nodes.
+ * @return false if the memory could not be allocated.
+ */
+XMATH_API bool HierarchyMake(Hierarchy* h, size_t capacity);
+
+/**
+ * @brief Release the memory of a hierarchy made by HierarchyMake.
+ * @param h hierarchy to release, left empty.
+ */
+XMATH_API void HierarchyFree(Hierarchy* h);
+
+/**
+ * @brief Append a node, it starts dirty.
+ * @param h hierarchy.
+ * @param parent index of an existing node or XMATH_HIERARCHY_NONE for a root.
+ * @param local transform relative to the parent.
+ * @return index of the new node, XMATH_HIERARCHY_NONE if h is full.
+ */
+XMATH_API uint32_t HierarchyAdd(Hierarchy* h, uint32_t parent, Transform local);
+
+/**
+ * @brief Replace the local transform of a node and mark it dirty.
+ * @param h hierarchy.
+ * @param node index of the node.
+ * @param local transform relative to the parent.
+ */
+XMATH_API void HierarchySetLocal(Hierarchy* h, uint32_t node, Transform local);
+
+/**
+ * @brief Mark a node dirty after writing h->local[node] directly.
+ * @param h hierarchy.
+ * @param node index of the node.
+ */
+XMATH_API void HierarchyMarkDirty(Hierarchy* h, uint32_t node);
+
+/**
+ * @brief Recompute the world transforms and matrices of the dirty subtrees.
+ *
+ * Clears every dirty flag.
+ * @param h hierarchy.
+ */
+XMATH_API void HierarchyUpdate(Hierarchy* h);
+
+/**
+ * @brief Same as HierarchyUpdate with the nodes of each depth level split
+ * across the threads of a pool.
+ *
+ * Levels run one after the other, the nodes of a level only read the world
+ * values of the previous one. The order of the levels is rebuilt after nodes
+ * are added, which takes a serial pass over the nodes.
+ * @param h hierarchy.
+ * @param pool pool to run on, NULL runs every level on the calling thread.
+ */
+XMATH_API void HierarchyUpdateParallel(Hierarchy* h, ThreadPool* pool);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "hierarchy.c"
+#endif
+
+#endif /* XMATH_HIERARCHY_H */
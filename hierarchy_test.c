@@ -0,0 +1,204 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "hierarchy.h"
+#include "common_testing.h"
+#include "scalar.h"
+
+//    0       5
+//   / \      |
+//  1   4     6
+//  |
+//  2
+//  |
+//  3
+static const uint32_t gParents[] = {
+    XMATH_HIERARCHY_NONE, 0, 1, 2, 0, XMATH_HIERARCHY_NONE, 5,
+};
+#define COUNT (sizeof(gParents) / sizeof(gParents[0]))
+
+static Transform NodeTransform(unsigned i) {
+  float f = (float)i;
+  return (Transform){
+      .position = {0.1f * f, 0.2f, -0.1f * f},
+      .rotation = QuatMakeAngleAxis(0.3f * f, Vec3Norm((Vec3){1, f, 2})),
+      .scale = Vec3Scale(Vec3One, 1.0f + 0.05f * f),
+  };
+}
+
+static void MakeSample(Hierarchy* h) {
+  assert_true(HierarchyMake(h, COUNT));
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_int_equal(HierarchyAdd(h, gParents[i], NodeTransform(i)), i);
+  }
+}
+
+// World matrix computed from scratch, walking up to the root.
+static Mat4 ExpectedMatrix(const Hierarchy* h, uint32_t node) {
+  Mat4 r = TransformToMat4(h->local[node]);
+  for (uint32_t p = h->parent[node]; p != XMATH_HIERARCHY_NONE;
+       p = h->parent[p]) {
+    r = Mat4Mul(r, TransformToMat4(h->local[p]));
+  }
+  return r;
+}
+
+static void AssertWorld(const Hierarchy* h) {
+  for (uint32_t i = 0; i < h->count; i++) {
+    assert_true(Mat4EqualApprox(h->worldMatrix[i], ExpectedMatrix(h, i)));
+
+    // With uniform scales the world transform is the same map, points are
+    // rows of the matrix: p.x * row x + p.y * row y + p.z * row z + row w.
+    const Mat4* m = &h->worldMatrix[i];
+    Vec3 p = {0.3f, -0.2f, 0.5f};
+    Vec3 e = {
+        p.x * m->xx + p.y * m->yx + p.z * m->zx + m->wx,
+        p.x * m->xy + p.y * m->yy + p.z * m->zy + m->wy,
+        p.x * m->xz + p.y * m->yz + p.z * m->zz + m->wz,
+    };
+    assert_true(Vec3EqualApprox(TransformPoint(h->world[i], p), e));
+  }
+}
+
+static void test_HierarchyAdd(void** state) {
+  UNUSED(state);
+
+  Hierarchy h;
+  MakeSample(&h);
+  assert_int_equal(h.count, COUNT);
+  assert_int_equal(HierarchyAdd(&h, 0, NodeTransform(0)),
+                   XMATH_HIERARCHY_NONE);
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_int_equal(h.parent[i], gParents[i]);
+    assert_int_equal(h.dirty[i], 1);
+  }
+
+  HierarchyFree(&h);
+  assert_true(h.local == NULL);
+  assert_int_equal(h.count, 0);
+}
+
+static void test_HierarchyUpdate(void** state) {
+  UNUSED(state);
+
+  Hierarchy h;
+  MakeSample(&h);
+  HierarchyUpdate(&h);
+  AssertWorld(&h);
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_int_equal(h.dirty[i], 0);
+  }
+
+  HierarchyFree(&h);
+}
+
+static void test_HierarchyDirtySubtree(void** state) {
+  UNUSED(state);
+
+  Hierarchy h;
+  MakeSample(&h);
+  HierarchyUpdate(&h);
+
+  // Poison the outputs of the nodes outside the subtree of 1 (but its
+  // parent), they must not be recomputed.
+  Mat4 poison = Mat4Scale(Mat4Identity, 42.0f);
+  for (unsigned i = 4; i < COUNT; i++) {
+    h.worldMatrix[i] = poison;
+  }
+
+  HierarchySetLocal(&h, 1, NodeTransform(9));
+  HierarchyUpdate(&h);
+  for (uint32_t i = 0; i < COUNT; i++) {
+    if (i < 4) {
+      assert_true(Mat4EqualApprox(h.worldMatrix[i], ExpectedMatrix(&h, i)));
+    } else {
+      assert_true(Mat4EqualApprox(h.worldMatrix[i], poison));
+    }
+  }
+
+  // Nothing is dirty, nothing changes.
+  HierarchyUpdate(&h);
+  assert_true(Mat4EqualApprox(h.worldMatrix[4], poison));
+
+  // Writing the local transform directly needs a mark.
+  h.local[5] = NodeTransform(11);
+  HierarchyMarkDirty(&h, 5);
+  HierarchyMarkDirty(&h, 0);
+  HierarchyUpdate(&h);
+  AssertWorld(&h);
+
+  HierarchyFree(&h);
+}
+
+static void test_HierarchyUpdateParallel(void** state) {
+  UNUSED(state);
+
+  // Three children per node and a second root every 300 nodes, far more
+  // nodes than XMATH_HIERARCHY_GRAIN so the levels are split.
+  enum { kNodes = 3000 };
+  Hierarchy serial;
+  Hierarchy parallel;
+  assert_true(HierarchyMake(&serial, kNodes));
+  assert_true(HierarchyMake(&parallel, kNodes));
+  for (uint32_t i = 0; i < kNodes; i++) {
+    uint32_t p = i % 300 == 0 ? XMATH_HIERARCHY_NONE : (i - 1) / 3;
+    Transform t = NodeTransform(i % 17);
+    HierarchyAdd(&serial, p, t);
+    HierarchyAdd(&parallel, p, t);
+  }
+
+  ThreadPool pool;
+  assert_true(ThreadPoolMake(&pool, 3));
+  for (unsigned pass = 0; pass < 3; pass++) {
+    HierarchyUpdate(&serial);
+    HierarchyUpdateParallel(&parallel, &pool);
+    for (uint32_t i = 0; i < kNodes; i++) {
+      assert_int_equal(parallel.dirty[i], 0);
+      assert_true(Mat4EqualApprox(parallel.worldMatrix[i],
+                                  serial.worldMatrix[i]));
+      assert_true(TransformEqualApprox(parallel.world[i], serial.world[i]));
+    }
+
+    // Move a few nodes, the parallel levels skip the clean prefix.
+    for (uint32_t i = 700 + pass; i < kNodes; i += 911) {
+      HierarchySetLocal(&serial, i, NodeTransform(pass + 3));
+      HierarchySetLocal(&parallel, i, NodeTransform(pass + 3));
+    }
+  }
+
+  // Nodes added after an update are sorted into their levels.
+  HierarchyFree(&parallel);
+  assert_true(HierarchyMake(&parallel, COUNT + 1));
+  for (unsigned i = 0; i < COUNT; i++) {
+    HierarchyAdd(&parallel, gParents[i], NodeTransform(i));
+  }
+  HierarchyUpdateParallel(&parallel, &pool);
+  AssertWorld(&parallel);
+  assert_int_equal(HierarchyAdd(&parallel, 3, NodeTransform(4)), COUNT);
+  HierarchyUpdateParallel(&parallel, NULL);
+  AssertWorld(&parallel);
+  assert_int_equal(parallel.levelCount, 5);
+
+  ThreadPoolFree(&pool);
+  HierarchyFree(&serial);
+  HierarchyFree(&parallel);
+}
+
+int main() {
+  UNUSED_TYPE(jmp_buf);
+  UNUSED_TYPE(va_list);
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_HierarchyAdd),
+      cmocka_unit_test(test_HierarchyUpdate),
+      cmocka_unit_test(test_HierarchyDirtySubtree),
+      cmocka_unit_test(test_HierarchyUpdateParallel),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,126 @@
+#include "mat3.h"
+#include <assert.h>
+#include "batch.h"
+#include "dispatch_table.h"
+#include "scalar.h"
+#include "simd.h"
+
+XMATH_API float* Mat3Floats(Mat3* m) {
+  return &m->xx;
+}
+
+XMATH_API bool Mat3EqualApprox(Mat3 a, Mat3 b) {
+  const float* as = &a.xx;
+  const float* bs = &b.xx;
+  for (unsigned i = 0; i < 9; i++) {
+    if (!FEqualApprox(as[i], bs[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+XMATH_API Mat3 Mat3Transpose(Mat3 m) {
+  // clang-format off
+  return (Mat3){
+    m.xx, m.yx, m.zx,
+    m.xy, m.yy, m.zy,
+    m.xz, m.yz, m.zz,
+  };
+  // clang-format on
+}
+
+XMATH_API bool Mat3Invert(Mat3* result, Mat3 m) {
+  F32x4 c[3];
+  if (!BatchInvert3Columns(c, F32x4Load3(&m.xx), F32x4Load3(&m.yx),
+                           F32x4Load3(&m.zx))) {
+    return false;
+  }
+
+  F32x4 c3 = F32x4Splat(0.0f);
+  F32x4Transpose(&c[0], &c[1], &c[2], &c3);
+  F32x4Store3(&result->xx, c[0]);
+  F32x4Store3(&result->yx, c[1]);
+  F32x4Store3(&result->zx, c[2]);
+  return true;
+}
+
+XMATH_API Mat3 Mat3Mul(Mat3 a, Mat3 b) {
+  Mat3 r;
+  Mat3MulTo(&r, &a, &b);
+  return r;
+}
+
+XMATH_API void Mat3MulTo(Mat3* XMATH_RESTRICT out,
+                         const Mat3* a,
+                         const Mat3* b) {
+  const float* as = &a->xx;
+  const float* bs = &b->xx;
+  float* rs = &out->xx;
+  for (unsigned i = 0; i < 9; i += 3) {
+    for (unsigned j = 0; j < 3; j++) {
+      rs[i + j] = as[i] * bs[j] + as[i + 1] * bs[3 + j] + as[i + 2] * bs[6 + j];
+    }
+  }
+}
+
+XMATH_API Vec3 Mat3TransformVec3(Mat3 m, Vec3 v) {
+  return (Vec3){
+      v.x * m.xx + v.y * m.yx + v.z * m.zx,
+      v.x * m.xy + v.y * m.yy + v.z * m.zy,
+      v.x * m.xz + v.y * m.yz + v.z * m.zz,
+  };
+}
+
+XMATH_API void Mat3TransformVec3Array(Vec3* out,
+                                      const Mat3* m,
+                                      const Vec3* in,
+                                      size_t count) {
+  assert(m != NULL);
+  assert(count == 0 || (in != NULL && out != NULL));
+
+  // The affine kernel takes one row per output component.
+  // clang-format off
+  float rows[12] = {
+    m->xx, m->yx, m->zx, 0.0f,
+    m->xy, m->yy, m->zy, 0.0f,
+    m->xz, m->yz, m->zz, 0.0f,
+  };
+  // clang-format on
+  DispatchAffineVec3(rows, out, sizeof(Vec3), in, sizeof(Vec3), count);
+}
+
+XMATH_API Mat3 QuatToMat3(Quat q) {
+  // Closed form of QuatTransformVec3 on the three axes, the affine rows hold
+  // the images of the axes in their columns.
+  float rows[12];
+  BatchAffineRows(rows, &q.x, Vec3One, Vec3Zero);
+  // clang-format off
+  return (Mat3){
+    rows[0], rows[4], rows[8],
+    rows[1], rows[5], rows[9],
+    rows[2], rows[6], rows[10],
+  };
+  // clang-format on
+}
+
+XMATH_API Mat3 Mat4ToMat3(Mat4 m) {
+  // clang-format off
+  return (Mat3){
+    m.xx, m.xy, m.xz,
+    m.yx, m.yy, m.yz,
+    m.zx, m.zy, m.zz,
+  };
+  // clang-format on
+}
+
+XMATH_API Mat4 Mat3ToMat4(Mat3 m) {
+  // clang-format off
+  return (Mat4){
+    m.xx, m.xy, m.xz, 0.0f,
+    m.yx, m.yy, m.yz, 0.0f,
+    m.zx, m.zy, m.zz, 0.0f,
+    0.0f, 0.0f, 0.0f, 1.0f,
+  };
+  // clang-format on
+}
@@ -0,0 +1,142 @@
+/**
+ * @file mat3.h
+ * @brief Definitions, functions and utilities for 3x3 matrices.
+ *
+ * A Mat3 has the layout of the upper left part of a Mat4: each row is the
+ * image of an axis, as in QuatToMat4 and TransformToMat4, and vectors are
+ * transformed as rows (v * m).
+ */
+#ifndef XMATH_MAT3_H
+#define XMATH_MAT3_H
+#include <stdbool.h>
+#include <stddef.h>
+#include "api.h"
+#include "mat4.h"
+#include "quat.h"
+#include "vec3.h"
+// clang-format off
+
+/**
+ * @brief Square matrix of 3x3 elements.
+ */
+typedef struct {
+  float xx, xy, xz;
+  float yx, yy, yz;
+  float zx, zy, zz;
+} Mat3;
+
+//! @brief a Mat3 full of zeroes.
+static const Mat3 Mat3Zero = {
+  0.0f, 0.0f, 0.0f,
+  0.0f, 0.0f, 0.0f,
+  0.0f, 0.0f, 0.0f,
+};
+
+//! @brief an identity form of Mat3.
+static const Mat3 Mat3Identity = {
+  1.0f, 0.0f, 0.0f,
+  0.0f, 1.0f, 0.0f,
+  0.0f, 0.0f, 1.0f,
+};
+// clang-format on
+
+/**
+ * @brief Get the consecutive floating values from a Mat3.
+ * @param m reference of the matrix.
+ * @return The address of the xx element.
+ */
+XMATH_API float* Mat3Floats(Mat3* m);
+
+/**
+ * @brief Compare the elements of two matrices.
+ * @param a first matrix.
+ * @param b second matrix.
+ * @return true if a elements are near b elements.
+ */
+XMATH_API bool Mat3EqualApprox(Mat3 a, Mat3 b);
+
+/**
+ * @brief Transpose a matrix.
+ * @param m matrix to be transposed (unaffected).
+ * @return transposed matrix.
+ */
+XMATH_API Mat3 Mat3Transpose(Mat3 m);
+
+/**
+ * @brief Get the inverse of a matrix.
+ * @param result inverse of m (out).
+ * @param m matrix to be inverted (unaffected).
+ * @return true if the matrix can be inverted, false otherwise.
+ */
+XMATH_API bool Mat3Invert(Mat3* result, Mat3 m);
+
+/**
+ * @brief Multiply two matrices.
+ *
+ * Same order as Mat4Mul: vectors transformed by the result go through a
+ * first, then b.
+ * @param a left operand.
+ * @param b right operand.
+ * @return a x b.
+ */
+XMATH_API Mat3 Mat3Mul(Mat3 a, Mat3 b);
+
+/**
+ * @brief Multiply two matrices into out.
+ * @param out a x b, must not be a or b.
+ * @param a left operand.
+ * @param b right operand.
+ */
+XMATH_API void Mat3MulTo(Mat3* XMATH_RESTRICT out,
+                         const Mat3* a,
+                         const Mat3* b);
+
+/**
+ * @brief Transform a vector.
+ * @param m matrix to apply.
+ * @param v vector to transform.
+ * @return v * m.
+ */
+XMATH_API Vec3 Mat3TransformVec3(Mat3 m, Vec3 v);
+
+/**
+ * @brief Transform an array of vectors.
+ *
+ * Same as calling Mat3TransformVec3 on every element, the matrix is read
+ * once.
+ * @param out destination of count vectors, can be the same as in.
+ * @param m matrix to apply.
+ * @param in source of count vectors.
+ * @param count number of vectors.
+ */
+XMATH_API void Mat3TransformVec3Array(Vec3* out,
+                                      const Mat3* m,
+                                      const Vec3* in,
+                                      size_t count);
+
+/**
+ * @brief Convert a quaternion into a rotation matrix.
+ * @param q rotation (unaffected).
+ * @return the upper left part of QuatToMat4(q).
+ */
+XMATH_API Mat3 QuatToMat3(Quat q);
+
+/**
+ * @brief Take the upper left 3x3 part of a Mat4.
+ * @param m matrix to convert (unaffected).
+ * @return the rotation and scale part of m.
+ */
+XMATH_API Mat3 Mat4ToMat3(Mat4 m);
+
+/**
+ * @brief Extend a Mat3 into a Mat4 without translation.
+ * @param m matrix to convert (unaffected).
+ * @return m in the upper left part of an identity Mat4.
+ */
+XMATH_API Mat4 Mat3ToMat4(Mat3 m);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "mat3.c"
+#endif
+
+#endif /* XMATH_MAT3_H */
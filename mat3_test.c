@@ -0,0 +1,123 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "mat3.h"
+#include "common_testing.h"
+#include "scalar.h"
+
+// clang-format off
+static const Mat3 gSample = {
+  0.8f, 0.1f, -0.3f,
+  0.2f, 1.1f, 0.4f,
+  -0.5f, 0.3f, 0.9f,
+};
+// clang-format on
+
+void test_Mat3Transpose(void** state) {
+  UNUSED(state);
+
+  Mat3 r = Mat3Transpose(gSample);
+  assert_float_equal(r.xy, gSample.yx, XMATH_EPSILON);
+  assert_float_equal(r.zx, gSample.xz, XMATH_EPSILON);
+  assert_true(Mat3EqualApprox(Mat3Transpose(r), gSample));
+}
+
+void test_Mat3Invert(void** state) {
+  UNUSED(state);
+
+  Mat3 r;
+  assert_true(Mat3Invert(&r, gSample));
+  assert_true(Mat3EqualApprox(Mat3Mul(gSample, r), Mat3Identity));
+  assert_true(Mat3EqualApprox(Mat3Mul(r, gSample), Mat3Identity));
+
+  // Same result as the general inverse of the equivalent Mat4.
+  Mat4 e;
+  assert_true(Mat4Invert(&e, Mat3ToMat4(gSample)));
+  assert_true(Mat3EqualApprox(r, Mat4ToMat3(e)));
+
+  // A singular matrix leaves the output untouched.
+  Mat3 s = gSample;
+  s.xx = 0.0f;
+  s.yx = 0.0f;
+  s.zx = 0.0f;
+  r = Mat3Identity;
+  assert_false(Mat3Invert(&r, s));
+  assert_true(Mat3EqualApprox(r, Mat3Identity));
+}
+
+void test_Mat3Mul(void** state) {
+  UNUSED(state);
+
+  Quat a = QuatMakeAngleAxis(FDeg2Rad(30.0f), Vec3Up);
+  Quat b = QuatMakeAngleAxis(FDeg2Rad(-45.0f), Vec3Right);
+  Mat3 ma = QuatToMat3(a);
+  Mat3 mb = QuatToMat3(b);
+
+  // Same as Mat4Mul on the equivalent matrices.
+  Mat4 e = Mat4Mul(Mat3ToMat4(ma), Mat3ToMat4(mb));
+  Mat3 r = Mat3Mul(ma, mb);
+  assert_true(Mat3EqualApprox(r, Mat4ToMat3(e)));
+
+  r = Mat3Zero;
+  Mat3MulTo(&r, &ma, &mb);
+  assert_true(Mat3EqualApprox(r, Mat4ToMat3(e)));
+
+  // Vectors go through a first, then b.
+  Vec3 v = {0.3f, -0.7f, 0.2f};
+  Vec3 ev = QuatTransformVec3(b, QuatTransformVec3(a, v));
+  assert_true(Vec3EqualApprox(Mat3TransformVec3(r, v), ev));
+}
+
+void test_Mat3TransformVec3(void** state) {
+  UNUSED(state);
+
+  Quat q = QuatMakeAngleAxis(FDeg2Rad(70.0f), Vec3Norm((Vec3){1, 2, 3}));
+  Mat3 m = QuatToMat3(q);
+  Vec3 v = {0.5f, 0.25f, -1.0f};
+  assert_true(
+      Vec3EqualApprox(Mat3TransformVec3(m, v), QuatTransformVec3(q, v)));
+
+  // Same basis as QuatToMat4.
+  assert_true(Mat4EqualApprox(Mat3ToMat4(m), QuatToMat4(q)));
+}
+
+void test_Mat3TransformVec3Array(void** state) {
+  UNUSED(state);
+
+  // Not a multiple of four, so the tail of the kernel is exercised.
+  Vec3 in[7];
+  Vec3 out[7];
+  for (unsigned i = 0; i < 7; i++) {
+    in[i] = (Vec3){0.1f * (float)i, 1.0f - 0.2f * (float)i, 0.3f};
+  }
+
+  Mat3TransformVec3Array(out, &gSample, in, 7);
+  for (unsigned i = 0; i < 7; i++) {
+    assert_true(Vec3EqualApprox(out[i], Mat3TransformVec3(gSample, in[i])));
+  }
+
+  // In place.
+  Mat3TransformVec3Array(in, &gSample, in, 7);
+  for (unsigned i = 0; i < 7; i++) {
+    assert_true(Vec3EqualApprox(in[i], out[i]));
+  }
+}
+
+int main() {
+  UNUSED_TYPE(jmp_buf);
+  UNUSED_TYPE(va_list);
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_Mat3Transpose),
+      cmocka_unit_test(test_Mat3Invert),
+      cmocka_unit_test(test_Mat3Mul),
+      cmocka_unit_test(test_Mat3TransformVec3),
+      cmocka_unit_test(test_Mat3TransformVec3Array),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
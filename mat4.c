@@ -1,14 +1,17 @@
 #include <assert.h>
 #include <math.h>
 
+#include "batch.h"
+#include "dispatch_table.h"
 #include "mat4.h"
 #include "scalar.h"
+#include "simd.h"
 
-float* Mat4Floats(Mat4* m) {
+XMATH_API float* Mat4Floats(Mat4* m) {
   return &m->xx;
 }
 
-bool Mat4EqualApprox(Mat4 a, Mat4 b) {
+XMATH_API bool Mat4EqualApprox(Mat4 a, Mat4 b) {
   float* as = Mat4Floats(&a);
   float* bs = Mat4Floats(&b);
   for (unsigned i = 0; i < 16; i++) {
@@ -20,7 +23,7 @@ bool Mat4EqualApprox(Mat4 a, Mat4 b) {
   return true;
 }
 
-Vec4 Mat4Row(Mat4 m, unsigned int i) {
+XMATH_API Vec4 Mat4Row(Mat4 m, unsigned int i) {
   assert(i <= 4);
 
   Vec4 r;
@@ -32,7 +35,7 @@ Vec4 Mat4Row(Mat4 m, unsigned int i) {
   return r;
 }
 
-Vec4 Mat4Col(Mat4 m, unsigned int i) {
+XMATH_API Vec4 Mat4Col(Mat4 m, unsigned int i) {
   assert(i <= 3);
 
   Vec4 r;
@@ -44,196 +47,358 @@ Vec4 Mat4Col(Mat4 m, unsigned int i) {
   return r;
 }
 
-Mat4 Mat4Transpose(const Mat4 m) {
+XMATH_API Mat4 Mat4Transpose(const Mat4 m) {
   Mat4 r;
-
-  r.xx = m.xx;
-  r.xy = m.yx;
-  r.xz = m.zx;
-  r.xw = m.wx;
-  r.yx = m.xy;
-  r.yy = m.yy;
-  r.yz = m.zy;
-  r.yw = m.wy;
-  r.zx = m.xz;
-  r.zy = m.yz;
-  r.zz = m.zz;
-  r.zw = m.wz;
-  r.wx = m.xw;
-  r.wy = m.yw;
-  r.wz = m.zw;
-  r.ww = m.ww;
-
+  Mat4TransposeTo(&r, &m);
   return r;
 }
 
-bool Mat4Invert(Mat4* result, Mat4 m) {
-  Mat4 inv = {0};
-  inv.xx = m.yy * m.zz * m.ww - m.yy * m.zy * m.wz - m.zy * m.yz * m.ww +
-           m.zy * m.yw * m.wz + m.wy * m.yz * m.zy - m.wy * m.yw * m.zz;
-
-  inv.yx = -m.yx * m.zz * m.ww + m.yx * m.zy * m.wz + m.zx * m.yz * m.ww -
-           m.zx * m.yw * m.wz - m.wx * m.yz * m.zy + m.wx * m.yw * m.zz;
-
-  inv.zx = m.yx * m.zy * m.ww - m.yx * m.zy * m.wy - m.zx * m.yy * m.ww +
-           m.zx * m.yw * m.wy + m.wx * m.yy * m.zy - m.wx * m.yw * m.zy;
+XMATH_API void Mat4TransposeTo(Mat4* XMATH_RESTRICT out, const Mat4* m) {
+  F32x4 r0 = F32x4Load(&m->xx);
+  F32x4 r1 = F32x4Load(&m->yx);
+  F32x4 r2 = F32x4Load(&m->zx);
+  F32x4 r3 = F32x4Load(&m->wx);
+  F32x4Transpose(&r0, &r1, &r2, &r3);
+  F32x4Store(&out->xx, r0);
+  F32x4Store(&out->yx, r1);
+  F32x4Store(&out->zx, r2);
+  F32x4Store(&out->wx, r3);
+}
 
-  inv.wx = -m.yx * m.zy * m.wz + m.yx * m.zz * m.wy + m.zx * m.yy * m.wz -
-           m.zx * m.yz * m.wy - m.wx * m.yy * m.zz + m.wx * m.yz * m.zy;
+XMATH_API bool Mat4Invert(Mat4* result, Mat4 m) {
+  // Cofactors by expansion of the minors, over the elements in Mat4Floats
+  // order so the same code serves both row and column conventions.
+  const float* a = &m.xx;
+  float inv[16];
+  inv[0] = a[5] * a[10] * a[15] - a[5] * a[11] * a[14] -
+           a[9] * a[6] * a[15] + a[9] * a[7] * a[14] +
+           a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+  inv[4] = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] +
+           a[8] * a[6] * a[15] - a[8] * a[7] * a[14] -
+           a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+  inv[8] = a[4] * a[9] * a[15] - a[4] * a[11] * a[13] -
+           a[8] * a[5] * a[15] + a[8] * a[7] * a[13] +
+           a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+  inv[12] = -a[4] * a[9] * a[14] + a[4] * a[10] * a[13] +
+            a[8] * a[5] * a[14] - a[8] * a[6] * a[13] -
+            a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+  inv[1] = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] +
+           a[9] * a[2] * a[15] - a[9] * a[3] * a[14] -
+           a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+  inv[5] = a[0] * a[10] * a[15] - a[0] * a[11] * a[14] -
+           a[8] * a[2] * a[15] + a[8] * a[3] * a[14] +
+           a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+  inv[9] = -a[0] * a[9] * a[15] + a[0] * a[11] * a[13] +
+           a[8] * a[1] * a[15] - a[8] * a[3] * a[13] -
+           a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+  inv[13] = a[0] * a[9] * a[14] - a[0] * a[10] * a[13] -
+            a[8] * a[1] * a[14] + a[8] * a[2] * a[13] +
+            a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+  inv[2] = a[1] * a[6] * a[15] - a[1] * a[7] * a[14] -
+           a[5] * a[2] * a[15] + a[5] * a[3] * a[14] +
+           a[13] * a[2] * a[7] - a[13] * a[3] * a[6];
+  inv[6] = -a[0] * a[6] * a[15] + a[0] * a[7] * a[14] +
+           a[4] * a[2] * a[15] - a[4] * a[3] * a[14] -
+           a[12] * a[2] * a[7] + a[12] * a[3] * a[6];
+  inv[10] = a[0] * a[5] * a[15] - a[0] * a[7] * a[13] -
+            a[4] * a[1] * a[15] + a[4] * a[3] * a[13] +
+            a[12] * a[1] * a[7] - a[12] * a[3] * a[5];
+  inv[14] = -a[0] * a[5] * a[14] + a[0] * a[6] * a[13] +
+            a[4] * a[1] * a[14] - a[4] * a[2] * a[13] -
+            a[12] * a[1] * a[6] + a[12] * a[2] * a[5];
+  inv[3] = -a[1] * a[6] * a[11] + a[1] * a[7] * a[10] +
+           a[5] * a[2] * a[11] - a[5] * a[3] * a[10] -
+           a[9] * a[2] * a[7] + a[9] * a[3] * a[6];
+  inv[7] = a[0] * a[6] * a[11] - a[0] * a[7] * a[10] -
+           a[4] * a[2] * a[11] + a[4] * a[3] * a[10] +
+           a[8] * a[2] * a[7] - a[8] * a[3] * a[6];
+  inv[11] = -a[0] * a[5] * a[11] + a[0] * a[7] * a[9] +
+            a[4] * a[1] * a[11] - a[4] * a[3] * a[9] -
+            a[8] * a[1] * a[7] + a[8] * a[3] * a[5];
+  inv[15] = a[0] * a[5] * a[10] - a[0] * a[6] * a[9] -
+            a[4] * a[1] * a[10] + a[4] * a[2] * a[9] +
+            a[8] * a[1] * a[6] - a[8] * a[2] * a[5];
+
+  float det = a[0] * inv[0] + a[1] * inv[4] + a[2] * inv[8] + a[3] * inv[12];
+  if (det == 0) {
+    return false;
+  }
 
-  inv.xy = -m.xy * m.zz * m.ww + m.xy * m.zy * m.wz + m.zy * m.xz * m.ww -
-           m.zy * m.xw * m.wz - m.wy * m.xz * m.zy + m.wy * m.xw * m.zz;
+  float* resFloats = Mat4Floats(result);
+  det = 1.0f / det;
+  for (unsigned i = 0; i < 16; i++) {
+    resFloats[i] = inv[i] * det;
+  }
 
-  inv.yy = m.xx * m.zz * m.ww - m.xx * m.zy * m.wz - m.zx * m.xz * m.ww +
-           m.zx * m.xw * m.wz + m.wx * m.xz * m.zy - m.wx * m.xw * m.zz;
+  return true;
+}
 
-  inv.zy = -m.xx * m.zy * m.ww + m.xx * m.zy * m.wy + m.zx * m.xy * m.ww -
-           m.zx * m.xw * m.wy - m.wx * m.xy * m.zy + m.wx * m.xw * m.zy;
+// Write the inverse of an affine matrix given the rows of its inverted 3x3
+// part (w lanes zero) and its translation row t.
+static inline void Mat4StoreAffineInverse(Mat4* out,
+                                          F32x4 r0,
+                                          F32x4 r1,
+                                          F32x4 r2,
+                                          F32x4 t) {
+  // The translation undoes t in the inverted basis: -t * R^-1.
+  F32x4 p = F32x4Mul(F32x4Swizzle(t, 0, 0, 0, 0), r0);
+  p = F32x4MulAdd(F32x4Swizzle(t, 1, 1, 1, 1), r1, p);
+  p = F32x4MulAdd(F32x4Swizzle(t, 2, 2, 2, 2), r2, p);
+  F32x4Store(&out->xx, r0);
+  F32x4Store(&out->yx, r1);
+  F32x4Store(&out->zx, r2);
+  F32x4Store(&out->wx, F32x4Sub(F32x4Set(0.0f, 0.0f, 0.0f, 1.0f), p));
+}
 
-  inv.wy = m.xx * m.zy * m.wz - m.xx * m.zz * m.wy - m.zx * m.xy * m.wz +
-           m.zx * m.xz * m.wy + m.wx * m.xy * m.zz - m.wx * m.xz * m.zy;
+XMATH_API Mat4Class Mat4Classify(const Mat4* m) {
+  if (m->xw != 0.0f || m->yw != 0.0f || m->zw != 0.0f || m->ww != 1.0f) {
+    return Mat4ClassGeneral;
+  }
 
-  inv.xz = m.xy * m.yz * m.ww - m.xy * m.yw * m.wz - m.yy * m.xz * m.ww +
-           m.yy * m.xw * m.wz + m.wy * m.xz * m.yw - m.wy * m.xw * m.yz;
+  // Rows of unit length and perpendicular to each other, their w lanes are
+  // zero past the check above.
+  F32x4 x = F32x4Load(&m->xx);
+  F32x4 y = F32x4Load(&m->yx);
+  F32x4 z = F32x4Load(&m->zx);
+  float e = XMATH_MAT4_RIGID_EPSILON;
+  if (fabsf(F32x4Dot(x, x) - 1.0f) < e && fabsf(F32x4Dot(y, y) - 1.0f) < e &&
+      fabsf(F32x4Dot(z, z) - 1.0f) < e && fabsf(F32x4Dot(x, y)) < e &&
+      fabsf(F32x4Dot(y, z)) < e && fabsf(F32x4Dot(z, x)) < e) {
+    return Mat4ClassRigid;
+  }
 
-  inv.yz = -m.xx * m.yz * m.ww + m.xx * m.yw * m.wz + m.yx * m.xz * m.ww -
-           m.yx * m.xw * m.wz - m.wx * m.xz * m.yw + m.wx * m.xw * m.yz;
+  return Mat4ClassAffine;
+}
 
-  inv.zz = m.xx * m.yy * m.ww - m.xx * m.yw * m.wy - m.yx * m.xy * m.ww +
-           m.yx * m.xw * m.wy + m.wx * m.xy * m.yw - m.wx * m.xw * m.yy;
+XMATH_API bool Mat4InvertAffine(Mat4* XMATH_RESTRICT out, const Mat4* m) {
+  F32x4 mask = F32x4Set(1.0f, 1.0f, 1.0f, 0.0f);
+  F32x4 c[3];
+  if (!BatchInvert3Columns(c, F32x4Mul(F32x4Load(&m->xx), mask),
+                           F32x4Mul(F32x4Load(&m->yx), mask),
+                           F32x4Mul(F32x4Load(&m->zx), mask))) {
+    return false;
+  }
 
-  inv.wz = -m.xx * m.yy * m.wz + m.xx * m.yz * m.wy + m.yx * m.xy * m.wz -
-           m.yx * m.xz * m.wy - m.wx * m.xy * m.yz + m.wx * m.xz * m.yy;
+  F32x4 c3 = F32x4Splat(0.0f);
+  F32x4Transpose(&c[0], &c[1], &c[2], &c3);
+  Mat4StoreAffineInverse(out, c[0], c[1], c[2], F32x4Load(&m->wx));
+  return true;
+}
 
-  inv.xw = -m.xy * m.yz * m.zy + m.xy * m.yw * m.zz + m.yy * m.xz * m.zy -
-           m.yy * m.xw * m.zz - m.zy * m.xz * m.yw + m.zy * m.xw * m.yz;
+XMATH_API void Mat4InvertRigid(Mat4* XMATH_RESTRICT out, const Mat4* m) {
+  // The inverse of an orthonormal basis is its transpose.
+  F32x4 r0 = F32x4Load(&m->xx);
+  F32x4 r1 = F32x4Load(&m->yx);
+  F32x4 r2 = F32x4Load(&m->zx);
+  F32x4 r3 = F32x4Splat(0.0f);
+  F32x4Transpose(&r0, &r1, &r2, &r3);
+  Mat4StoreAffineInverse(out, r0, r1, r2, F32x4Load(&m->wx));
+}
 
-  inv.yw = m.xx * m.yz * m.zy - m.xx * m.yw * m.zz - m.yx * m.xz * m.zy +
-           m.yx * m.xw * m.zz + m.zx * m.xz * m.yw - m.zx * m.xw * m.yz;
+XMATH_API bool Mat4InvertFast(Mat4* XMATH_RESTRICT out, const Mat4* m) {
+  switch (Mat4Classify(m)) {
+    case Mat4ClassRigid:
+      Mat4InvertRigid(out, m);
+      return true;
+    case Mat4ClassAffine:
+      return Mat4InvertAffine(out, m);
+    default:
+      return Mat4Invert(out, *m);
+  }
+}
 
-  inv.zy = -m.xx * m.yy * m.zy + m.xx * m.yw * m.zy + m.yx * m.xy * m.zy -
-           m.yx * m.xw * m.zy - m.zx * m.xy * m.yw + m.zx * m.xw * m.yy;
+XMATH_API bool Mat4InvertArray(Mat4* out,
+                               const Mat4* in,
+                               uint32_t* okMask,
+                               size_t count) {
+  assert(count == 0 || (in != NULL && out != NULL));
+  return DispatchMat4InvertArray(out, in, okMask, count);
+}
 
-  inv.ww = m.xx * m.yy * m.zz - m.xx * m.yz * m.zy - m.yx * m.xy * m.zz +
-           m.yx * m.xz * m.zy + m.zx * m.xy * m.yz - m.zx * m.xz * m.yy;
+XMATH_API Mat4 Mat4Add(const Mat4 a, const Mat4 b) {
+  Mat4 r;
+  Mat4AddTo(&r, &a, &b);
+  return r;
+}
 
-  float det = m.xx * inv.xx + m.xy * inv.yx + m.xz * inv.zx + m.xw * inv.wx;
-  if (det == 0) {
-    return false;
+XMATH_API void Mat4AddTo(Mat4* XMATH_RESTRICT out,
+                         const Mat4* a,
+                         const Mat4* b) {
+  for (unsigned i = 0; i < 16; i += 4) {
+    F32x4 r = F32x4Add(F32x4Load(&a->xx + i), F32x4Load(&b->xx + i));
+    F32x4Store(&out->xx + i, r);
   }
+}
 
-  float* invFloats = Mat4Floats(&inv);
-  float* resFloats = Mat4Floats(result);
+XMATH_API Mat4 Mat4Sub(const Mat4 a, const Mat4 b) {
+  Mat4 r;
+  Mat4SubTo(&r, &a, &b);
+  return r;
+}
 
-  det = 1.0f / det;
-  for (unsigned i = 0; i < 16; i++) {
-    resFloats[i] = invFloats[i] * det;
+XMATH_API void Mat4SubTo(Mat4* XMATH_RESTRICT out,
+                         const Mat4* a,
+                         const Mat4* b) {
+  for (unsigned i = 0; i < 16; i += 4) {
+    F32x4 r = F32x4Sub(F32x4Load(&a->xx + i), F32x4Load(&b->xx + i));
+    F32x4Store(&out->xx + i, r);
   }
-
-  return true;
 }
 
-Mat4 Mat4Add(const Mat4 a, const Mat4 b) {
+XMATH_API Mat4 Mat4Scale(const Mat4 a, float s) {
   Mat4 r;
-  r.xx = a.xx + b.xx;
-  r.xy = a.xy + b.xy;
-  r.xz = a.xz + b.xz;
-  r.xw = a.xw + b.xw;
-  r.yx = a.yx + b.yx;
-  r.yy = a.yy + b.yy;
-  r.yz = a.yz + b.yz;
-  r.yw = a.yw + b.yw;
-  r.zx = a.zx + b.zx;
-  r.zy = a.zy + b.zy;
-  r.zz = a.zz + b.zz;
-  r.zw = a.zw + b.zw;
-  r.wx = a.wx + b.wx;
-  r.wy = a.wy + b.wy;
-  r.wz = a.wz + b.wz;
-  r.ww = a.ww + b.ww;
+  Mat4ScaleTo(&r, &a, s);
   return r;
 }
 
-Mat4 Mat4Sub(const Mat4 a, const Mat4 b) {
-  Mat4 r;
-  r.xx = a.xx - b.xx;
-  r.xy = a.xy - b.xy;
-  r.xz = a.xz - b.xz;
-  r.xw = a.xw - b.xw;
-  r.yx = a.yx - b.yx;
-  r.yy = a.yy - b.yy;
-  r.yz = a.yz - b.yz;
-  r.yw = a.yw - b.yw;
-  r.zx = a.zx - b.zx;
-  r.zy = a.zy - b.zy;
-  r.zz = a.zz - b.zz;
-  r.zw = a.zw - b.zw;
-  r.wx = a.wx - b.wx;
-  r.wy = a.wy - b.wy;
-  r.wz = a.wz - b.wz;
-  r.ww = a.ww - b.ww;
-  return r;
+XMATH_API void Mat4ScaleTo(Mat4* XMATH_RESTRICT out, const Mat4* a, float s) {
+  F32x4 k = F32x4Splat(s);
+  for (unsigned i = 0; i < 16; i += 4) {
+    F32x4Store(&out->xx + i, F32x4Mul(F32x4Load(&a->xx + i), k));
+  }
 }
 
-Mat4 Mat4Scale(const Mat4 a, float s) {
+XMATH_API Mat4 Mat4Mul(const Mat4 a, const Mat4 b) {
   Mat4 r;
-  r.xx = a.xx * s;
-  r.xy = a.xy * s;
-  r.xz = a.xz * s;
-  r.xw = a.xw * s;
-  r.yx = a.yx * s;
-  r.yy = a.yy * s;
-  r.yz = a.yz * s;
-  r.yw = a.yw * s;
-  r.zx = a.zx * s;
-  r.zy = a.zy * s;
-  r.zz = a.zz * s;
-  r.zw = a.zw * s;
-  r.wx = a.wx * s;
-  r.wy = a.wy * s;
-  r.wz = a.wz * s;
-  r.ww = a.ww * s;
+  DispatchMat4Mul(&r, &a, &b);
   return r;
 }
 
-Mat4 Mat4Mul(const Mat4 a, const Mat4 b) {
-  Mat4 r = Mat4Zero;
+XMATH_API void Mat4MulTo(Mat4* XMATH_RESTRICT out,
+                         const Mat4* a,
+                         const Mat4* b) {
+  DispatchMat4Mul(out, a, b);
+}
 
-  r.xx = a.xx * b.xx + a.xy * b.yx + a.xz * b.zx + a.xw * b.wx;
-  r.xy = a.xx * b.xy + a.xy * b.yy + a.xz * b.zy + a.xw * b.wy;
-  r.xz = a.xx * b.xz + a.xy * b.yz + a.xz * b.zz + a.xw * b.wz;
-  r.xw = a.xx * b.xw + a.xy * b.yw + a.xz * b.zw + a.xw * b.ww;
+// Product of the rows at as with the vector in v.
+static inline F32x4 Mat4MulVec4Lanes(const float* as, F32x4 v) {
+#if defined(XMATH_SIMD_AVX)
+  // Two rows per register, the four partial products are transposed so the
+  // horizontal sums become plain adds.
+  F32x8 vv = F32x8Combine(v, v);
+  F32x8 a01 = F32x8Combine(F32x4Load(as), F32x4Load(as + 4));
+  F32x8 a23 = F32x8Combine(F32x4Load(as + 8), F32x4Load(as + 12));
+  F32x8 p01 = F32x8Mul(a01, vv);
+  F32x8 p23 = F32x8Mul(a23, vv);
+  F32x4 p0 = F32x8Lo(p01);
+  F32x4 p1 = F32x8Hi(p01);
+  F32x4 p2 = F32x8Lo(p23);
+  F32x4 p3 = F32x8Hi(p23);
+  F32x4Transpose(&p0, &p1, &p2, &p3);
+  F32x4 acc = F32x4Add(F32x4Add(p0, p1), F32x4Add(p2, p3));
+#else
+  // Columns of a scaled by the broadcast components of b.
+  F32x4 c0 = F32x4Load(as);
+  F32x4 c1 = F32x4Load(as + 4);
+  F32x4 c2 = F32x4Load(as + 8);
+  F32x4 c3 = F32x4Load(as + 12);
+  F32x4Transpose(&c0, &c1, &c2, &c3);
+  F32x4 acc = F32x4Mul(c0, F32x4Swizzle(v, 0, 0, 0, 0));
+  acc = F32x4MulAdd(c1, F32x4Swizzle(v, 1, 1, 1, 1), acc);
+  acc = F32x4MulAdd(c2, F32x4Swizzle(v, 2, 2, 2, 2), acc);
+  acc = F32x4MulAdd(c3, F32x4Swizzle(v, 3, 3, 3, 3), acc);
+#endif
+
+  return acc;
+}
 
-  r.yx = a.yx * b.xx + a.yy * b.yx + a.yz * b.zx + a.yw * b.wx;
-  r.yy = a.yx * b.xy + a.yy * b.yy + a.yz * b.zy + a.yw * b.wy;
-  r.yz = a.yx * b.xz + a.yy * b.yz + a.yz * b.zz + a.yw * b.wz;
-  r.yw = a.yx * b.xw + a.yy * b.yw + a.yz * b.zw + a.yw * b.ww;
+XMATH_API Vec4 Mat4MulVec4(const Mat4 a, const Vec4 b) {
+  Vec4 r;
+  F32x4Store(&r.x, Mat4MulVec4Lanes(&a.xx, F32x4LoadHalves(&b.x)));
+  return r;
+}
 
-  r.zx = a.zx * b.xx + a.zy * b.yx + a.zz * b.zx + a.zw * b.wx;
-  r.zy = a.zx * b.xy + a.zy * b.yy + a.zz * b.zy + a.zw * b.wy;
-  r.zz = a.zx * b.xz + a.zy * b.yz + a.zz * b.zz + a.zw * b.wz;
-  r.zw = a.zx * b.xw + a.zy * b.yw + a.zz * b.zw + a.zw * b.ww;
+XMATH_API void Mat4MulVec4To(Vec4* XMATH_RESTRICT out,
+                             const Mat4* a,
+                             const Vec4* b) {
+  F32x4Store(&out->x, Mat4MulVec4Lanes(&a->xx, F32x4Load(&b->x)));
+}
 
-  r.wx = a.wx * b.xx + a.wy * b.yx + a.wz * b.zx + a.ww * b.wx;
-  r.wy = a.wx * b.xy + a.wy * b.yy + a.wz * b.zy + a.ww * b.wy;
-  r.wz = a.wx * b.xz + a.wy * b.yz + a.wz * b.zz + a.ww * b.wz;
-  r.ww = a.wx * b.xw + a.wy * b.yw + a.wz * b.zw + a.ww * b.ww;
+XMATH_API void Mat4MulVec4Array(Vec4* out,
+                                const Mat4* m,
+                                const Vec4* in,
+                                size_t count) {
+  assert(m != NULL);
+  assert(count == 0 || (in != NULL && out != NULL));
+  DispatchMat4MulVec4Array(out, m, in, count);
+}
 
-  return r;
+XMATH_API void Mat4MulPoint3Array(Vec3* out,
+                                  const Mat4* m,
+                                  const Vec3* in,
+                                  size_t count) {
+  assert(m != NULL);
+  assert(count == 0 || (in != NULL && out != NULL));
+
+  // Same as Mat4MulVec4Array with w = 1, the w column becomes the start of
+  // the sum.
+  F32x8 c[4];
+  BatchMat4Columns8(m, c);
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    F32x8 v = F32x8Combine(F32x4Load3(&in[i].x), F32x4Load3(&in[i + 1].x));
+    F32x8 acc = F32x8MulAdd(c[0], F32x8SplatLane(v, 0), c[3]);
+    acc = F32x8MulAdd(c[1], F32x8SplatLane(v, 1), acc);
+    acc = F32x8MulAdd(c[2], F32x8SplatLane(v, 2), acc);
+    F32x4Store3(&out[i].x, F32x8Lo(acc));
+    F32x4Store3(&out[i + 1].x, F32x8Hi(acc));
+  }
+
+  if (i < count) {
+    F32x4 v = F32x4Load3(&in[i].x);
+    F32x4 acc =
+        F32x4MulAdd(F32x8Lo(c[0]), F32x4Swizzle(v, 0, 0, 0, 0), F32x8Lo(c[3]));
+    acc = F32x4MulAdd(F32x8Lo(c[1]), F32x4Swizzle(v, 1, 1, 1, 1), acc);
+    acc = F32x4MulAdd(F32x8Lo(c[2]), F32x4Swizzle(v, 2, 2, 2, 2), acc);
+    F32x4Store3(&out[i].x, acc);
+  }
 }
 
-Vec4 Mat4MulVec4(const Mat4 a, const Vec4 b) {
-  Vec4 r;
+XMATH_API void Mat4MulDir3Array(Vec3* out,
+                                const Mat4* m,
+                                const Vec3* in,
+                                size_t count) {
+  assert(m != NULL);
+  assert(count == 0 || (in != NULL && out != NULL));
+
+  F32x8 c[4];
+  BatchMat4Columns8(m, c);
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    F32x8 v = F32x8Combine(F32x4Load3(&in[i].x), F32x4Load3(&in[i + 1].x));
+    F32x8 acc = F32x8Mul(c[0], F32x8SplatLane(v, 0));
+    acc = F32x8MulAdd(c[1], F32x8SplatLane(v, 1), acc);
+    acc = F32x8MulAdd(c[2], F32x8SplatLane(v, 2), acc);
+    F32x4Store3(&out[i].x, F32x8Lo(acc));
+    F32x4Store3(&out[i + 1].x, F32x8Hi(acc));
+  }
 
-  r.x = a.xx * b.x + a.xy * b.y + a.xz * b.z + a.xw * b.w;
-  r.y = a.yx * b.x + a.yy * b.y + a.yz * b.z + a.yw * b.w;
-  r.z = a.zx * b.x + a.zy * b.y + a.zz * b.z + a.zw * b.w;
-  r.w = a.wx * b.x + a.wy * b.y + a.wz * b.z + a.ww * b.w;
+  if (i < count) {
+    F32x4 v = F32x4Load3(&in[i].x);
+    F32x4 acc = F32x4Mul(F32x8Lo(c[0]), F32x4Swizzle(v, 0, 0, 0, 0));
+    acc = F32x4MulAdd(F32x8Lo(c[1]), F32x4Swizzle(v, 1, 1, 1, 1), acc);
+    acc = F32x4MulAdd(F32x8Lo(c[2]), F32x4Swizzle(v, 2, 2, 2, 2), acc);
+    F32x4Store3(&out[i].x, acc);
+  }
+}
 
-  return r;
+XMATH_API void Mat4MulVec4Strided(Vec4* out,
+                                  size_t outStride,
+                                  const Mat4* m,
+                                  const Vec4* in,
+                                  size_t inStride,
+                                  size_t count) {
+  assert(m != NULL);
+  assert(count == 0 || (in != NULL && out != NULL));
+  DispatchMat4MulVec4Strided(out, outStride, m, in, inStride, count);
 }
 
-Mat4 Mat4MakeOrtho(float l, float r, float b, float t, float n, float f) {
+XMATH_API Mat4 Mat4MakeOrtho(float l,
+                             float r,
+                             float b,
+                             float t,
+                             float n,
+                             float f) {
   Mat4 m = Mat4Zero;
 
   m.xx = 2.0f / (r - l);
@@ -248,7 +413,7 @@ Mat4 Mat4MakeOrtho(float l, float r, float b, float t, float n, float f) {
   return m;
 }
 
-Mat4 Mat4MakePerspective(float fov, float aspect, float n, float f) {
+XMATH_API Mat4 Mat4MakePerspective(float fov, float aspect, float n, float f) {
   Mat4 m = Mat4Zero;
   float const e = 1.0f / tanf(FDeg2Rad(fov) / 2.0f);
 
@@ -274,7 +439,7 @@ Mat4 Mat4MakePerspective(float fov, float aspect, float n, float f) {
   return m;
 }
 
-Mat4 Mat4LookAt(Vec3 position, Vec3 target, Vec3 up) {
+XMATH_API Mat4 Mat4LookAt(Vec3 position, Vec3 target, Vec3 up) {
   Mat4 m = Mat4Identity;
   Vec3 f = Vec3Norm(Vec3Sub(position, target));
   Vec3 u = Vec3Norm(up);
@@ -1,47 +1,28 @@
 /**
  * @file mat4.h
  * @brief Definitions, functions and utilities for 4x4 matrices.
+ *
+ * The functions taking and returning Mat4 by value have a `...To` variant
+ * taking pointers, so 64 byte matrices are not copied around on every call.
+ * Their output is `XMATH_RESTRICT`: out must not be (or overlap) any input,
+ * use the by value function when a result replaces one of its operands.
  */
 #ifndef XMATH_MAT4_H
 #define XMATH_MAT4_H
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "api.h"
+#include "mat4_type.h"
 #include "vec3.h"
 #include "vec4.h"
-// clang-format off
-
-/**
- * @brief Square matrix of 4x4 elements.
- */
-typedef struct {
-  float xx, xy, xz, xw;
-  float yx, yy, yz, yw;
-  float zx, zy, zz, zw;
-  float wx, wy, wz, ww;
-} Mat4;
-
-//! @brief a Mat4 full of zeroes.
-static const Mat4 Mat4Zero = {
-  0.0f, 0.0f, 0.0f, 0.0f,
-  0.0f, 0.0f, 0.0f, 0.0f,
-  0.0f, 0.0f, 0.0f, 0.0f,
-  0.0f, 0.0f, 0.0f, 0.0f,
-};
-
-//! @brief an identity form of Mat4.
-static const Mat4 Mat4Identity = {
-  1.0f, 0.0f, 0.0f, 0.0f,
-  0.0f, 1.0f, 0.0f, 0.0f,
-  0.0f, 0.0f, 1.0f, 0.0f,
-  0.0f, 0.0f, 0.0f, 1.0f,
-};
-// clang-format on
 
 /**
  * @brief Get the consecutive floating values from a Mat4.
  * @param m reference of the matrix.
  * @return The address of first component of first column.
  */
-float* Mat4Floats(Mat4* m);
+XMATH_API float* Mat4Floats(Mat4* m);
 
 /**
  * @brief Compare the elements of two matrices and return if they are approx
@@ -50,7 +31,7 @@ float* Mat4Floats(Mat4* m);
  * @param b second matrix.
  * @return true if a elements are near b elements.
  */
-bool Mat4EqualApprox(Mat4 a, Mat4 b);
+XMATH_API bool Mat4EqualApprox(Mat4 a, Mat4 b);
 
 /**
  * \brief Gets a matrix row by its index.
@@ -59,7 +40,7 @@ bool Mat4EqualApprox(Mat4 a, Mat4 b);
  * \param int i, row index, between 0 and 3. Warning: do not use quantities
  * outside range. \return a Vec4 containing the full row.
  */
-Vec4 Mat4Row(Mat4 m, unsigned int i);
+XMATH_API Vec4 Mat4Row(Mat4 m, unsigned int i);
 
 /**
  * \brief Gets a matrix column by its index.
@@ -68,7 +49,7 @@ Vec4 Mat4Row(Mat4 m, unsigned int i);
  * \param int i, column index, between 0 and 3. Warning: do not use quantities
  * outside range. \return a Vec4 containing the full column.
  */
-Vec4 Mat4Col(Mat4 m, unsigned int i);
+XMATH_API Vec4 Mat4Col(Mat4 m, unsigned int i);
 
 /**
  * \brief Transposes a matrix.
@@ -76,7 +57,15 @@ Vec4 Mat4Col(Mat4 m, unsigned int i);
  * \param Mat4 m matrix to be transposed (not modified).
  * \return transposed matrix.
  */
-Mat4 Mat4Transpose(Mat4 m);
+XMATH_API Mat4 Mat4Transpose(Mat4 m);
+
+/**
+ * \brief Transposes a matrix into out.
+ *
+ * \param Mat4* out transposed matrix, must not be m.
+ * \param const Mat4* m matrix to be transposed (not modified).
+ */
+XMATH_API void Mat4TransposeTo(Mat4* XMATH_RESTRICT out, const Mat4* m);
 
 /**
  * \brief Get the inverse of a matrix.
@@ -85,7 +74,81 @@ Mat4 Mat4Transpose(Mat4 m);
  * \param Mat4 m matrix to be inverted (not modified).
  * \return true if the matrix can be inverted, false otherwise.
  */
-bool Mat4Invert(Mat4* result, Mat4 m);
+XMATH_API bool Mat4Invert(Mat4* result, Mat4 m);
+
+/**
+ * \brief Tolerance of Mat4Classify on the length and perpendicularity of the
+ * basis rows of a rigid matrix.
+ */
+#define XMATH_MAT4_RIGID_EPSILON (0.00001f)
+
+/**
+ * \brief Kinds of matrices with a cheaper inverse.
+ *
+ * Affine and rigid matrices follow the layout of TransformToMat4 and
+ * Mat4LookAt: the basis in the xyz part of the first three rows, the
+ * translation in wx, wy and wz, and (0, 0, 0, 1) as the last column.
+ */
+typedef enum {
+  Mat4ClassGeneral,  //!< Any matrix, projections included.
+  Mat4ClassAffine,   //!< Last column is exactly (0, 0, 0, 1).
+  Mat4ClassRigid,    //!< Affine with an orthonormal basis.
+} Mat4Class;
+
+/**
+ * \brief Finds the cheapest kind of inverse valid for a matrix.
+ *
+ * \param const Mat4* m matrix to classify (not modified).
+ * \return Mat4ClassRigid, Mat4ClassAffine or Mat4ClassGeneral.
+ */
+XMATH_API Mat4Class Mat4Classify(const Mat4* m);
+
+/**
+ * \brief Inverts an affine matrix: a 3x3 inverse plus the translation.
+ *
+ * The last column of m is assumed to be (0, 0, 0, 1), see Mat4Class.
+ * \param Mat4* out inverse of m, must not be m.
+ * \param const Mat4* m matrix to be inverted (not modified).
+ * \return true if the matrix can be inverted, false otherwise.
+ */
+XMATH_API bool Mat4InvertAffine(Mat4* XMATH_RESTRICT out, const Mat4* m);
+
+/**
+ * \brief Inverts a rigid matrix: a 3x3 transpose plus the translation.
+ *
+ * The basis of m is assumed to be orthonormal and its last column to be
+ * (0, 0, 0, 1), see Mat4Class.
+ * \param Mat4* out inverse of m, must not be m.
+ * \param const Mat4* m matrix to be inverted (not modified).
+ */
+XMATH_API void Mat4InvertRigid(Mat4* XMATH_RESTRICT out, const Mat4* m);
+
+/**
+ * \brief Inverts a matrix with the cheapest path Mat4Classify allows.
+ *
+ * \param Mat4* out inverse of m, must not be m.
+ * \param const Mat4* m matrix to be inverted (not modified).
+ * \return true if the matrix can be inverted, false otherwise.
+ */
+XMATH_API bool Mat4InvertFast(Mat4* XMATH_RESTRICT out, const Mat4* m);
+
+/**
+ * \brief Inverts an array of general matrices.
+ *
+ * Same as Mat4Invert on every element, but the matrices are inverted eight
+ * at a time, one per SIMD lane. Singular matrices are left unchanged in out
+ * and reported through okMask instead of a bool per matrix.
+ * \param Mat4* out destination of count matrices, can be the same as in.
+ * \param const Mat4* in source of count matrices.
+ * \param uint32_t* okMask (count + 31) / 32 words, bit i % 32 of word i / 32
+ * is set when matrix i was inverted. Can be NULL.
+ * \param size_t count number of matrices.
+ * \return true if every matrix was inverted.
+ */
+XMATH_API bool Mat4InvertArray(Mat4* out,
+                               const Mat4* in,
+                               uint32_t* okMask,
+                               size_t count);
 
 /**
  * \brief Adds two matrices.
@@ -93,7 +156,17 @@ bool Mat4Invert(Mat4* result, Mat4 m);
  * \param Mat4 b right operand.
  * \return a new stack matrix with a+b components result.
  */
-Mat4 Mat4Add(Mat4 a, Mat4 b);
+XMATH_API Mat4 Mat4Add(Mat4 a, Mat4 b);
+
+/**
+ * \brief Adds two matrices into out.
+ * \param Mat4* out a+b, must not be a or b.
+ * \param const Mat4* a left operand.
+ * \param const Mat4* b right operand.
+ */
+XMATH_API void Mat4AddTo(Mat4* XMATH_RESTRICT out,
+                         const Mat4* a,
+                         const Mat4* b);
 
 /**
  * \brief Substracts two matrices.
@@ -101,7 +174,17 @@ Mat4 Mat4Add(Mat4 a, Mat4 b);
  * \param Mat4 b right operand.
  * \return a new stack matrix with a-b components result.
  */
-Mat4 Mat4Sub(Mat4 a, Mat4 b);
+XMATH_API Mat4 Mat4Sub(Mat4 a, Mat4 b);
+
+/**
+ * \brief Substracts two matrices into out.
+ * \param Mat4* out a-b, must not be a or b.
+ * \param const Mat4* a left operand.
+ * \param const Mat4* b right operand.
+ */
+XMATH_API void Mat4SubTo(Mat4* XMATH_RESTRICT out,
+                         const Mat4* a,
+                         const Mat4* b);
 
 /**
  * \brief Scales a matrix by a scalar factor.
@@ -109,7 +192,15 @@ Mat4 Mat4Sub(Mat4 a, Mat4 b);
  * \param float s scalar factor.
  * \return new stack scaled matrix.
  */
-Mat4 Mat4Scale(Mat4 a, float s);
+XMATH_API Mat4 Mat4Scale(Mat4 a, float s);
+
+/**
+ * \brief Scales a matrix by a scalar factor into out.
+ * \param Mat4* out scaled matrix, must not be a.
+ * \param const Mat4* a matrix to scale.
+ * \param float s scalar factor.
+ */
+XMATH_API void Mat4ScaleTo(Mat4* XMATH_RESTRICT out, const Mat4* a, float s);
 
 /**
  * \brief Multiplies two matrices.
@@ -117,12 +208,96 @@ Mat4 Mat4Scale(Mat4 a, float s);
  * \param Mat4 b right operand.
  * \return a result of multiplication between axb.
  */
-Mat4 Mat4Mul(Mat4 a, Mat4 b);
+XMATH_API Mat4 Mat4Mul(Mat4 a, Mat4 b);
+
+/**
+ * \brief Multiplies two matrices into out.
+ * \param Mat4* out axb, must not be a or b.
+ * \param const Mat4* a left operand.
+ * \param const Mat4* b right operand.
+ */
+XMATH_API void Mat4MulTo(Mat4* XMATH_RESTRICT out,
+                         const Mat4* a,
+                         const Mat4* b);
 
 /**
  * \brief Multiplies a vector with a matrix.
  */
-Vec4 Mat4MulVec4(Mat4 a, Vec4 b);
+XMATH_API Vec4 Mat4MulVec4(Mat4 a, Vec4 b);
+
+/**
+ * \brief Multiplies a vector with a matrix into out.
+ * \param Vec4* out result, must not be b.
+ * \param const Mat4* a matrix.
+ * \param const Vec4* b vector.
+ */
+XMATH_API void Mat4MulVec4To(Vec4* XMATH_RESTRICT out,
+                             const Mat4* a,
+                             const Vec4* b);
+
+/**
+ * \brief Multiplies an array of vectors with a matrix.
+ *
+ * Same as calling Mat4MulVec4 on every element, the matrix is read once.
+ * \param Vec4* out destination of count vectors, can be the same as in.
+ * \param const Mat4* m matrix to apply.
+ * \param const Vec4* in source of count vectors.
+ * \param size_t count number of vectors.
+ */
+XMATH_API void Mat4MulVec4Array(Vec4* out,
+                                const Mat4* m,
+                                const Vec4* in,
+                                size_t count);
+
+/**
+ * \brief Multiplies an array of points with a matrix.
+ *
+ * Every point is taken as a Vec4 with w = 1 and the resulting w is dropped,
+ * no perspective division is done.
+ * \param Vec3* out destination of count points, can be the same as in.
+ * \param const Mat4* m matrix to apply.
+ * \param const Vec3* in source of count points.
+ * \param size_t count number of points.
+ */
+XMATH_API void Mat4MulPoint3Array(Vec3* out,
+                                  const Mat4* m,
+                                  const Vec3* in,
+                                  size_t count);
+
+/**
+ * \brief Multiplies an array of directions with a matrix.
+ *
+ * Every direction is taken as a Vec4 with w = 0, so translation is ignored.
+ * \param Vec3* out destination of count directions, can be the same as in.
+ * \param const Mat4* m matrix to apply.
+ * \param const Vec3* in source of count directions.
+ * \param size_t count number of directions.
+ */
+XMATH_API void Mat4MulDir3Array(Vec3* out,
+                                const Mat4* m,
+                                const Vec3* in,
+                                size_t count);
+
+/**
+ * \brief Multiplies a strided array of vectors with a matrix.
+ *
+ * Element i is read from `(char*)in + i * inStride` and written into
+ * `(char*)out + i * outStride`, so fields of interleaved vertex structs can
+ * be transformed where they are. out can be the same as in when both use the
+ * same stride.
+ * \param Vec4* out address of the first destination vector.
+ * \param size_t outStride distance in bytes between destination vectors.
+ * \param const Mat4* m matrix to apply.
+ * \param const Vec4* in address of the first source vector.
+ * \param size_t inStride distance in bytes between source vectors.
+ * \param size_t count number of vectors.
+ */
+XMATH_API void Mat4MulVec4Strided(Vec4* out,
+                                  size_t outStride,
+                                  const Mat4* m,
+                                  const Vec4* in,
+                                  size_t inStride,
+                                  size_t count);
 
 /**
  * \brief Makes a new ortho matrix.
@@ -138,7 +313,12 @@ Vec4 Mat4MulVec4(Mat4 a, Vec4 b);
  * \param float f far
  * \return a othographic projection matrix.
  */
-Mat4 Mat4MakeOrtho(float l, float r, float b, float t, float n, float f);
+XMATH_API Mat4 Mat4MakeOrtho(float l,
+                             float r,
+                             float b,
+                             float t,
+                             float n,
+                             float f);
 
 /**
  * \brief Makes a new perspective matrix.
@@ -151,7 +331,7 @@ Mat4 Mat4MakeOrtho(float l, float r, float b, float t, float n, float f);
  * \param float f far
  * \return a prerspective projection matrix.
  */
-Mat4 Mat4MakePerspective(float fov, float aspect, float n, float f);
+XMATH_API Mat4 Mat4MakePerspective(float fov, float aspect, float n, float f);
 
 /**
  * \brief Makes a new "looking at" matrix.
@@ -160,6 +340,10 @@ Mat4 Mat4MakePerspective(float fov, float aspect, float n, float f);
  * \param float target to look at
  * \param float up
  */
-Mat4 Mat4LookAt(Vec3 position, Vec3 target, Vec3 up);
+XMATH_API Mat4 Mat4LookAt(Vec3 position, Vec3 target, Vec3 up);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "mat4.c"
+#endif
 
 #endif
@@ -5,6 +5,9 @@
 #include <cmocka.h>
 // clang-format on
 
+#include <math.h>
+#include <stdint.h>
+
 #include "common_testing.h"
 
 #include "mat4.h"
@@ -57,6 +60,9 @@ static void test_Mat4Transpose(void** state) {
       1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f,
   };
   assert_true(Mat4EqualApprox(t1, expected));
+
+  Mat4TransposeTo(&t1, &o);
+  assert_true(Mat4EqualApprox(t1, expected));
 }
 
 static void test_Mat4Add(void** state) {
@@ -79,6 +85,10 @@ static void test_Mat4Add(void** state) {
 
   Mat4 r = Mat4Add(a, b);
   assert_true(Mat4EqualApprox(r, e));
+
+  r = Mat4Zero;
+  Mat4AddTo(&r, &a, &b);
+  assert_true(Mat4EqualApprox(r, e));
 }
 
 static void test_Mat4Sub(void** state) {
@@ -97,6 +107,10 @@ static void test_Mat4Sub(void** state) {
   Mat4 e = b;
   Mat4 r = Mat4Sub(a, b);
   assert_true(Mat4EqualApprox(r, e));
+
+  r = Mat4Zero;
+  Mat4SubTo(&r, &a, &b);
+  assert_true(Mat4EqualApprox(r, e));
 }
 
 static void test_Mat4Scale(void** state) {
@@ -110,6 +124,10 @@ static void test_Mat4Scale(void** state) {
 
   Mat4 r = Mat4Scale(a, 2.0f);
   assert_true(Mat4EqualApprox(r, e));
+
+  r = Mat4Zero;
+  Mat4ScaleTo(&r, &a, 2.0f);
+  assert_true(Mat4EqualApprox(r, e));
 }
 
 static void test_Mat4Mul(void** state) {
@@ -147,6 +165,36 @@ static void test_Mat4Mul(void** state) {
 
   r = Mat4Mul(a, b);
   assert_true(Mat4EqualApprox(r, e));
+
+  // clang-format off
+  a = (Mat4){
+     1.0f,  2.0f,  3.0f,  4.0f,
+     5.0f,  6.0f,  7.0f,  8.0f,
+     9.0f, 10.0f, 11.0f, 12.0f,
+    13.0f, 14.0f, 15.0f, 16.0f,
+  };
+
+  b = (Mat4){
+    2.0f, 0.0f, 1.0f, 0.0f,
+    0.0f, 1.0f, 0.0f, 3.0f,
+    1.0f, 0.0f, 0.0f, 1.0f,
+    0.0f, 2.0f, 1.0f, 0.0f,
+  };
+
+  e = (Mat4) {
+     5.0f, 10.0f,  5.0f,  9.0f,
+    17.0f, 22.0f, 13.0f, 25.0f,
+    29.0f, 34.0f, 21.0f, 41.0f,
+    41.0f, 46.0f, 29.0f, 57.0f,
+  };
+  // clang-format on
+
+  r = Mat4Mul(a, b);
+  assert_true(Mat4EqualApprox(r, e));
+
+  r = Mat4Zero;
+  Mat4MulTo(&r, &a, &b);
+  assert_true(Mat4EqualApprox(r, e));
 }
 
 static void test_Mat4MulVec4(void** state) {
@@ -173,6 +221,138 @@ static void test_Mat4MulVec4(void** state) {
 
   r = Mat4MulVec4(a, b);
   assert_true(Vec4EqualApprox(r, e));
+
+  // clang-format off
+  a = (Mat4){
+     1.0f,  2.0f,  3.0f,  4.0f,
+     5.0f,  6.0f,  7.0f,  8.0f,
+     9.0f, 10.0f, 11.0f, 12.0f,
+    13.0f, 14.0f, 15.0f, 16.0f,
+  };
+  // clang-format on
+
+  b = (Vec4){1.0f, -1.0f, 2.0f, 0.5f};
+  e = (Vec4){7.0f, 17.0f, 27.0f, 37.0f};
+
+  r = Mat4MulVec4(a, b);
+  assert_true(Vec4EqualApprox(r, e));
+
+  r = Vec4Zero;
+  Mat4MulVec4To(&r, &a, &b);
+  assert_true(Vec4EqualApprox(r, e));
+}
+
+static void test_Mat4MulVec4Array(void** state) {
+  UNUSED(state);
+
+  // clang-format off
+  Mat4 m = {
+     1.0f,  2.0f,  3.0f,  4.0f,
+     5.0f,  6.0f,  7.0f,  8.0f,
+     9.0f, 10.0f, 11.0f, 12.0f,
+    13.0f, 14.0f, 15.0f, 16.0f,
+  };
+  // clang-format on
+
+  Vec4 in[5];
+  Vec4 out[5];
+  for (unsigned i = 0; i < 5; i++) {
+    in[i] = (Vec4){(float)i, -1.0f, 0.5f * (float)i, 1.0f - (float)i};
+  }
+
+  Mat4MulVec4Array(out, &m, in, 5);
+  for (unsigned i = 0; i < 5; i++) {
+    assert_true(Vec4EqualApprox(out[i], Mat4MulVec4(m, in[i])));
+  }
+
+  // In place.
+  Mat4MulVec4Array(in, &m, in, 5);
+  for (unsigned i = 0; i < 5; i++) {
+    assert_true(Vec4EqualApprox(in[i], out[i]));
+  }
+}
+
+static void test_Mat4MulPoint3Array(void** state) {
+  UNUSED(state);
+
+  // clang-format off
+  Mat4 m = {
+    0.0f, -1.0f, 0.0f, 1.0f,
+    1.0f,  0.0f, 0.0f, 2.0f,
+    0.0f,  0.0f, 2.0f, 3.0f,
+    0.0f,  0.0f, 0.0f, 1.0f,
+  };
+  // clang-format on
+
+  Vec3 in[3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 2.0f, 3.0f}};
+  Vec3 e[3] = {{1.0f, 3.0f, 3.0f}, {0.0f, 2.0f, 3.0f}, {-1.0f, 3.0f, 9.0f}};
+  Vec3 out[3];
+
+  Mat4MulPoint3Array(out, &m, in, 3);
+  for (unsigned i = 0; i < 3; i++) {
+    assert_true(Vec3EqualApprox(out[i], e[i]));
+  }
+
+  // In place.
+  Mat4MulPoint3Array(in, &m, in, 3);
+  for (unsigned i = 0; i < 3; i++) {
+    assert_true(Vec3EqualApprox(in[i], e[i]));
+  }
+}
+
+static void test_Mat4MulDir3Array(void** state) {
+  UNUSED(state);
+
+  // clang-format off
+  Mat4 m = {
+    0.0f, -1.0f, 0.0f, 1.0f,
+    1.0f,  0.0f, 0.0f, 2.0f,
+    0.0f,  0.0f, 2.0f, 3.0f,
+    0.0f,  0.0f, 0.0f, 1.0f,
+  };
+  // clang-format on
+
+  Vec3 in[3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 2.0f, 3.0f}};
+  Vec3 e[3] = {{0.0f, 1.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}, {-2.0f, 1.0f, 6.0f}};
+  Vec3 out[3];
+
+  Mat4MulDir3Array(out, &m, in, 3);
+  for (unsigned i = 0; i < 3; i++) {
+    assert_true(Vec3EqualApprox(out[i], e[i]));
+  }
+}
+
+static void test_Mat4MulVec4Strided(void** state) {
+  UNUSED(state);
+
+  typedef struct {
+    Vec4 position;
+    Vec4 color;
+  } Vertex;
+
+  // clang-format off
+  Mat4 m = {
+     1.0f,  2.0f,  3.0f,  4.0f,
+     5.0f,  6.0f,  7.0f,  8.0f,
+     9.0f, 10.0f, 11.0f, 12.0f,
+    13.0f, 14.0f, 15.0f, 16.0f,
+  };
+  // clang-format on
+
+  Vertex vertices[3];
+  Vec4 e[3];
+  for (unsigned i = 0; i < 3; i++) {
+    Vec4 p = {(float)i, -1.0f, 0.5f * (float)i, 1.0f};
+    vertices[i] = (Vertex){p, Vec4One};
+    e[i] = Mat4MulVec4(m, p);
+  }
+
+  Mat4MulVec4Strided(&vertices[0].position, sizeof(Vertex), &m,
+                     &vertices[0].position, sizeof(Vertex), 3);
+  for (unsigned i = 0; i < 3; i++) {
+    assert_true(Vec4EqualApprox(vertices[i].position, e[i]));
+    assert_true(Vec4EqualApprox(vertices[i].color, Vec4One));
+  }
 }
 
 static void test_Mat4MakeOrtho(void** state) {
@@ -297,6 +477,138 @@ static void test_Mat4Inverse(void** state) {
 
   assert_true(Mat4Invert(&r, a));
   assert_true(Mat4EqualApprox(r, e));
+
+  // A matrix without any symmetry, checked through a * a^-1.
+  // clang-format off
+  a = (Mat4){
+     0.5f, 0.1f, -0.2f,  0.3f,
+     0.0f, 0.9f,  0.4f, -0.1f,
+     0.2f, 0.3f,  0.7f,  0.5f,
+    -0.4f, 0.1f,  0.2f,  1.0f,
+  };
+  // clang-format on
+
+  assert_true(Mat4Invert(&r, a));
+  assert_true(Mat4EqualApprox(Mat4Mul(a, r), Mat4Identity));
+  assert_true(Mat4EqualApprox(Mat4Mul(r, a), Mat4Identity));
+
+  assert_false(Mat4Invert(&r, Mat4Zero));
+}
+
+static void test_Mat4Classify(void** state) {
+  UNUSED(state);
+
+  Mat4 a = Mat4LookAt((Vec3){1.0f, 2.0f, 3.0f}, Vec3Zero, Vec3Up);
+  assert_int_equal(Mat4Classify(&Mat4Identity), Mat4ClassRigid);
+  assert_int_equal(Mat4Classify(&a), Mat4ClassRigid);
+
+  a.yy *= 2.0f;
+  assert_int_equal(Mat4Classify(&a), Mat4ClassAffine);
+
+  a = Mat4MakePerspective(60.0f, 1.5f, 0.1f, 10.0f);
+  assert_int_equal(Mat4Classify(&a), Mat4ClassGeneral);
+}
+
+static void test_Mat4InvertAffine(void** state) {
+  UNUSED(state);
+
+  // clang-format off
+  Mat4 a = {
+     0.5f, 0.1f, -0.2f, 0.0f,
+     0.0f, 0.9f,  0.4f, 0.0f,
+     0.2f, 0.3f,  0.7f, 0.0f,
+    -0.4f, 0.1f,  0.2f, 1.0f,
+  };
+  // clang-format on
+
+  Mat4 e;
+  Mat4 r;
+  assert_true(Mat4Invert(&e, a));
+  assert_true(Mat4InvertAffine(&r, &a));
+  assert_true(Mat4EqualApprox(r, e));
+
+  a.xx = 0.0f;
+  a.xy = 0.0f;
+  a.xz = 0.0f;
+  assert_false(Mat4InvertAffine(&r, &a));
+}
+
+static void test_Mat4InvertRigid(void** state) {
+  UNUSED(state);
+
+  Mat4 a = Mat4LookAt((Vec3){1.0f, 2.0f, 3.0f}, (Vec3){0.5f, 0.0f, 0.0f},
+                      Vec3Up);
+  Mat4 e;
+  Mat4 r;
+  assert_true(Mat4Invert(&e, a));
+  Mat4InvertRigid(&r, &a);
+  assert_true(Mat4EqualApprox(r, e));
+}
+
+static void test_Mat4InvertFast(void** state) {
+  UNUSED(state);
+
+  Mat4 r;
+  Mat4 e;
+  Mat4 a = Mat4LookAt((Vec3){1.0f, 2.0f, 3.0f}, Vec3Zero, Vec3Up);
+  assert_true(Mat4Invert(&e, a));
+  assert_true(Mat4InvertFast(&r, &a));
+  assert_true(Mat4EqualApprox(r, e));
+
+  a.yy *= 2.0f;
+  assert_true(Mat4Invert(&e, a));
+  assert_true(Mat4InvertFast(&r, &a));
+  assert_true(Mat4EqualApprox(r, e));
+
+  a = Mat4MakePerspective(60.0f, 1.5f, 0.1f, 10.0f);
+  assert_true(Mat4Invert(&e, a));
+  assert_true(Mat4InvertFast(&r, &a));
+  assert_true(Mat4EqualApprox(r, e));
+
+  assert_false(Mat4InvertFast(&r, &Mat4Zero));
+}
+
+static void test_Mat4InvertArray(void** state) {
+  UNUSED(state);
+
+  // Two full blocks of eight and a partial one.
+  enum { count = 19 };
+  Mat4 in[count];
+  Mat4 out[count];
+  uint32_t ok[1] = {0xffffffffu};
+  for (unsigned i = 0; i < count; i++) {
+    float* f = Mat4Floats(&in[i]);
+    for (unsigned e = 0; e < 16; e++) {
+      f[e] = (e % 5 == 0 ? 1.0f : 0.0f) + 0.1f * sinf((float)(i * 16 + e));
+    }
+  }
+  in[3] = Mat4Zero;
+  in[17].zx = 0.0f;
+  in[17].zy = 0.0f;
+  in[17].zz = 0.0f;
+  in[17].zw = 0.0f;
+
+  for (unsigned i = 0; i < count; i++) {
+    out[i] = Mat4Identity;
+  }
+  assert_false(Mat4InvertArray(out, in, ok, count));
+  assert_int_equal(ok[0], ((1u << count) - 1) & ~(1u << 3) & ~(1u << 17));
+  for (unsigned i = 0; i < count; i++) {
+    Mat4 e = Mat4Identity;
+    assert_true(Mat4Invert(&e, in[i]) == (i != 3 && i != 17));
+    assert_true(Mat4EqualApprox(out[i], e));
+  }
+
+  // In place, without mask.
+  in[3] = Mat4Identity;
+  in[17] = Mat4Identity;
+  for (unsigned i = 0; i < count; i++) {
+    Mat4Invert(&out[i], in[i]);
+  }
+  assert_true(Mat4InvertArray(in, in, NULL, count));
+  for (unsigned i = 0; i < count; i++) {
+    assert_true(Mat4EqualApprox(in[i], out[i]));
+  }
 }
 
 int main() {
@@ -312,10 +624,19 @@ int main() {
       cmocka_unit_test(test_Mat4Scale),
       cmocka_unit_test(test_Mat4Mul),
       cmocka_unit_test(test_Mat4MulVec4),
+      cmocka_unit_test(test_Mat4MulVec4Array),
+      cmocka_unit_test(test_Mat4MulPoint3Array),
+      cmocka_unit_test(test_Mat4MulDir3Array),
+      cmocka_unit_test(test_Mat4MulVec4Strided),
       cmocka_unit_test(test_Mat4MakeOrtho),
       cmocka_unit_test(test_Mat4MakePerspective),
       cmocka_unit_test(test_Mat4LookAt),
       cmocka_unit_test(test_Mat4Inverse),
+      cmocka_unit_test(test_Mat4Classify),
+      cmocka_unit_test(test_Mat4InvertAffine),
+      cmocka_unit_test(test_Mat4InvertRigid),
+      cmocka_unit_test(test_Mat4InvertFast),
+      cmocka_unit_test(test_Mat4InvertArray),
   };
   // clang-format on
 
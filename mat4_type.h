@@ -0,0 +1,39 @@
+/**
+ * @file mat4_type.h
+ * @brief The Mat4 type and constants, without the functions of mat4.h.
+ *
+ * batch.h needs the type alone: in header only mode mat4.h also brings the
+ * bodies of mat4.c, which call the batch.h kernels.
+ */
+#ifndef XMATH_MAT4_TYPE_H
+#define XMATH_MAT4_TYPE_H
+// clang-format off
+
+/**
+ * @brief Square matrix of 4x4 elements.
+ */
+typedef struct {
+  float xx, xy, xz, xw;
+  float yx, yy, yz, yw;
+  float zx, zy, zz, zw;
+  float wx, wy, wz, ww;
+} Mat4;
+
+//! @brief a Mat4 full of zeroes.
+static const Mat4 Mat4Zero = {
+  0.0f, 0.0f, 0.0f, 0.0f,
+  0.0f, 0.0f, 0.0f, 0.0f,
+  0.0f, 0.0f, 0.0f, 0.0f,
+  0.0f, 0.0f, 0.0f, 0.0f,
+};
+
+//! @brief an identity form of Mat4.
+static const Mat4 Mat4Identity = {
+  1.0f, 0.0f, 0.0f, 0.0f,
+  0.0f, 1.0f, 0.0f, 0.0f,
+  0.0f, 0.0f, 1.0f, 0.0f,
+  0.0f, 0.0f, 0.0f, 1.0f,
+};
+// clang-format on
+
+#endif /* XMATH_MAT4_TYPE_H */
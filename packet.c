@@ -0,0 +1,171 @@
+#include "packet.h"
+#include "simd.h"
+
+XMATH_API void Vec3x8Load(Vec3x8* r, const Vec3* in) {
+  for (unsigned i = 0; i < XMATH_PACKET_WIDTH; i++) {
+    r->x[i] = in[i].x;
+    r->y[i] = in[i].y;
+    r->z[i] = in[i].z;
+  }
+}
+
+XMATH_API void Vec3x8Store(Vec3* out, const Vec3x8* p) {
+  for (unsigned i = 0; i < XMATH_PACKET_WIDTH; i++) {
+    out[i] = (Vec3){p->x[i], p->y[i], p->z[i]};
+  }
+}
+
+// Four floats structs are transposed in 4x4 blocks.
+static inline void PacketLoad4(float* x,
+                               float* y,
+                               float* z,
+                               float* w,
+                               const float* in) {
+  for (unsigned i = 0; i < XMATH_PACKET_WIDTH; i += 4) {
+    F32x4 r0 = F32x4Load(in + 4 * i);
+    F32x4 r1 = F32x4Load(in + 4 * i + 4);
+    F32x4 r2 = F32x4Load(in + 4 * i + 8);
+    F32x4 r3 = F32x4Load(in + 4 * i + 12);
+    F32x4Transpose(&r0, &r1, &r2, &r3);
+    F32x4Store(x + i, r0);
+    F32x4Store(y + i, r1);
+    F32x4Store(z + i, r2);
+    F32x4Store(w + i, r3);
+  }
+}
+
+static inline void PacketStore4(float* out,
+                                const float* x,
+                                const float* y,
+                                const float* z,
+                                const float* w) {
+  for (unsigned i = 0; i < XMATH_PACKET_WIDTH; i += 4) {
+    F32x4 r0 = F32x4Load(x + i);
+    F32x4 r1 = F32x4Load(y + i);
+    F32x4 r2 = F32x4Load(z + i);
+    F32x4 r3 = F32x4Load(w + i);
+    F32x4Transpose(&r0, &r1, &r2, &r3);
+    F32x4Store(out + 4 * i, r0);
+    F32x4Store(out + 4 * i + 4, r1);
+    F32x4Store(out + 4 * i + 8, r2);
+    F32x4Store(out + 4 * i + 12, r3);
+  }
+}
+
+XMATH_API void Vec4x8Load(Vec4x8* r, const Vec4* in) {
+  PacketLoad4(r->x, r->y, r->z, r->w, &in->x);
+}
+
+XMATH_API void Vec4x8Store(Vec4* out, const Vec4x8* p) {
+  PacketStore4(&out->x, p->x, p->y, p->z, p->w);
+}
+
+XMATH_API void Quatx8Load(Quatx8* r, const Quat* in) {
+  PacketLoad4(r->x, r->y, r->z, r->w, &in->x);
+}
+
+XMATH_API void Quatx8Store(Quat* out, const Quatx8* p) {
+  PacketStore4(&out->x, p->x, p->y, p->z, p->w);
+}
+
+XMATH_API void Mat4x8Load(Mat4x8* r, const Mat4* in) {
+  for (unsigned i = 0; i < XMATH_PACKET_WIDTH; i++) {
+    const float* src = &in[i].xx;
+    for (unsigned e = 0; e < 16; e++) {
+      r->m[e][i] = src[e];
+    }
+  }
+}
+
+XMATH_API void Mat4x8Store(Mat4* out, const Mat4x8* p) {
+  for (unsigned i = 0; i < XMATH_PACKET_WIDTH; i++) {
+    float* dst = &out[i].xx;
+    for (unsigned e = 0; e < 16; e++) {
+      dst[e] = p->m[e][i];
+    }
+  }
+}
+
+XMATH_API void Vec3x8Cross(Vec3x8* r, const Vec3x8* a, const Vec3x8* b) {
+  F32x8 ax = F32x8Load(a->x);
+  F32x8 ay = F32x8Load(a->y);
+  F32x8 az = F32x8Load(a->z);
+  F32x8 bx = F32x8Load(b->x);
+  F32x8 by = F32x8Load(b->y);
+  F32x8 bz = F32x8Load(b->z);
+  F32x8Store(r->x, F32x8Sub(F32x8Mul(ay, bz), F32x8Mul(az, by)));
+  F32x8Store(r->y, F32x8Sub(F32x8Mul(az, bx), F32x8Mul(ax, bz)));
+  F32x8Store(r->z, F32x8Sub(F32x8Mul(ax, by), F32x8Mul(ay, bx)));
+}
+
+XMATH_API void Quatx8Cross(Quatx8* r, const Quatx8* a, const Quatx8* b) {
+  F32x8 ax = F32x8Load(a->x);
+  F32x8 ay = F32x8Load(a->y);
+  F32x8 az = F32x8Load(a->z);
+  F32x8 aw = F32x8Load(a->w);
+  F32x8 bx = F32x8Load(b->x);
+  F32x8 by = F32x8Load(b->y);
+  F32x8 bz = F32x8Load(b->z);
+  F32x8 bw = F32x8Load(b->w);
+
+  F32x8 x = F32x8MulAdd(aw, bx, F32x8Mul(ax, bw));
+  x = F32x8Sub(F32x8MulAdd(ay, bz, x), F32x8Mul(az, by));
+  F32x8 y = F32x8MulAdd(aw, by, F32x8Mul(ay, bw));
+  y = F32x8Sub(F32x8MulAdd(az, bx, y), F32x8Mul(ax, bz));
+  F32x8 z = F32x8MulAdd(aw, bz, F32x8Mul(az, bw));
+  z = F32x8Sub(F32x8MulAdd(ax, by, z), F32x8Mul(ay, bx));
+  F32x8 d = F32x8MulAdd(ax, bx, F32x8MulAdd(ay, by, F32x8Mul(az, bz)));
+  F32x8 w = F32x8Sub(F32x8Mul(aw, bw), d);
+
+  F32x8Store(r->x, x);
+  F32x8Store(r->y, y);
+  F32x8Store(r->z, z);
+  F32x8Store(r->w, w);
+}
+
+XMATH_API void Quatx8TransformVec3x8(Vec3x8* r,
+                                     const Quatx8* q,
+                                     const Vec3x8* v) {
+  F32x8 qx = F32x8Load(q->x);
+  F32x8 qy = F32x8Load(q->y);
+  F32x8 qz = F32x8Load(q->z);
+  F32x8 qw = F32x8Load(q->w);
+  F32x8 vx = F32x8Load(v->x);
+  F32x8 vy = F32x8Load(v->y);
+  F32x8 vz = F32x8Load(v->z);
+
+  // Same expansion as QuatTransformVec3:
+  // i * 2 (i . v) + v * (s^2 - i . i) + (i x v) * 2 s
+  F32x8 two = F32x8Splat(2.0f);
+  F32x8 iv = F32x8MulAdd(qx, vx, F32x8MulAdd(qy, vy, F32x8Mul(qz, vz)));
+  F32x8 ii = F32x8MulAdd(qx, qx, F32x8MulAdd(qy, qy, F32x8Mul(qz, qz)));
+  F32x8 a = F32x8Mul(two, iv);
+  F32x8 b = F32x8Sub(F32x8Mul(qw, qw), ii);
+  F32x8 c = F32x8Mul(two, qw);
+
+  F32x8 cx = F32x8Sub(F32x8Mul(qy, vz), F32x8Mul(qz, vy));
+  F32x8 cy = F32x8Sub(F32x8Mul(qz, vx), F32x8Mul(qx, vz));
+  F32x8 cz = F32x8Sub(F32x8Mul(qx, vy), F32x8Mul(qy, vx));
+
+  F32x8Store(r->x, F32x8MulAdd(cx, c, F32x8MulAdd(vx, b, F32x8Mul(qx, a))));
+  F32x8Store(r->y, F32x8MulAdd(cy, c, F32x8MulAdd(vy, b, F32x8Mul(qy, a))));
+  F32x8Store(r->z, F32x8MulAdd(cz, c, F32x8MulAdd(vz, b, F32x8Mul(qz, a))));
+}
+
+XMATH_API void Mat4x8MulVec4x8(Vec4x8* r, const Mat4x8* m, const Vec4x8* v) {
+  F32x8 vx = F32x8Load(v->x);
+  F32x8 vy = F32x8Load(v->y);
+  F32x8 vz = F32x8Load(v->z);
+  F32x8 vw = F32x8Load(v->w);
+
+  // Row i of every matrix against its own vector, v is fully read first so r
+  // can alias it.
+  float* out[4] = {r->x, r->y, r->z, r->w};
+  for (unsigned i = 0; i < 4; i++) {
+    F32x8 acc = F32x8Mul(F32x8Load(m->m[4 * i]), vx);
+    acc = F32x8MulAdd(F32x8Load(m->m[4 * i + 1]), vy, acc);
+    acc = F32x8MulAdd(F32x8Load(m->m[4 * i + 2]), vz, acc);
+    acc = F32x8MulAdd(F32x8Load(m->m[4 * i + 3]), vw, acc);
+    F32x8Store(out[i], acc);
+  }
+}
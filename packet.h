@@ -0,0 +1,149 @@
+/**
+ * @file packet.h
+ * @brief Eight wide packets of vectors, quaternions and matrices.
+ *
+ * A packet holds eight values lane interleaved: all the x components, then
+ * all the y components and so on. Each component array is eight floats long
+ * (one 256 bit register), so a Vec3x8 spans 96 bytes and a Quatx8 exactly
+ * two cache lines. Custom kernels can be written on top of the packets with
+ * the F32x8 functions of simd.h, e.g. `F32x8Load(p->x)`.
+ */
+#ifndef XMATH_PACKET_H
+#define XMATH_PACKET_H
+#include "api.h"
+#include "mat4.h"
+#include "quat.h"
+#include "vec3.h"
+#include "vec4.h"
+
+//! @brief Number of values held by a packet.
+#define XMATH_PACKET_WIDTH 8
+
+//! @brief Eight Vec3 values.
+typedef struct {
+  _Alignas(32) float x[XMATH_PACKET_WIDTH];
+  float y[XMATH_PACKET_WIDTH];
+  float z[XMATH_PACKET_WIDTH];
+} Vec3x8;
+
+//! @brief Eight Vec4 values.
+typedef struct {
+  _Alignas(32) float x[XMATH_PACKET_WIDTH];
+  float y[XMATH_PACKET_WIDTH];
+  float z[XMATH_PACKET_WIDTH];
+  float w[XMATH_PACKET_WIDTH];
+} Vec4x8;
+
+//! @brief Eight Quat values.
+typedef struct {
+  _Alignas(32) float x[XMATH_PACKET_WIDTH];
+  float y[XMATH_PACKET_WIDTH];
+  float z[XMATH_PACKET_WIDTH];
+  float w[XMATH_PACKET_WIDTH];
+} Quatx8;
+
+/**
+ * @brief Eight Mat4 values.
+ *
+ * Row m[i] holds element i of the matrices in the order of Mat4Floats, so
+ * m[0] are the xx elements, m[1] the xy elements and m[15] the ww elements.
+ */
+typedef struct {
+  _Alignas(32) float m[16][XMATH_PACKET_WIDTH];
+} Mat4x8;
+
+/**
+ * @brief Gather eight vectors into a packet.
+ * @param r destination packet.
+ * @param in array of eight vectors.
+ */
+XMATH_API void Vec3x8Load(Vec3x8* r, const Vec3* in);
+
+/**
+ * @brief Scatter a packet into eight vectors.
+ * @param out array of eight vectors.
+ * @param p source packet (unaffected).
+ */
+XMATH_API void Vec3x8Store(Vec3* out, const Vec3x8* p);
+
+/**
+ * @brief Gather eight vectors into a packet.
+ * @param r destination packet.
+ * @param in array of eight vectors.
+ */
+XMATH_API void Vec4x8Load(Vec4x8* r, const Vec4* in);
+
+/**
+ * @brief Scatter a packet into eight vectors.
+ * @param out array of eight vectors.
+ * @param p source packet (unaffected).
+ */
+XMATH_API void Vec4x8Store(Vec4* out, const Vec4x8* p);
+
+/**
+ * @brief Gather eight quaternions into a packet.
+ * @param r destination packet.
+ * @param in array of eight quaternions.
+ */
+XMATH_API void Quatx8Load(Quatx8* r, const Quat* in);
+
+/**
+ * @brief Scatter a packet into eight quaternions.
+ * @param out array of eight quaternions.
+ * @param p source packet (unaffected).
+ */
+XMATH_API void Quatx8Store(Quat* out, const Quatx8* p);
+
+/**
+ * @brief Gather eight matrices into a packet.
+ * @param r destination packet.
+ * @param in array of eight matrices.
+ */
+XMATH_API void Mat4x8Load(Mat4x8* r, const Mat4* in);
+
+/**
+ * @brief Scatter a packet into eight matrices.
+ * @param out array of eight matrices.
+ * @param p source packet (unaffected).
+ */
+XMATH_API void Mat4x8Store(Mat4* out, const Mat4x8* p);
+
+/**
+ * @brief Cross product lane by lane, same as Vec3Cross.
+ * @param r destination packet, can be a or b.
+ * @param a left packet.
+ * @param b right packet.
+ */
+XMATH_API void Vec3x8Cross(Vec3x8* r, const Vec3x8* a, const Vec3x8* b);
+
+/**
+ * @brief Quaternion product lane by lane, same as QuatCross.
+ * @param r destination packet, can be a or b.
+ * @param a left packet.
+ * @param b right packet.
+ */
+XMATH_API void Quatx8Cross(Quatx8* r, const Quatx8* a, const Quatx8* b);
+
+/**
+ * @brief Rotate vectors lane by lane, same as QuatTransformVec3.
+ * @param r destination packet, can be v.
+ * @param q packet of quaternions.
+ * @param v packet of vectors.
+ */
+XMATH_API void Quatx8TransformVec3x8(Vec3x8* r,
+                                     const Quatx8* q,
+                                     const Vec3x8* v);
+
+/**
+ * @brief Multiply vectors by matrices lane by lane, same as Mat4MulVec4.
+ * @param r destination packet, can be v.
+ * @param m packet of matrices.
+ * @param v packet of vectors.
+ */
+XMATH_API void Mat4x8MulVec4x8(Vec4x8* r, const Mat4x8* m, const Vec4x8* v);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "packet.c"
+#endif
+
+#endif /* XMATH_PACKET_H */
@@ -0,0 +1,148 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "packet.h"
+#include "common_testing.h"
+#include "scalar.h"
+
+static Vec3 gVec3A[XMATH_PACKET_WIDTH];
+static Vec3 gVec3B[XMATH_PACKET_WIDTH];
+static Vec4 gVec4[XMATH_PACKET_WIDTH];
+static Quat gQuatA[XMATH_PACKET_WIDTH];
+static Quat gQuatB[XMATH_PACKET_WIDTH];
+static Mat4 gMat4[XMATH_PACKET_WIDTH];
+
+static void FillInputs(void) {
+  for (unsigned i = 0; i < XMATH_PACKET_WIDTH; i++) {
+    float f = 0.1f * (float)i;
+    gVec3A[i] = (Vec3){f, 1.0f - f, 0.5f * f};
+    gVec3B[i] = (Vec3){-f, 0.25f, f * f};
+    gVec4[i] = (Vec4){f, -f, 1.0f, 0.5f + f};
+    gQuatA[i] = QuatMakeAngleAxis(f, Vec3Norm((Vec3){1.0f, f, 0.5f}));
+    gQuatB[i] = QuatMakeAngleAxis(1.0f - f, Vec3Norm((Vec3){f, 1.0f, -f}));
+    float* m = Mat4Floats(&gMat4[i]);
+    for (unsigned e = 0; e < 16; e++) {
+      m[e] = 0.05f * (float)e - f;
+    }
+  }
+}
+
+static void test_PacketLoadStore(void** state) {
+  UNUSED(state);
+  FillInputs();
+
+  Vec3x8 v3;
+  Vec3 v3out[XMATH_PACKET_WIDTH];
+  Vec3x8Load(&v3, gVec3A);
+  assert_float_equal(v3.y[5], gVec3A[5].y, XMATH_EPSILON);
+  Vec3x8Store(v3out, &v3);
+
+  Vec4x8 v4;
+  Vec4 v4out[XMATH_PACKET_WIDTH];
+  Vec4x8Load(&v4, gVec4);
+  assert_float_equal(v4.w[6], gVec4[6].w, XMATH_EPSILON);
+  Vec4x8Store(v4out, &v4);
+
+  Quatx8 q;
+  Quat qout[XMATH_PACKET_WIDTH];
+  Quatx8Load(&q, gQuatA);
+  assert_float_equal(q.z[2], gQuatA[2].z, XMATH_EPSILON);
+  Quatx8Store(qout, &q);
+
+  Mat4x8 m;
+  Mat4 mout[XMATH_PACKET_WIDTH];
+  Mat4x8Load(&m, gMat4);
+  assert_float_equal(m.m[7][3], gMat4[3].yw, XMATH_EPSILON);
+  Mat4x8Store(mout, &m);
+
+  for (unsigned i = 0; i < XMATH_PACKET_WIDTH; i++) {
+    assert_true(Vec3EqualApprox(v3out[i], gVec3A[i]));
+    assert_true(Vec4EqualApprox(v4out[i], gVec4[i]));
+    assert_true(QuatEqualApprox(qout[i], gQuatA[i]));
+    assert_true(Mat4EqualApprox(mout[i], gMat4[i]));
+  }
+}
+
+static void test_Vec3x8Cross(void** state) {
+  UNUSED(state);
+  FillInputs();
+
+  Vec3x8 a;
+  Vec3x8 b;
+  Vec3 out[XMATH_PACKET_WIDTH];
+  Vec3x8Load(&a, gVec3A);
+  Vec3x8Load(&b, gVec3B);
+  Vec3x8Cross(&a, &a, &b);
+  Vec3x8Store(out, &a);
+  for (unsigned i = 0; i < XMATH_PACKET_WIDTH; i++) {
+    assert_true(Vec3EqualApprox(out[i], Vec3Cross(gVec3A[i], gVec3B[i])));
+  }
+}
+
+static void test_Quatx8Cross(void** state) {
+  UNUSED(state);
+  FillInputs();
+
+  Quatx8 a;
+  Quatx8 b;
+  Quat out[XMATH_PACKET_WIDTH];
+  Quatx8Load(&a, gQuatA);
+  Quatx8Load(&b, gQuatB);
+  Quatx8Cross(&a, &a, &b);
+  Quatx8Store(out, &a);
+  for (unsigned i = 0; i < XMATH_PACKET_WIDTH; i++) {
+    assert_true(QuatEqualApprox(out[i], QuatCross(gQuatA[i], gQuatB[i])));
+  }
+}
+
+static void test_Quatx8TransformVec3x8(void** state) {
+  UNUSED(state);
+  FillInputs();
+
+  Quatx8 q;
+  Vec3x8 v;
+  Vec3 out[XMATH_PACKET_WIDTH];
+  Quatx8Load(&q, gQuatA);
+  Vec3x8Load(&v, gVec3A);
+  Quatx8TransformVec3x8(&v, &q, &v);
+  Vec3x8Store(out, &v);
+  for (unsigned i = 0; i < XMATH_PACKET_WIDTH; i++) {
+    Vec3 e = QuatTransformVec3(gQuatA[i], gVec3A[i]);
+    assert_true(Vec3EqualApprox(out[i], e));
+  }
+}
+
+static void test_Mat4x8MulVec4x8(void** state) {
+  UNUSED(state);
+  FillInputs();
+
+  Mat4x8 m;
+  Vec4x8 v;
+  Vec4 out[XMATH_PACKET_WIDTH];
+  Mat4x8Load(&m, gMat4);
+  Vec4x8Load(&v, gVec4);
+  Mat4x8MulVec4x8(&v, &m, &v);
+  Vec4x8Store(out, &v);
+  for (unsigned i = 0; i < XMATH_PACKET_WIDTH; i++) {
+    assert_true(Vec4EqualApprox(out[i], Mat4MulVec4(gMat4[i], gVec4[i])));
+  }
+}
+
+int main() {
+  UNUSED_TYPE(jmp_buf);
+  UNUSED_TYPE(va_list);
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_PacketLoadStore),
+      cmocka_unit_test(test_Vec3x8Cross),
+      cmocka_unit_test(test_Quatx8Cross),
+      cmocka_unit_test(test_Quatx8TransformVec3x8),
+      cmocka_unit_test(test_Mat4x8MulVec4x8),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,283 @@
+#include "pose.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "scalar.h"
+#include "simd.h"
+
+// Joints processed by every step of the batch loops.
+#define XMATH_POSE_STEP 8
+
+// Streams of a pose: position, rotation and scale components.
+#define XMATH_POSE_STREAMS 10
+
+static inline size_t PoseSoARoundUp(size_t count, size_t width) {
+  return (count + width - 1) / width * width;
+}
+
+static inline void PoseSoAStreams(const PoseSoA* p,
+                                  float* s[XMATH_POSE_STREAMS]) {
+  s[0] = p->px;
+  s[1] = p->py;
+  s[2] = p->pz;
+  s[3] = p->rx;
+  s[4] = p->ry;
+  s[5] = p->rz;
+  s[6] = p->rw;
+  s[7] = p->sx;
+  s[8] = p->sy;
+  s[9] = p->sz;
+}
+
+// Write the identity transform into the joints [first, last).
+static inline void PoseSoAFillIdentity(PoseSoA* r, size_t first, size_t last) {
+  float* s[XMATH_POSE_STREAMS];
+  PoseSoAStreams(r, s);
+  for (unsigned k = 0; k < XMATH_POSE_STREAMS; k++) {
+    // rw and the scales are one, the rest zero.
+    float v = k >= 6 ? 1.0f : 0.0f;
+    for (size_t i = first; i < last; i++) {
+      s[k][i] = v;
+    }
+  }
+}
+
+// Prepare r to receive count joints, padding included.
+static inline void PoseSoAResize(PoseSoA* r, size_t count) {
+  assert(r != NULL);
+  assert(PoseSoARoundUp(count, XMATH_POSE_STEP) <= r->capacity);
+  r->count = count;
+}
+
+static inline void PoseSoALoad(F32x8 v[XMATH_POSE_STREAMS],
+                               const PoseSoA* p,
+                               size_t i) {
+  float* s[XMATH_POSE_STREAMS];
+  PoseSoAStreams(p, s);
+  for (unsigned k = 0; k < XMATH_POSE_STREAMS; k++) {
+    v[k] = F32x8Load(s[k] + i);
+  }
+}
+
+static inline void PoseSoAStore(PoseSoA* p,
+                                size_t i,
+                                const F32x8 v[XMATH_POSE_STREAMS]) {
+  float* s[XMATH_POSE_STREAMS];
+  PoseSoAStreams(p, s);
+  for (unsigned k = 0; k < XMATH_POSE_STREAMS; k++) {
+    F32x8Store(s[k] + i, v[k]);
+  }
+}
+
+// Weights of the joints [i, i + 8) of a layer, zero past count.
+static inline F32x8 PoseLayerWeights(const PoseLayer* l,
+                                     size_t i,
+                                     size_t count) {
+  F32x8 w = F32x8Splat(l->weight);
+  if (l->mask == NULL) {
+    return w;
+  }
+  if (i + XMATH_POSE_STEP <= count) {
+    return F32x8Mul(w, F32x8Load(l->mask + i));
+  }
+
+  float rest[XMATH_POSE_STEP] = {0};
+  memcpy(rest, l->mask + i, (count - i) * sizeof(float));
+  return F32x8Mul(w, F32x8Load(rest));
+}
+
+// Quaternion product a * b lane by lane, same as QuatCross.
+static inline void PoseQuatMul(F32x8 r[4], const F32x8 a[4], const F32x8 b[4]) {
+  F32x8 x = F32x8MulAdd(a[3], b[0], F32x8Mul(a[0], b[3]));
+  x = F32x8Sub(F32x8MulAdd(a[1], b[2], x), F32x8Mul(a[2], b[1]));
+  F32x8 y = F32x8MulAdd(a[3], b[1], F32x8Mul(a[1], b[3]));
+  y = F32x8Sub(F32x8MulAdd(a[2], b[0], y), F32x8Mul(a[0], b[2]));
+  F32x8 z = F32x8MulAdd(a[3], b[2], F32x8Mul(a[2], b[3]));
+  z = F32x8Sub(F32x8MulAdd(a[0], b[1], z), F32x8Mul(a[1], b[0]));
+  F32x8 d = F32x8MulAdd(a[0], b[0], F32x8Mul(a[1], b[1]));
+  d = F32x8MulAdd(a[2], b[2], d);
+  r[3] = F32x8Sub(F32x8Mul(a[3], b[3]), d);
+  r[0] = x;
+  r[1] = y;
+  r[2] = z;
+}
+
+// Normalize quaternions lane by lane, short ones are left as is like
+// QuatNorm.
+static inline void PoseQuatNorm(F32x8 q[4]) {
+  F32x8 len = F32x8Mul(q[0], q[0]);
+  for (unsigned k = 1; k < 4; k++) {
+    len = F32x8MulAdd(q[k], q[k], len);
+  }
+  len = F32x8Sqrt(len);
+  F32x8 one = F32x8Splat(1.0f);
+  F32x8 tiny = F32x8Less(len, F32x8Splat(XMATH_EPSILON));
+  F32x8 k = F32x8Select(tiny, one, F32x8Div(one, len));
+  for (unsigned i = 0; i < 4; i++) {
+    q[i] = F32x8Mul(q[i], k);
+  }
+}
+
+XMATH_API bool PoseSoAMake(PoseSoA* r, size_t count) {
+  assert(r != NULL);
+
+  size_t capacity = PoseSoARoundUp(count, XMATH_SOA_WIDTH);
+  if (capacity == 0) {
+    capacity = XMATH_SOA_WIDTH;
+  }
+
+  // One block holds every stream, each one stays aligned because the
+  // capacity is a multiple of the alignment.
+  size_t size = XMATH_POSE_STREAMS * capacity * sizeof(float);
+#if defined(_MSC_VER)
+  float* block = _aligned_malloc(size, XMATH_SOA_ALIGN);
+#else
+  float* block = aligned_alloc(XMATH_SOA_ALIGN, size);
+#endif
+  if (block == NULL) {
+    *r = (PoseSoA){0};
+    return false;
+  }
+
+  float** s[XMATH_POSE_STREAMS] = {&r->px, &r->py, &r->pz, &r->rx, &r->ry,
+                                   &r->rz, &r->rw, &r->sx, &r->sy, &r->sz};
+  for (unsigned k = 0; k < XMATH_POSE_STREAMS; k++) {
+    *s[k] = block + k * capacity;
+  }
+  r->count = count;
+  r->capacity = capacity;
+  PoseSoAFillIdentity(r, 0, capacity);
+  return true;
+}
+
+XMATH_API void PoseSoAFree(PoseSoA* pose) {
+  assert(pose != NULL);
+#if defined(_MSC_VER)
+  _aligned_free(pose->px);
+#else
+  free(pose->px);
+#endif
+  *pose = (PoseSoA){0};
+}
+
+XMATH_API void PoseSoAFromArray(PoseSoA* r, const Transform* in, size_t count) {
+  PoseSoAResize(r, count);
+  for (size_t i = 0; i < count; i++) {
+    r->px[i] = in[i].position.x;
+    r->py[i] = in[i].position.y;
+    r->pz[i] = in[i].position.z;
+    r->rx[i] = in[i].rotation.x;
+    r->ry[i] = in[i].rotation.y;
+    r->rz[i] = in[i].rotation.z;
+    r->rw[i] = in[i].rotation.w;
+    r->sx[i] = in[i].scale.x;
+    r->sy[i] = in[i].scale.y;
+    r->sz[i] = in[i].scale.z;
+  }
+  PoseSoAFillIdentity(r, count, PoseSoARoundUp(count, XMATH_POSE_STEP));
+}
+
+XMATH_API void PoseSoAToArray(Transform* out, const PoseSoA* pose) {
+  for (size_t i = 0; i < pose->count; i++) {
+    out[i] = (Transform){
+        .position = {pose->px[i], pose->py[i], pose->pz[i]},
+        .rotation = {pose->rx[i], pose->ry[i], pose->rz[i], pose->rw[i]},
+        .scale = {pose->sx[i], pose->sy[i], pose->sz[i]},
+    };
+  }
+}
+
+XMATH_API void PoseSoADelta(PoseSoA* r,
+                            const PoseSoA* pose,
+                            const PoseSoA* reference) {
+  assert(pose->count == reference->count);
+  PoseSoAResize(r, pose->count);
+  F32x8 zero = F32x8Splat(0.0f);
+  for (size_t i = 0; i < pose->count; i += XMATH_POSE_STEP) {
+    F32x8 a[XMATH_POSE_STREAMS];
+    F32x8 b[XMATH_POSE_STREAMS];
+    F32x8 v[XMATH_POSE_STREAMS];
+    PoseSoALoad(a, pose, i);
+    PoseSoALoad(b, reference, i);
+    for (unsigned k = 0; k < 3; k++) {
+      v[k] = F32x8Sub(a[k], b[k]);
+      v[7 + k] = F32x8Div(a[7 + k], b[7 + k]);
+    }
+    F32x8 conjugate[4] = {F32x8Sub(zero, b[3]), F32x8Sub(zero, b[4]),
+                          F32x8Sub(zero, b[5]), b[6]};
+    PoseQuatMul(v + 3, a + 3, conjugate);
+    PoseSoAStore(r, i, v);
+  }
+}
+
+XMATH_API void PoseSoAMix(PoseSoA* r,
+                          const PoseLayer* layers,
+                          size_t layerCount,
+                          const PoseLayer* additive,
+                          size_t additiveCount) {
+  assert(layerCount > 0);
+  size_t count = layers[0].pose->count;
+  for (size_t l = 0; l < layerCount; l++) {
+    assert(layers[l].pose->count == count);
+  }
+  for (size_t l = 0; l < additiveCount; l++) {
+    assert(additive[l].pose->count == count);
+  }
+  PoseSoAResize(r, count);
+
+  F32x8 zero = F32x8Splat(0.0f);
+  F32x8 one = F32x8Splat(1.0f);
+  for (size_t i = 0; i < count; i += XMATH_POSE_STEP) {
+    // Weighted sums, rotations against the hemisphere of the first layer.
+    F32x8 first[XMATH_POSE_STREAMS];
+    F32x8 acc[XMATH_POSE_STREAMS];
+    F32x8 v[XMATH_POSE_STREAMS];
+    F32x8 sum = zero;
+    PoseSoALoad(first, layers[0].pose, i);
+    for (unsigned k = 0; k < XMATH_POSE_STREAMS; k++) {
+      acc[k] = zero;
+    }
+    for (size_t l = 0; l < layerCount; l++) {
+      F32x8 w = PoseLayerWeights(&layers[l], i, count);
+      PoseSoALoad(v, layers[l].pose, i);
+      F32x8 d = F32x8Mul(first[3], v[3]);
+      d = F32x8MulAdd(first[4], v[4], d);
+      d = F32x8MulAdd(first[5], v[5], d);
+      d = F32x8MulAdd(first[6], v[6], d);
+      F32x8 wr = F32x8Select(F32x8Less(d, zero), F32x8Sub(zero, w), w);
+      for (unsigned k = 0; k < XMATH_POSE_STREAMS; k++) {
+        acc[k] = F32x8MulAdd(v[k], (k >= 3 && k < 7) ? wr : w, acc[k]);
+      }
+      sum = F32x8Add(sum, w);
+    }
+
+    F32x8 empty = F32x8Less(sum, F32x8Splat(XMATH_EPSILON));
+    F32x8 inv = F32x8Div(one, F32x8Select(empty, one, sum));
+    for (unsigned k = 0; k < XMATH_POSE_STREAMS; k++) {
+      acc[k] = F32x8Select(empty, first[k], F32x8Mul(acc[k], inv));
+    }
+    PoseQuatNorm(acc + 3);
+
+    for (size_t l = 0; l < additiveCount; l++) {
+      F32x8 w = PoseLayerWeights(&additive[l], i, count);
+      PoseSoALoad(v, additive[l].pose, i);
+      for (unsigned k = 0; k < 3; k++) {
+        acc[k] = F32x8MulAdd(v[k], w, acc[k]);
+        F32x8 s = F32x8MulAdd(F32x8Sub(v[7 + k], one), w, one);
+        acc[7 + k] = F32x8Mul(acc[7 + k], s);
+      }
+
+      // QuatNLerp from the identity to the delta, taken with a positive w.
+      F32x8 ws = F32x8Select(F32x8Less(v[6], zero), F32x8Sub(zero, w), w);
+      F32x8 dq[4] = {
+          F32x8Mul(v[3], ws),
+          F32x8Mul(v[4], ws),
+          F32x8Mul(v[5], ws),
+          F32x8MulAdd(v[6], ws, F32x8Sub(one, w)),
+      };
+      PoseQuatNorm(dq);
+      PoseQuatMul(acc + 3, dq, acc + 3);
+    }
+    PoseSoAStore(r, i, acc);
+  }
+}
@@ -0,0 +1,124 @@
+/**
+ * @file pose.h
+ * @brief Skeleton poses stored as structures of arrays, and their mixing.
+ *
+ * A PoseSoA keeps the local transforms of every joint of a skeleton as ten
+ * float streams, so the mixer works on eight joints per step without any
+ * gather. PoseSoAMix blends any number of weighted poses and then applies
+ * additive layers on top, reading every layer once.
+ */
+#ifndef XMATH_POSE_H
+#define XMATH_POSE_H
+#include <stdbool.h>
+#include <stddef.h>
+#include "api.h"
+#include "transform.h"
+#include "vec3soa.h"
+
+/**
+ * @brief Joint transforms as separate position, rotation and scale streams.
+ *
+ * The streams follow the rules of Vec3SoA: aligned to XMATH_SOA_ALIGN bytes,
+ * capacity a multiple of XMATH_SOA_WIDTH and unspecified lanes past count
+ * once a function other than PoseSoAMake or PoseSoAFromArray wrote them.
+ */
+typedef struct {
+  float* px;
+  float* py;
+  float* pz;
+  float* rx;
+  float* ry;
+  float* rz;
+  float* rw;
+  float* sx;
+  float* sy;
+  float* sz;
+  size_t count;
+  size_t capacity;
+} PoseSoA;
+
+/**
+ * @brief One input of PoseSoAMix.
+ *
+ * The weight of joint j is weight * mask[j]; mask holds pose->count floats,
+ * or is NULL to weigh every joint the same.
+ */
+typedef struct {
+  const PoseSoA* pose;
+  const float* mask;
+  float weight;
+} PoseLayer;
+
+/**
+ * @brief Allocate a pose of count joints at the identity transform.
+ * @param r pose to initialize.
+ * @param count number of joints.
+ * @return false if the memory could not be allocated.
+ */
+XMATH_API bool PoseSoAMake(PoseSoA* r, size_t count);
+
+/**
+ * @brief Release the memory of a pose made by PoseSoAMake.
+ * @param pose pose to release, left empty.
+ */
+XMATH_API void PoseSoAFree(PoseSoA* pose);
+
+/**
+ * @brief Copy an array of Transform into a pose.
+ * @param r destination pose, its capacity must fit count joints.
+ * @param in source of count transforms.
+ * @param count number of joints, becomes the count of r.
+ */
+XMATH_API void PoseSoAFromArray(PoseSoA* r, const Transform* in, size_t count);
+
+/**
+ * @brief Copy a pose into an array of Transform.
+ * @param out destination with room for pose->count transforms.
+ * @param pose source pose (unaffected).
+ */
+XMATH_API void PoseSoAToArray(Transform* out, const PoseSoA* pose);
+
+/**
+ * @brief Make the additive layer that turns reference into pose.
+ *
+ * The delta holds pose->position - reference->position, the rotation
+ * pose->rotation * conjugate(reference->rotation) and the scale divided
+ * component by component; the reference scales must not be zero.
+ * @param r destination pose, can be pose or reference.
+ * @param pose target pose.
+ * @param reference pose the delta is taken from, same count as pose.
+ */
+XMATH_API void PoseSoADelta(PoseSoA* r,
+                            const PoseSoA* pose,
+                            const PoseSoA* reference);
+
+/**
+ * @brief Blend poses and add additive layers in one pass.
+ *
+ * Every joint first takes the weighted average of the layers: positions and
+ * scales linearly and rotations with a normalized sum, each one negated when
+ * it is in the opposite hemisphere of the rotation of the first layer, as
+ * TransformLerp does. Joints whose weights add up to less than
+ * XMATH_EPSILON take the pose of the first layer.
+ *
+ * Each additive layer, made by PoseSoADelta, is then applied with its weight
+ * w: the position moves by w times the delta, the rotation is multiplied on
+ * the left by QuatNLerp(QuatIdentity, delta, w) and the scale by the lerp
+ * from one to the delta scale.
+ * @param r destination pose, can be any of the layer poses.
+ * @param layers layerCount layers to blend, at least one.
+ * @param layerCount number of layers.
+ * @param additive additiveCount additive layers, can be NULL if none.
+ * @param additiveCount number of additive layers.
+ */
+XMATH_API void PoseSoAMix(PoseSoA* r,
+                          const PoseLayer* layers,
+                          size_t layerCount,
+                          const PoseLayer* additive,
+                          size_t additiveCount);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "pose.c"
+#endif
+
+#endif /* XMATH_POSE_H */
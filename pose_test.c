@@ -0,0 +1,242 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "pose.h"
+#include "common_testing.h"
+#include "scalar.h"
+
+// Not a multiple of the step, so the padding lanes are exercised.
+#define COUNT 11
+
+static Transform gA[COUNT];
+static Transform gB[COUNT];
+static Transform gC[COUNT];
+
+static Transform SampleTransform(float f) {
+  return (Transform){
+      .position = {0.1f * f, 0.5f - 0.05f * f, 0.2f},
+      .rotation = QuatMakeAngleAxis(0.3f * f, Vec3Norm((Vec3){1, f, 2})),
+      .scale = {1.0f + 0.02f * f, 0.9f, 1.1f},
+  };
+}
+
+static void FillInputs(void) {
+  for (unsigned i = 0; i < COUNT; i++) {
+    float f = (float)i;
+    gA[i] = SampleTransform(f);
+    gB[i] = SampleTransform(2.0f * f + 1.0f);
+    gC[i] = SampleTransform(0.5f - f);
+
+    // Same orientation from the other hemisphere on some joints.
+    if (i % 3 == 1) {
+      gB[i].rotation = QuatNeg(gB[i].rotation);
+    }
+  }
+}
+
+static void MakePose(PoseSoA* p, const Transform* in) {
+  assert_true(PoseSoAMake(p, COUNT));
+  PoseSoAFromArray(p, in, COUNT);
+}
+
+static void test_PoseSoAMake(void** state) {
+  UNUSED(state);
+
+  PoseSoA p;
+  Transform out[COUNT];
+  assert_true(PoseSoAMake(&p, COUNT));
+  assert_int_equal(p.count, COUNT);
+  assert_int_equal(p.capacity % XMATH_SOA_WIDTH, 0);
+  assert_int_equal((uintptr_t)p.sz % XMATH_SOA_ALIGN, 0);
+  PoseSoAToArray(out, &p);
+  Transform identity = {Vec3Zero, QuatIdentity, Vec3One};
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_true(TransformEqualApprox(out[i], identity));
+  }
+
+  FillInputs();
+  PoseSoAFromArray(&p, gA, COUNT);
+  PoseSoAToArray(out, &p);
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_true(TransformEqualApprox(out[i], gA[i]));
+  }
+
+  PoseSoAFree(&p);
+  assert_true(p.px == NULL);
+  assert_int_equal(p.count, 0);
+}
+
+static void test_PoseSoAMixTwo(void** state) {
+  UNUSED(state);
+
+  PoseSoA a;
+  PoseSoA b;
+  PoseSoA r;
+  Transform out[COUNT];
+  FillInputs();
+  MakePose(&a, gA);
+  MakePose(&b, gB);
+  assert_true(PoseSoAMake(&r, COUNT));
+
+  // Weights that do not add up to one are normalized.
+  PoseLayer layers[2] = {{&a, NULL, 0.5f}, {&b, NULL, 1.5f}};
+  PoseSoAMix(&r, layers, 2, NULL, 0);
+  PoseSoAToArray(out, &r);
+  for (unsigned i = 0; i < COUNT; i++) {
+    Transform e = TransformLerp(gA[i], gB[i], 0.75f);
+    assert_true(TransformEqualApprox(out[i], e));
+  }
+
+  // Masked joints, the empty ones take the first layer.
+  float maskA[COUNT];
+  float maskB[COUNT];
+  for (unsigned i = 0; i < COUNT; i++) {
+    maskA[i] = (i % 2 == 0) ? 1.0f : 0.0f;
+    maskB[i] = (i % 4 == 0) ? 0.0f : 0.5f;
+  }
+  layers[0].mask = maskA;
+  layers[1].mask = maskB;
+  PoseSoAMix(&r, layers, 2, NULL, 0);
+  PoseSoAToArray(out, &r);
+  for (unsigned i = 0; i < COUNT; i++) {
+    float wa = 0.5f * maskA[i];
+    float wb = 1.5f * maskB[i];
+    Transform e = gA[i];
+    if (wa + wb > 0.0f) {
+      e = TransformLerp(gA[i], gB[i], wb / (wa + wb));
+    }
+    assert_true(TransformEqualApprox(out[i], e));
+  }
+
+  // In place.
+  layers[0].mask = NULL;
+  layers[1].mask = NULL;
+  PoseSoAMix(&b, layers, 2, NULL, 0);
+  PoseSoAToArray(out, &b);
+  for (unsigned i = 0; i < COUNT; i++) {
+    Transform e = TransformLerp(gA[i], gB[i], 0.75f);
+    assert_true(TransformEqualApprox(out[i], e));
+  }
+
+  PoseSoAFree(&a);
+  PoseSoAFree(&b);
+  PoseSoAFree(&r);
+}
+
+static void test_PoseSoAMixMany(void** state) {
+  UNUSED(state);
+
+  PoseSoA p[3];
+  PoseSoA r;
+  Transform out[COUNT];
+  FillInputs();
+  MakePose(&p[0], gA);
+  MakePose(&p[1], gB);
+  MakePose(&p[2], gC);
+  assert_true(PoseSoAMake(&r, COUNT));
+  PoseLayer layers[3] = {{&p[0], NULL, 0.2f}, {&p[1], NULL, 0.3f},
+                         {&p[2], NULL, 0.5f}};
+  PoseSoAMix(&r, layers, 3, NULL, 0);
+  PoseSoAToArray(out, &r);
+
+  const Transform* in[3] = {gA, gB, gC};
+  for (unsigned i = 0; i < COUNT; i++) {
+    Transform e = {Vec3Zero, QuatZero, Vec3Zero};
+    for (unsigned l = 0; l < 3; l++) {
+      Transform t = in[l][i];
+      float w = layers[l].weight;
+      float wr = QuatDot(gA[i].rotation, t.rotation) < 0.0f ? -w : w;
+      e.position = Vec3Add(e.position, Vec3Scale(t.position, w));
+      e.rotation = QuatAdd(e.rotation, QuatScale(t.rotation, wr));
+      e.scale = Vec3Add(e.scale, Vec3Scale(t.scale, w));
+    }
+    e.rotation = QuatNorm(e.rotation);
+    assert_true(TransformEqualApprox(out[i], e));
+  }
+
+  for (unsigned l = 0; l < 3; l++) {
+    PoseSoAFree(&p[l]);
+  }
+  PoseSoAFree(&r);
+}
+
+static void test_PoseSoAAdditive(void** state) {
+  UNUSED(state);
+
+  PoseSoA base;
+  PoseSoA pose;
+  PoseSoA reference;
+  PoseSoA delta;
+  PoseSoA r;
+  Transform out[COUNT];
+  FillInputs();
+  MakePose(&base, gA);
+  MakePose(&pose, gB);
+  MakePose(&reference, gC);
+  assert_true(PoseSoAMake(&delta, COUNT));
+  assert_true(PoseSoAMake(&r, COUNT));
+  PoseSoADelta(&delta, &pose, &reference);
+
+  // The full delta on its own reference gives the pose back.
+  PoseLayer ref = {&reference, NULL, 1.0f};
+  PoseLayer add = {&delta, NULL, 1.0f};
+  PoseSoAMix(&r, &ref, 1, &add, 1);
+  PoseSoAToArray(out, &r);
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_true(Vec3EqualApprox(out[i].position, gB[i].position));
+    assert_true(QuatSameOrientation(out[i].rotation, gB[i].rotation));
+    assert_true(Vec3EqualApprox(out[i].scale, gB[i].scale));
+  }
+
+  // Partial and masked deltas on another base.
+  float mask[COUNT];
+  for (unsigned i = 0; i < COUNT; i++) {
+    mask[i] = 0.1f * (float)i;
+  }
+  PoseLayer layer = {&base, NULL, 1.0f};
+  add.mask = mask;
+  add.weight = 0.6f;
+  PoseSoAMix(&r, &layer, 1, &add, 1);
+  PoseSoAToArray(out, &r);
+  for (unsigned i = 0; i < COUNT; i++) {
+    float w = 0.6f * mask[i];
+    Quat d = QuatCross(gB[i].rotation, QuatConjugate(gC[i].rotation));
+    if (d.w < 0.0f) {
+      d = QuatNeg(d);
+    }
+    Vec3 ds = {gB[i].scale.x / gC[i].scale.x, gB[i].scale.y / gC[i].scale.y,
+               gB[i].scale.z / gC[i].scale.z};
+    Vec3 dp = Vec3Sub(gB[i].position, gC[i].position);
+    Transform e = {
+        .position = Vec3Add(gA[i].position, Vec3Scale(dp, w)),
+        .rotation = QuatCross(QuatNLerp(QuatIdentity, d, w), gA[i].rotation),
+        .scale = Vec3InnerMul(gA[i].scale, Vec3Lerp(Vec3One, ds, w)),
+    };
+    assert_true(TransformEqualApprox(out[i], e));
+  }
+
+  PoseSoAFree(&base);
+  PoseSoAFree(&pose);
+  PoseSoAFree(&reference);
+  PoseSoAFree(&delta);
+  PoseSoAFree(&r);
+}
+
+int main() {
+  UNUSED_TYPE(jmp_buf);
+  UNUSED_TYPE(va_list);
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_PoseSoAMake),
+      cmocka_unit_test(test_PoseSoAMixTwo),
+      cmocka_unit_test(test_PoseSoAMixMany),
+      cmocka_unit_test(test_PoseSoAAdditive),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -2,16 +2,28 @@
 #include <math.h>
 #include <stdio.h>
 
+#include "dispatch_table.h"
 #include "mat4.h"
 #include "quat.h"
 #include "scalar.h"
+#include "simd.h"
 #include "vec3.h"
 
-float* QuatFloats(Quat* quat) {
+static inline F32x4 QuatToF32x4(Quat q) {
+  return F32x4LoadHalves(&q.x);
+}
+
+static inline Quat F32x4ToQuat(F32x4 a) {
+  Quat r;
+  F32x4Store(&r.x, a);
+  return r;
+}
+
+XMATH_API float* QuatFloats(Quat* quat) {
   return &quat->x;
 }
 
-Quat QuatMakeAngleAxis(float angle, Vec3 axis) {
+XMATH_API Quat QuatMakeAngleAxis(float angle, Vec3 axis) {
   Vec3 norm = Vec3Norm(axis);
   float l = Vec3Len(axis);
   if (l == 0) {
@@ -29,7 +41,7 @@ Quat QuatMakeAngleAxis(float angle, Vec3 axis) {
   };
 }
 
-Quat QuatMakeFromTo(Vec3 from, Vec3 to) {
+XMATH_API Quat QuatMakeFromTo(Vec3 from, Vec3 to) {
   Vec3 c = Vec3Cross(from, to);
   float d = Vec3Dot(from, to);
 
@@ -47,45 +59,45 @@ Quat QuatMakeFromTo(Vec3 from, Vec3 to) {
   };
 }
 
-Vec3 QuatGetAxis(Quat q) {
+XMATH_API Vec3 QuatGetAxis(Quat q) {
   Vec3 v = {q.x, q.y, q.z};
   return Vec3Norm(v);
 }
 
-float QuatGetAngle(Quat q) {
+XMATH_API float QuatGetAngle(Quat q) {
   return 2.0f * acosf(q.w);
 }
 
-Vec3 QuatGetImgPart(Quat q) {
+XMATH_API Vec3 QuatGetImgPart(Quat q) {
   return (Vec3){q.x, q.y, q.z};
 }
 
-float QuatGetRealPart(Quat q) {
+XMATH_API float QuatGetRealPart(Quat q) {
   return q.w;
 }
 
-bool QuatEqualApprox(Quat a, Quat b) {
+XMATH_API bool QuatEqualApprox(Quat a, Quat b) {
   return FEqualApprox(a.x, b.x) && FEqualApprox(a.y, b.y) &&
          FEqualApprox(a.z, b.z) && FEqualApprox(a.w, b.w);
 }
 
-Quat QuatAdd(Quat a, Quat b) {
-  return (Quat){a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w};
+XMATH_API Quat QuatAdd(Quat a, Quat b) {
+  return F32x4ToQuat(F32x4Add(QuatToF32x4(a), QuatToF32x4(b)));
 }
 
-Quat QuatSub(Quat a, Quat b) {
-  return (Quat){a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w};
+XMATH_API Quat QuatSub(Quat a, Quat b) {
+  return F32x4ToQuat(F32x4Sub(QuatToF32x4(a), QuatToF32x4(b)));
 }
 
-Quat QuatScale(Quat q, float s) {
-  return (Quat){q.x * s, q.y * s, q.z * s, q.w * s};
+XMATH_API Quat QuatScale(Quat q, float s) {
+  return F32x4ToQuat(F32x4Mul(QuatToF32x4(q), F32x4Splat(s)));
 }
 
-Quat QuatNeg(Quat q) {
+XMATH_API Quat QuatNeg(Quat q) {
   return QuatScale(q, -1);
 }
 
-bool QuatSameOrientation(Quat a, Quat b) {
+XMATH_API bool QuatSameOrientation(Quat a, Quat b) {
   return (fabsf(a.x - b.x) <= XMATH_EPSILON &&
           fabsf(a.y - b.y) <= XMATH_EPSILON &&
           fabsf(a.z - b.z) <= XMATH_EPSILON &&
@@ -96,19 +108,21 @@ bool QuatSameOrientation(Quat a, Quat b) {
           fabsf(a.w + b.w) <= XMATH_EPSILON);
 }
 
-float QuatDot(Quat a, Quat b) {
-  return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+XMATH_API float QuatDot(Quat a, Quat b) {
+  return F32x4Dot(QuatToF32x4(a), QuatToF32x4(b));
 }
 
-float QuatSqrLen(Quat v) {
-  return v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w;
+XMATH_API float QuatSqrLen(Quat v) {
+  F32x4 a = QuatToF32x4(v);
+  return F32x4Dot(a, a);
 }
 
-float QuatLen(Quat v) {
-  return sqrtf(v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w);
+XMATH_API float QuatLen(Quat v) {
+  F32x4 a = QuatToF32x4(v);
+  return sqrtf(F32x4Dot(a, a));
 }
 
-Quat QuatNorm(Quat v) {
+XMATH_API Quat QuatNorm(Quat v) {
   float vl = QuatLen(v);
   if (vl < XMATH_EPSILON) {
     return v;
@@ -118,30 +132,40 @@ Quat QuatNorm(Quat v) {
   return QuatScale(v, k);
 }
 
-Quat QuatConjugate(Quat q) {
-  return (Quat){-q.x, -q.y, -q.z, q.w};
+XMATH_API Quat QuatConjugate(Quat q) {
+  F32x4 sign = F32x4Set(-1.0f, -1.0f, -1.0f, 1.0f);
+  return F32x4ToQuat(F32x4Mul(QuatToF32x4(q), sign));
 }
 
-Quat QuatInvert(Quat q) {
+XMATH_API Quat QuatInvert(Quat q) {
   float lenSq = QuatSqrLen(q);
   if (lenSq < XMATH_EPSILON) {
     return QuatIdentity;
   }
 
   float recip = 1.0f / lenSq;
-  return (Quat){-q.x * recip, -q.y * recip, -q.z * recip, q.w * recip};
+  F32x4 k = F32x4Set(-recip, -recip, -recip, recip);
+  return F32x4ToQuat(F32x4Mul(QuatToF32x4(q), k));
 }
 
-Quat QuatCross(Quat a, Quat b) {
-  return (Quat){
-      a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
-      a.w * b.y + a.y * b.w + a.z * b.x - a.x * b.z,
-      a.w * b.z + a.z * b.w + a.x * b.y - a.y * b.x,
-      a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
-  };
+XMATH_API Quat QuatCross(Quat a, Quat b) {
+  // Same products as the textbook form, grouped by lane:
+  //   r = a.w * b + a.xyzx * b.wwwx + a.yzxy * b.zxyy - a.zxyz * b.yzxz
+  // where the sign of the w lane of the middle terms is flipped.
+  F32x4 va = QuatToF32x4(a);
+  F32x4 vb = QuatToF32x4(b);
+  F32x4 flipW = F32x4Set(1.0f, 1.0f, 1.0f, -1.0f);
+
+  F32x4 r = F32x4Mul(F32x4Swizzle(va, 3, 3, 3, 3), vb);
+  F32x4 m = F32x4Mul(F32x4Swizzle(va, 0, 1, 2, 0), F32x4Swizzle(vb, 3, 3, 3, 0));
+  m = F32x4MulAdd(F32x4Swizzle(va, 1, 2, 0, 1), F32x4Swizzle(vb, 2, 0, 1, 1), m);
+  r = F32x4MulAdd(m, flipW, r);
+  r = F32x4Sub(r, F32x4Mul(F32x4Swizzle(va, 2, 0, 1, 2),
+                           F32x4Swizzle(vb, 1, 2, 0, 2)));
+  return F32x4ToQuat(r);
 }
 
-Vec3 QuatTransformVec3(Quat q, Vec3 v) {
+XMATH_API Vec3 QuatTransformVec3(Quat q, Vec3 v) {
   float s = QuatGetRealPart(q);
   Vec3 i = QuatGetImgPart(q);
   Vec3 a = Vec3Scale(i, 2.0f * Vec3Dot(i, v));
@@ -150,15 +174,43 @@ Vec3 QuatTransformVec3(Quat q, Vec3 v) {
   return Vec3Add(Vec3Add(a, b), c);
 }
 
-Quat QuatLerp(Quat from, Quat to, float t) {
-  return QuatAdd(QuatScale(from, 1.0f - t), QuatScale(to, t));
+XMATH_API void QuatTransformVec3Strided(Vec3* out,
+                                        size_t outStride,
+                                        Quat q,
+                                        const Vec3* in,
+                                        size_t inStride,
+                                        size_t count) {
+  assert(count == 0 || (in != NULL && out != NULL));
+  float rows[12];
+  BatchAffineRows(rows, &q.x, Vec3One, Vec3Zero);
+  DispatchAffineVec3(rows, out, outStride, in, inStride, count);
+}
+
+XMATH_API void QuatTransformVec3Array(Vec3* out,
+                                      Quat q,
+                                      const Vec3* in,
+                                      size_t count) {
+  QuatTransformVec3Strided(out, sizeof(Vec3), q, in, sizeof(Vec3), count);
+}
+
+XMATH_API void QuatTransformVec3Pairwise(Vec3* out,
+                                         const Quat* qs,
+                                         const Vec3* vs,
+                                         size_t count) {
+  assert(count == 0 || (qs != NULL && vs != NULL && out != NULL));
+  DispatchQuatVec3Pairwise(out, &qs->x, vs, count);
+}
+
+XMATH_API Quat QuatLerp(Quat from, Quat to, float t) {
+  F32x4 a = F32x4Mul(QuatToF32x4(from), F32x4Splat(1.0f - t));
+  return F32x4ToQuat(F32x4MulAdd(QuatToF32x4(to), F32x4Splat(t), a));
 }
 
-Quat QuatNLerp(Quat from, Quat to, float t) {
+XMATH_API Quat QuatNLerp(Quat from, Quat to, float t) {
   return QuatNorm(QuatLerp(from, to, t));
 }
 
-Quat QuatSLerp(Quat from, Quat to, float t) {
+XMATH_API Quat QuatSLerp(Quat from, Quat to, float t) {
   Quat target = to;
   float d = QuatDot(from, to);
 
@@ -180,7 +232,7 @@ Quat QuatSLerp(Quat from, Quat to, float t) {
   return QuatScale(c, 1.0f / sinf(theta));
 }
 
-Quat QuatLookRotation(Vec3 dir, Vec3 up) {
+XMATH_API Quat QuatLookRotation(Vec3 dir, Vec3 up) {
   Vec3 d = Vec3Scale(dir, -1);
   Vec3 r = Vec3Cross(up, d);
   Vec3 a = Vec3Scale(r, 1.0f / sqrtf(FMax(0.00001f, Vec3Dot(r, r))));
@@ -197,7 +249,7 @@ Quat QuatLookRotation(Vec3 dir, Vec3 up) {
   return Mat4ToQuat(m);
 }
 
-Mat4 QuatToMat4(Quat q) {
+XMATH_API Mat4 QuatToMat4(Quat q) {
   Vec3 r = QuatTransformVec3(q, Vec3Right);
   Vec3 u = QuatTransformVec3(q, Vec3Up);
   Vec3 f = QuatTransformVec3(q, Vec3Back);
@@ -211,7 +263,7 @@ Mat4 QuatToMat4(Quat q) {
   // clang-format on
 }
 
-Quat Mat4ToQuat(Mat4 m) {
+XMATH_API Quat Mat4ToQuat(Mat4 m) {
   float fx = m.xx - m.yy - m.zz;
   float fy = m.yy - m.xx - m.zz;
   float fz = m.zz - m.xx - m.yy;
@@ -5,6 +5,8 @@
 #ifndef XMATH_QUAT_H
 #define XMATH_QUAT_H
 #include <stdbool.h>
+#include <stddef.h>
+#include "api.h"
 
 #include "mat4.h"
 #include "vec3.h"
@@ -31,7 +33,7 @@ static const Quat QuatIdentity = {0.0f, 0.0f, 0.0f, 1.0f};
  * @param quat reference to the quaternion data.
  * @return The address of first component.
  */
-float* QuatFloats(Quat* quat);
+XMATH_API float* QuatFloats(Quat* quat);
 
 /**
  * @brief Make a quaternion using angle and axis.
@@ -39,7 +41,7 @@ float* QuatFloats(Quat* quat);
  * @param axis rotation.
  * @return Quat with angle * axis rotation.
  */
-Quat QuatMakeAngleAxis(float angle, Vec3 axis);
+XMATH_API Quat QuatMakeAngleAxis(float angle, Vec3 axis);
 
 /**
  * @brief Make a quaternion of the rotation from one vector to another.
@@ -47,35 +49,35 @@ Quat QuatMakeAngleAxis(float angle, Vec3 axis);
  * @param to second vector
  * @return The rotation between from and to vectors.
  */
-Quat QuatMakeFromTo(Vec3 from, Vec3 to);
+XMATH_API Quat QuatMakeFromTo(Vec3 from, Vec3 to);
 
 /**
  * @brief Get the axis of a quaternion.
  * @param q valid quaternion.
  * @return normalized Vec3 of the axis values.
  */
-Vec3 QuatGetAxis(Quat q);
+XMATH_API Vec3 QuatGetAxis(Quat q);
 
 /**
  * @brief Get the angle of a quaternion.
  * @param q valid quaternion.
  * @return the angle of quaternion as radians.
  */
-float QuatGetAngle(Quat q);
+XMATH_API float QuatGetAngle(Quat q);
 
 /**
  * @brief Get the imaginary part of a quaternion.
  * @param q any quaternion.
  * @return a vector containing ijk part of the quaternion number.
  */
-Vec3 QuatGetImgPart(Quat q);
+XMATH_API Vec3 QuatGetImgPart(Quat q);
 
 /**
  * @brief Get the real part of a quaternion.
  * @param q any quaternion.
  * @return a scalar representing the real part of the number.
  */
-float QuatGetRealPart(Quat q);
+XMATH_API float QuatGetRealPart(Quat q);
 
 /**
  * @brief Compare two quaternions and return if they are approx equal.
@@ -83,7 +85,7 @@ float QuatGetRealPart(Quat q);
  * @param b second quat.
  * @return true if a components are near b components.
  */
-bool QuatEqualApprox(Quat a, Quat b);
+XMATH_API bool QuatEqualApprox(Quat a, Quat b);
 
 /**
  * @brief Standard quaternion addition.
@@ -91,7 +93,7 @@ bool QuatEqualApprox(Quat a, Quat b);
  * @param b second element.
  * @return the sum of each element's components.
  */
-Quat QuatAdd(Quat a, Quat b);
+XMATH_API Quat QuatAdd(Quat a, Quat b);
 
 /**
  * @brief Standard quaternion subtraction.
@@ -99,7 +101,7 @@ Quat QuatAdd(Quat a, Quat b);
  * @param b second element.
  * @return the difference of each element's components.
  */
-Quat QuatSub(Quat a, Quat b);
+XMATH_API Quat QuatSub(Quat a, Quat b);
 
 /**
  * @brief Standard quaternion scale.
@@ -107,14 +109,14 @@ Quat QuatSub(Quat a, Quat b);
  * @param s a scale.
  * @return a quaternion containing v components with s scale.
  */
-Quat QuatScale(Quat q, float s);
+XMATH_API Quat QuatScale(Quat q, float s);
 
 /**
  * @brief Negate a quaternion components.
  * @param q a quaternion (unaffected).
  * @return Same quaternion with each component multiplied by -1.
  */
-Quat QuatNeg(Quat q);
+XMATH_API Quat QuatNeg(Quat q);
 
 /**
  * @brief Check if two quaternions have the same orientation.
@@ -122,7 +124,7 @@ Quat QuatNeg(Quat q);
  * @param b second quaternion.
  * @return true if they are oriented the same, false otherwise.
  */
-bool QuatSameOrientation(Quat a, Quat b);
+XMATH_API bool QuatSameOrientation(Quat a, Quat b);
 
 /**
  * @brief How similar two quaternion are.
@@ -130,7 +132,7 @@ bool QuatSameOrientation(Quat a, Quat b);
  * @param b second quaternion.
  * @return standard dot product.
  */
-float QuatDot(Quat a, Quat b);
+XMATH_API float QuatDot(Quat a, Quat b);
 
 /**
  * @brief Squared length of a quaternion.
@@ -140,35 +142,35 @@ float QuatDot(Quat a, Quat b);
  * @param q a quaternion (unaffected).
  * @return squared quaternion length.
  */
-float QuatSqrLen(Quat q);
+XMATH_API float QuatSqrLen(Quat q);
 
 /**
  * @brief Standard length of a quaternion.
  * @param q a quaternion (unaffected).
  * @return quaternion's length.
  */
-float QuatLen(Quat q);
+XMATH_API float QuatLen(Quat q);
 
 /**
  * @brief Normalize a quaternion (divide each component by its inverse length).
  * @param q quaternion (unaffected).
  * @return normalized quaternion.
  */
-Quat QuatNorm(Quat q);
+XMATH_API Quat QuatNorm(Quat q);
 
 /**
  * @brief Flip the given quaternion.
  * @param q a normalized quaternion (unaffected).
  * @return q with its imaginary part negated.
  */
-Quat QuatConjugate(Quat q);
+XMATH_API Quat QuatConjugate(Quat q);
 
 /**
  * @brief Get proper quaternion inverse.
  * @param q any quaternion (unaffected).
  * @return inverted q.
  */
-Quat QuatInvert(Quat q);
+XMATH_API Quat QuatInvert(Quat q);
 
 /**
  * @brief Multiply two quaternions.
@@ -176,7 +178,7 @@ Quat QuatInvert(Quat q);
  * @param b any quaternion (unaffected).
  * @return product of a by b.
  */
-Quat QuatCross(Quat a, Quat b);
+XMATH_API Quat QuatCross(Quat a, Quat b);
 
 /**
  * @brief Transform a Vec3 using a quaternion.
@@ -186,7 +188,59 @@ Quat QuatCross(Quat a, Quat b);
  * @param v any vector to rotate its position.
  * @return same v rotated by q.
  */
-Vec3 QuatTransformVec3(Quat q, Vec3 v);
+XMATH_API Vec3 QuatTransformVec3(Quat q, Vec3 v);
+
+/**
+ * @brief Transform a strided array of Vec3 using a quaternion.
+ *
+ * Element i is read from `(char*)in + i * inStride` and written into
+ * `(char*)out + i * outStride`, so fields of interleaved vertex structs can
+ * be rotated where they are. out can be the same as in when both use the
+ * same stride.
+ * @param out address of the first destination vector.
+ * @param outStride distance in bytes between destination vectors.
+ * @param q any quaternion (unaffected).
+ * @param in address of the first source vector.
+ * @param inStride distance in bytes between source vectors.
+ * @param count number of vectors.
+ */
+XMATH_API void QuatTransformVec3Strided(Vec3* out,
+                                        size_t outStride,
+                                        Quat q,
+                                        const Vec3* in,
+                                        size_t inStride,
+                                        size_t count);
+
+/**
+ * @brief Transform an array of Vec3 using a quaternion.
+ *
+ * Same as QuatTransformVec3Strided over packed vectors. The rotation is
+ * expanded into a 3x3 matrix once, so each vector costs nine multiply-adds.
+ * @param out destination of count vectors, can be the same as in.
+ * @param q any quaternion (unaffected).
+ * @param in source of count vectors.
+ * @param count number of vectors.
+ */
+XMATH_API void QuatTransformVec3Array(Vec3* out,
+                                      Quat q,
+                                      const Vec3* in,
+                                      size_t count);
+
+/**
+ * @brief Rotate every vector by its own quaternion.
+ *
+ * Element i of out is vs[i] rotated by qs[i], computed four at a time as
+ * `v + 2w (q x v) + 2 q x (q x v)`. Matches QuatTransformVec3 for unit
+ * quaternions only.
+ * @param out destination of count vectors, can be the same as vs.
+ * @param qs count unit quaternions.
+ * @param vs count vectors to rotate.
+ * @param count number of pairs.
+ */
+XMATH_API void QuatTransformVec3Pairwise(Vec3* out,
+                                         const Quat* qs,
+                                         const Vec3* vs,
+                                         size_t count);
 
 /**
  * @brief Linear interpolation between two quaternions.
@@ -194,7 +248,7 @@ Vec3 QuatTransformVec3(Quat q, Vec3 v);
  * @param to quaternion.
  * @param t transition value.
  */
-Quat QuatLerp(Quat from, Quat to, float t);
+XMATH_API Quat QuatLerp(Quat from, Quat to, float t);
 
 /**
  * @brief Normalized linear interpolation between two quaternions.
@@ -202,7 +256,7 @@ Quat QuatLerp(Quat from, Quat to, float t);
  * @param to quaternion.
  * @param t transition value.
  */
-Quat QuatNLerp(Quat from, Quat to, float t);
+XMATH_API Quat QuatNLerp(Quat from, Quat to, float t);
 
 /**
  * @brief Spherical interpolation between two quaternions.
@@ -210,7 +264,7 @@ Quat QuatNLerp(Quat from, Quat to, float t);
  * @param to quaternion.
  * @param t transition value.
  */
-Quat QuatSLerp(Quat from, Quat to, float t);
+XMATH_API Quat QuatSLerp(Quat from, Quat to, float t);
 
 /**
  * @brief Create a quaternion to look at the desired direction.
@@ -218,20 +272,24 @@ Quat QuatSLerp(Quat from, Quat to, float t);
  * @param up world or relative up to use to align correctly the rotation.
  * @return the quaternion to look at dir.
  */
-Quat QuatLookRotation(Vec3 dir, Vec3 up);
+XMATH_API Quat QuatLookRotation(Vec3 dir, Vec3 up);
 
 /**
  * @brief Convert a quaternion into a matrix representation.
  * @param q quaternion to be converted (unaffected).
  * @return a matrix with the same rotation as the quaternion.
  */
-Mat4 QuatToMat4(Quat q);
+XMATH_API Mat4 QuatToMat4(Quat q);
 
 /**
  * @brief Convert a transform matrix into a quaternion.
  * @param m matrix to be converted (unaffected).
  * @return a quaternion with the same orientation as the transform matrix.
  */
-Quat Mat4ToQuat(Mat4 m);
+XMATH_API Quat Mat4ToQuat(Mat4 m);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "quat.c"
+#endif
 
 #endif  // XMATH_QUAT_H
@@ -214,6 +214,73 @@ static void test_QuatTransformVec3(void** state) {
   assert_true(Vec3EqualApprox(r, e));
 }
 
+static void test_QuatTransformVec3Strided(void** state) {
+  UNUSED(state);
+
+  typedef struct {
+    Vec3 position;
+    Vec3 normal;
+    float uv[2];
+  } Vertex;
+
+  Quat a = {0.274506f, 0.109802f, 0.054901f, 0.953717f};
+  Vertex vertices[7];
+  Vec3 out[7];
+  for (unsigned i = 0; i < 7; i++) {
+    float f = 0.125f * (float)i;
+    vertices[i] = (Vertex){{f, 1.0f - f, 0.5f * f}, {0.0f, f, 1.0f}, {f, f}};
+  }
+
+  QuatTransformVec3Strided(out, sizeof(Vec3), a, &vertices[0].normal,
+                           sizeof(Vertex), 7);
+  for (unsigned i = 0; i < 7; i++) {
+    Vec3 e = QuatTransformVec3(a, vertices[i].normal);
+    assert_true(Vec3EqualApprox(out[i], e));
+  }
+
+  // In place, the neighbour fields must stay untouched.
+  QuatTransformVec3Strided(&vertices[0].normal, sizeof(Vertex), a,
+                           &vertices[0].normal, sizeof(Vertex), 7);
+  for (unsigned i = 0; i < 7; i++) {
+    float f = 0.125f * (float)i;
+    Vec3 p = {f, 1.0f - f, 0.5f * f};
+    assert_true(Vec3EqualApprox(vertices[i].normal, out[i]));
+    assert_true(Vec3EqualApprox(vertices[i].position, p));
+    assert_float_equal(vertices[i].uv[0], f, XMATH_EPSILON);
+  }
+}
+
+static void test_QuatTransformVec3Array(void** state) {
+  UNUSED(state);
+
+  Quat a = {0.274506f, 0.109802f, 0.054901f, 0.953717f};
+  Quat qs[11];
+  Vec3 in[11];
+  Vec3 out[11];
+  for (unsigned i = 0; i < 11; i++) {
+    float f = 0.1f * (float)i;
+    in[i] = (Vec3){f, 1.0f - f, 0.5f * f};
+    qs[i] = QuatMakeAngleAxis(f * 3.0f, Vec3Norm((Vec3){1.0f, f, -0.5f}));
+  }
+
+  QuatTransformVec3Array(out, a, in, 11);
+  for (unsigned i = 0; i < 11; i++) {
+    assert_true(Vec3EqualApprox(out[i], QuatTransformVec3(a, in[i])));
+  }
+
+  // Not a multiple of four, so the padded tail is exercised.
+  QuatTransformVec3Pairwise(out, qs, in, 11);
+  for (unsigned i = 0; i < 11; i++) {
+    assert_true(Vec3EqualApprox(out[i], QuatTransformVec3(qs[i], in[i])));
+  }
+
+  // In place.
+  QuatTransformVec3Pairwise(in, qs, in, 11);
+  for (unsigned i = 0; i < 11; i++) {
+    assert_true(Vec3EqualApprox(in[i], out[i]));
+  }
+}
+
 static void test_QuatLerp(void** state) {
   UNUSED(state);
 
@@ -313,6 +380,8 @@ int main() {
       cmocka_unit_test(test_QuatInvert),
       cmocka_unit_test(test_QuatCross),
       cmocka_unit_test(test_QuatTransformVec3),
+      cmocka_unit_test(test_QuatTransformVec3Strided),
+      cmocka_unit_test(test_QuatTransformVec3Array),
       cmocka_unit_test(test_QuatLerp),
       cmocka_unit_test(test_QuatNLerp),
       cmocka_unit_test(test_QuatSLerp),
@@ -5,6 +5,7 @@
 #ifndef XMATH_SCALAR_H
 #define XMATH_SCALAR_H
 #include <stdbool.h>
+#include "api.h"
 
 /**
  * Epsilon constant (what is assumed as a discriminable value) (Enough for game dev).
@@ -20,7 +21,7 @@
  * @brief Compares two float values.
  * @return true if they are approximately equal (diff less than epsilon).
  */
-bool FEqualApprox(float a, float b);
+XMATH_API bool FEqualApprox(float a, float b);
 
 /**
  * @brief Max value between to floats.
@@ -28,7 +29,7 @@ bool FEqualApprox(float a, float b);
  * @param b Second value.
  * @return The greater number between a and b.
  */
-float FMax(float a, float b);
+XMATH_API float FMax(float a, float b);
 
 /**
  * @brief Min value between to floats.
@@ -36,7 +37,7 @@ float FMax(float a, float b);
  * @param b second value.
  * @return The lesser number between a and b.
  */
-float FMin(float a, float b);
+XMATH_API float FMin(float a, float b);
 
 /**
  * @brief Linearly interpolates first and second by factor.
@@ -48,7 +49,7 @@ float FMin(float a, float b);
  * @param factor value between 0.0f and 1.0f.
  * @return Interpolated value.
  */
-float FLerp(float first, float second, float factor);
+XMATH_API float FLerp(float first, float second, float factor);
 
 /**
  * @brief Remap a value between range [minSrc, maxSrc] into new range [minDst, maxDst].
@@ -59,20 +60,28 @@ float FLerp(float first, float second, float factor);
  * @param maxDst high value of destination range.
  * @return the value as it were on [minDst, maxDest]
  */
-float FRemap(float value, float minSrc, float maxSrc, float minDst, float maxDst);
+XMATH_API float FRemap(float value,
+                       float minSrc,
+                       float maxSrc,
+                       float minDst,
+                       float maxDst);
 
 /**
  * @brief Convert radians into degrees.
  * @param rad value in radians.
  * @return value in degrees.
  */
-float FRad2Deg(float rad);
+XMATH_API float FRad2Deg(float rad);
 
 /**
  * @brief Convert degrees into radians.
  * @param deg value in degrees.
  * @return value in radians.
  */
-float FDeg2Rad(float deg);
+XMATH_API float FDeg2Rad(float deg);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "scalar.c"
+#endif
 
 #endif /* XMATH_SCALAR_H */
\ No newline at end of file
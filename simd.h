@@ -0,0 +1,622 @@
+/**
+ * @file simd.h
+ * @brief Float lanes wrappers over the SIMD instruction set of the target.
+ *
+ * The backend is selected at compile time from the flags the compiler was
+ * invoked with: AVX, SSE4.1 or SSE2 on x86, NEON on ARM and plain floats
+ * everywhere else. Defining `XMATH_NO_SIMD` forces the scalar backend.
+ *
+ * F32x4 maps to one 128 bit register, F32x8 maps to one 256 bit register on
+ * AVX and to a pair of F32x4 elsewhere.
+ *
+ * All the functions are `static inline`. They back the library
+ * implementation and can be used to write custom kernels over the packets of
+ * packet.h without reaching for raw intrinsics.
+ */
+#ifndef XMATH_SIMD_H
+#define XMATH_SIMD_H
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+// clang-format off
+#if !defined(XMATH_NO_SIMD) &&                                 \
+    (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define XMATH_SIMD_SSE 1
+#if defined(__SSE4_1__) || defined(__AVX__)
+#define XMATH_SIMD_SSE4 1
+#endif
+#if defined(__AVX__)
+#define XMATH_SIMD_AVX 1
+#endif
+#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define XMATH_SIMD_FMA 1
+#endif
+#elif !defined(XMATH_NO_SIMD) && \
+    (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64))
+#define XMATH_SIMD_NEON 1
+#else
+#define XMATH_SIMD_SCALAR 1
+#endif
+// clang-format on
+
+#if defined(XMATH_SIMD_AVX)
+#include <immintrin.h>
+#define XMATH_SIMD_NAME "avx"
+#elif defined(XMATH_SIMD_SSE4)
+#include <smmintrin.h>
+#define XMATH_SIMD_NAME "sse4.1"
+#elif defined(XMATH_SIMD_SSE)
+#include <emmintrin.h>
+#define XMATH_SIMD_NAME "sse2"
+#elif defined(XMATH_SIMD_NEON)
+#include <arm_neon.h>
+#define XMATH_SIMD_NAME "neon"
+#else
+#define XMATH_SIMD_NAME "scalar"
+#endif
+
+/**
+ * @brief Four packed single precision floats.
+ */
+#if defined(XMATH_SIMD_SSE)
+typedef __m128 F32x4;
+#elif defined(XMATH_SIMD_NEON)
+typedef float32x4_t F32x4;
+#else
+typedef struct {
+  float v[4];
+} F32x4;
+#endif
+
+/**
+ * @brief Load four floats from an unaligned address.
+ * @param p address of the first float.
+ * @return the packed floats.
+ */
+static inline F32x4 F32x4Load(const float* p) {
+#if defined(XMATH_SIMD_SSE)
+  return _mm_loadu_ps(p);
+#elif defined(XMATH_SIMD_NEON)
+  return vld1q_f32(p);
+#else
+  return (F32x4){{p[0], p[1], p[2], p[3]}};
+#endif
+}
+
+/**
+ * @brief Store four floats into an unaligned address.
+ * @param p destination of the first float.
+ * @param a packed floats.
+ */
+static inline void F32x4Store(float* p, F32x4 a) {
+#if defined(XMATH_SIMD_SSE)
+  _mm_storeu_ps(p, a);
+#elif defined(XMATH_SIMD_NEON)
+  vst1q_f32(p, a);
+#else
+  p[0] = a.v[0];
+  p[1] = a.v[1];
+  p[2] = a.v[2];
+  p[3] = a.v[3];
+#endif
+}
+
+/**
+ * @brief Load four floats as two 64 bit halves.
+ *
+ * Structs of four floats passed by value usually arrive split in two
+ * registers, reloading them in halves avoids the store forwarding stall that a
+ * single 128 bit load of the spilled values would cause.
+ * @param p address of the first float.
+ * @return the packed floats.
+ */
+static inline F32x4 F32x4LoadHalves(const float* p) {
+#if defined(XMATH_SIMD_SSE)
+  // __m64 may alias floats, a double pointer would break strict aliasing.
+  __m128 lo = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p);
+  return _mm_loadh_pi(lo, (const __m64*)(p + 2));
+#elif defined(XMATH_SIMD_NEON)
+  return vcombine_f32(vld1_f32(p), vld1_f32(p + 2));
+#else
+  return F32x4Load(p);
+#endif
+}
+
+/**
+ * @brief Load three floats, the last lane is zero.
+ *
+ * Never reads past p[2], so it is safe on the last element of a Vec3 array.
+ * @param p address of the first float.
+ * @return the packed floats.
+ */
+static inline F32x4 F32x4Load3(const float* p) {
+#if defined(XMATH_SIMD_SSE)
+  __m128 lo = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p);
+  return _mm_movelh_ps(lo, _mm_load_ss(p + 2));
+#elif defined(XMATH_SIMD_NEON)
+  return vcombine_f32(vld1_f32(p), vld1_lane_f32(p + 2, vdup_n_f32(0.0f), 0));
+#else
+  return (F32x4){{p[0], p[1], p[2], 0.0f}};
+#endif
+}
+
+/**
+ * @brief Store the first three lanes, never writes past p[2].
+ * @param p destination of the first float.
+ * @param a packed floats.
+ */
+static inline void F32x4Store3(float* p, F32x4 a) {
+#if defined(XMATH_SIMD_SSE)
+  _mm_storel_pi((__m64*)p, a);
+  _mm_store_ss(p + 2, _mm_movehl_ps(a, a));
+#elif defined(XMATH_SIMD_NEON)
+  vst1_f32(p, vget_low_f32(a));
+  vst1q_lane_f32(p + 2, a, 2);
+#else
+  p[0] = a.v[0];
+  p[1] = a.v[1];
+  p[2] = a.v[2];
+#endif
+}
+
+/**
+ * @brief Pack four floats, x goes into the first lane.
+ */
+static inline F32x4 F32x4Set(float x, float y, float z, float w) {
+#if defined(XMATH_SIMD_SSE)
+  return _mm_set_ps(w, z, y, x);
+#elif defined(XMATH_SIMD_NEON)
+  float p[4] = {x, y, z, w};
+  return vld1q_f32(p);
+#else
+  return (F32x4){{x, y, z, w}};
+#endif
+}
+
+/**
+ * @brief Broadcast a float into the four lanes.
+ */
+static inline F32x4 F32x4Splat(float s) {
+#if defined(XMATH_SIMD_SSE)
+  return _mm_set1_ps(s);
+#elif defined(XMATH_SIMD_NEON)
+  return vdupq_n_f32(s);
+#else
+  return (F32x4){{s, s, s, s}};
+#endif
+}
+
+/**
+ * @brief Get the value of the first lane.
+ */
+static inline float F32x4GetX(F32x4 a) {
+#if defined(XMATH_SIMD_SSE)
+  return _mm_cvtss_f32(a);
+#elif defined(XMATH_SIMD_NEON)
+  return vgetq_lane_f32(a, 0);
+#else
+  return a.v[0];
+#endif
+}
+
+//! @brief Lane wise a + b.
+static inline F32x4 F32x4Add(F32x4 a, F32x4 b) {
+#if defined(XMATH_SIMD_SSE)
+  return _mm_add_ps(a, b);
+#elif defined(XMATH_SIMD_NEON)
+  return vaddq_f32(a, b);
+#else
+  return (F32x4){{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2],
+                  a.v[3] + b.v[3]}};
+#endif
+}
+
+//! @brief Lane wise a - b.
+static inline F32x4 F32x4Sub(F32x4 a, F32x4 b) {
+#if defined(XMATH_SIMD_SSE)
+  return _mm_sub_ps(a, b);
+#elif defined(XMATH_SIMD_NEON)
+  return vsubq_f32(a, b);
+#else
+  return (F32x4){{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2],
+                  a.v[3] - b.v[3]}};
+#endif
+}
+
+//! @brief Lane wise a * b.
+static inline F32x4 F32x4Mul(F32x4 a, F32x4 b) {
+#if defined(XMATH_SIMD_SSE)
+  return _mm_mul_ps(a, b);
+#elif defined(XMATH_SIMD_NEON)
+  return vmulq_f32(a, b);
+#else
+  return (F32x4){{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2],
+                  a.v[3] * b.v[3]}};
+#endif
+}
+
+//! @brief Lane wise a * b + c, fused when the target supports it.
+static inline F32x4 F32x4MulAdd(F32x4 a, F32x4 b, F32x4 c) {
+#if defined(XMATH_SIMD_FMA)
+  return _mm_fmadd_ps(a, b, c);
+#elif defined(XMATH_SIMD_NEON) && defined(__aarch64__)
+  return vfmaq_f32(c, a, b);
+#else
+  return F32x4Add(F32x4Mul(a, b), c);
+#endif
+}
+
+//! @brief Lane wise maximum, picks a when a > b like FMax.
+static inline F32x4 F32x4Max(F32x4 a, F32x4 b) {
+#if defined(XMATH_SIMD_SSE)
+  return _mm_max_ps(a, b);
+#elif defined(XMATH_SIMD_NEON)
+  return vmaxq_f32(a, b);
+#else
+  return (F32x4){{a.v[0] > b.v[0] ? a.v[0] : b.v[0],
+                  a.v[1] > b.v[1] ? a.v[1] : b.v[1],
+                  a.v[2] > b.v[2] ? a.v[2] : b.v[2],
+                  a.v[3] > b.v[3] ? a.v[3] : b.v[3]}};
+#endif
+}
+
+//! @brief Lane wise minimum, picks a when a < b like FMin.
+static inline F32x4 F32x4Min(F32x4 a, F32x4 b) {
+#if defined(XMATH_SIMD_SSE)
+  return _mm_min_ps(a, b);
+#elif defined(XMATH_SIMD_NEON)
+  return vminq_f32(a, b);
+#else
+  return (F32x4){{a.v[0] < b.v[0] ? a.v[0] : b.v[0],
+                  a.v[1] < b.v[1] ? a.v[1] : b.v[1],
+                  a.v[2] < b.v[2] ? a.v[2] : b.v[2],
+                  a.v[3] < b.v[3] ? a.v[3] : b.v[3]}};
+#endif
+}
+
+//! @brief Lane wise a / b.
+static inline F32x4 F32x4Div(F32x4 a, F32x4 b) {
+#if defined(XMATH_SIMD_SSE)
+  return _mm_div_ps(a, b);
+#elif defined(XMATH_SIMD_NEON) && defined(__aarch64__)
+  return vdivq_f32(a, b);
+#else
+  float av[4];
+  float bv[4];
+  F32x4Store(av, a);
+  F32x4Store(bv, b);
+  for (unsigned i = 0; i < 4; i++) {
+    av[i] = av[i] / bv[i];
+  }
+  return F32x4Load(av);
+#endif
+}
+
+//! @brief Lane wise square root.
+static inline F32x4 F32x4Sqrt(F32x4 a) {
+#if defined(XMATH_SIMD_SSE)
+  return _mm_sqrt_ps(a);
+#elif defined(XMATH_SIMD_NEON) && defined(__aarch64__)
+  return vsqrtq_f32(a);
+#else
+  float av[4];
+  F32x4Store(av, a);
+  for (unsigned i = 0; i < 4; i++) {
+    av[i] = sqrtf(av[i]);
+  }
+  return F32x4Load(av);
+#endif
+}
+
+/**
+ * @brief Lane wise a < b as a mask for F32x4Select.
+ *
+ * Lanes are all bits set where the comparison holds and zero elsewhere.
+ */
+static inline F32x4 F32x4Less(F32x4 a, F32x4 b) {
+#if defined(XMATH_SIMD_SSE)
+  return _mm_cmplt_ps(a, b);
+#elif defined(XMATH_SIMD_NEON)
+  return vreinterpretq_f32_u32(vcltq_f32(a, b));
+#else
+  F32x4 r;
+  for (unsigned i = 0; i < 4; i++) {
+    uint32_t bits = a.v[i] < b.v[i] ? 0xFFFFFFFFu : 0u;
+    memcpy(&r.v[i], &bits, sizeof(float));
+  }
+  return r;
+#endif
+}
+
+//! @brief Lane wise pick of a where mask is set and b elsewhere.
+static inline F32x4 F32x4Select(F32x4 mask, F32x4 a, F32x4 b) {
+#if defined(XMATH_SIMD_SSE4)
+  return _mm_blendv_ps(b, a, mask);
+#elif defined(XMATH_SIMD_SSE)
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+#elif defined(XMATH_SIMD_NEON)
+  return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+#else
+  F32x4 r;
+  for (unsigned i = 0; i < 4; i++) {
+    uint32_t bits;
+    memcpy(&bits, &mask.v[i], sizeof(float));
+    r.v[i] = bits != 0u ? a.v[i] : b.v[i];
+  }
+  return r;
+#endif
+}
+
+/**
+ * @brief Horizontal sum of the four lanes.
+ */
+static inline float F32x4Sum(F32x4 a) {
+#if defined(XMATH_SIMD_SSE)
+  __m128 hi = _mm_movehl_ps(a, a);
+  __m128 s = _mm_add_ps(a, hi);
+  s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+  return _mm_cvtss_f32(s);
+#elif defined(XMATH_SIMD_NEON) && defined(__aarch64__)
+  return vaddvq_f32(a);
+#elif defined(XMATH_SIMD_NEON)
+  float32x2_t s = vadd_f32(vget_low_f32(a), vget_high_f32(a));
+  return vget_lane_f32(vpadd_f32(s, s), 0);
+#else
+  return (a.v[0] + a.v[1]) + (a.v[2] + a.v[3]);
+#endif
+}
+
+/**
+ * @brief Dot product of the four lanes of a and b.
+ */
+static inline float F32x4Dot(F32x4 a, F32x4 b) {
+#if defined(XMATH_SIMD_SSE4)
+  return _mm_cvtss_f32(_mm_dp_ps(a, b, 0xF1));
+#else
+  return F32x4Sum(F32x4Mul(a, b));
+#endif
+}
+
+/**
+ * @brief Rearrange the lanes of v, each index selects the source lane.
+ *
+ * Indices must be compile time constants between 0 and 3.
+ */
+#if defined(XMATH_SIMD_SSE)
+#define F32x4Swizzle(v, x, y, z, w) \
+  _mm_shuffle_ps((v), (v), _MM_SHUFFLE((w), (z), (y), (x)))
+#else
+#define F32x4Swizzle(v, x, y, z, w) F32x4SwizzleLanes((v), (x), (y), (z), (w))
+
+static inline F32x4 F32x4SwizzleLanes(F32x4 v,
+                                      int x,
+                                      int y,
+                                      int z,
+                                      int w) {
+  float p[4];
+  F32x4Store(p, v);
+  return F32x4Set(p[x], p[y], p[z], p[w]);
+}
+#endif
+
+/**
+ * @brief Transpose four rows of four lanes in place.
+ */
+static inline void F32x4Transpose(F32x4* r0, F32x4* r1, F32x4* r2, F32x4* r3) {
+#if defined(XMATH_SIMD_SSE)
+  _MM_TRANSPOSE4_PS(*r0, *r1, *r2, *r3);
+#elif defined(XMATH_SIMD_NEON)
+  float32x4x2_t t01 = vtrnq_f32(*r0, *r1);
+  float32x4x2_t t23 = vtrnq_f32(*r2, *r3);
+  *r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+  *r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+  *r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+  *r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+#else
+  F32x4 a = *r0;
+  F32x4 b = *r1;
+  F32x4 c = *r2;
+  F32x4 d = *r3;
+  *r0 = (F32x4){{a.v[0], b.v[0], c.v[0], d.v[0]}};
+  *r1 = (F32x4){{a.v[1], b.v[1], c.v[1], d.v[1]}};
+  *r2 = (F32x4){{a.v[2], b.v[2], c.v[2], d.v[2]}};
+  *r3 = (F32x4){{a.v[3], b.v[3], c.v[3], d.v[3]}};
+#endif
+}
+
+/**
+ * @brief Eight packed single precision floats.
+ */
+#if defined(XMATH_SIMD_AVX)
+typedef __m256 F32x8;
+#else
+typedef struct {
+  F32x4 lo;
+  F32x4 hi;
+} F32x8;
+#endif
+
+/**
+ * @brief Load eight floats from an unaligned address.
+ */
+static inline F32x8 F32x8Load(const float* p) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_loadu_ps(p);
+#else
+  return (F32x8){F32x4Load(p), F32x4Load(p + 4)};
+#endif
+}
+
+/**
+ * @brief Store eight floats into an unaligned address.
+ */
+static inline void F32x8Store(float* p, F32x8 a) {
+#if defined(XMATH_SIMD_AVX)
+  _mm256_storeu_ps(p, a);
+#else
+  F32x4Store(p, a.lo);
+  F32x4Store(p + 4, a.hi);
+#endif
+}
+
+/**
+ * @brief Broadcast a float into the eight lanes.
+ */
+static inline F32x8 F32x8Splat(float s) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_set1_ps(s);
+#else
+  return (F32x8){F32x4Splat(s), F32x4Splat(s)};
+#endif
+}
+
+/**
+ * @brief Load four floats into both halves of the eight lanes.
+ */
+static inline F32x8 F32x8Broadcast4(const float* p) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_broadcast_ps((const __m128*)p);
+#else
+  F32x4 a = F32x4Load(p);
+  return (F32x8){a, a};
+#endif
+}
+
+/**
+ * @brief Join two groups of four lanes, lo goes into the first four lanes.
+ */
+static inline F32x8 F32x8Combine(F32x4 lo, F32x4 hi) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+#else
+  return (F32x8){lo, hi};
+#endif
+}
+
+//! @brief First four lanes.
+static inline F32x4 F32x8Lo(F32x8 a) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_castps256_ps128(a);
+#else
+  return a.lo;
+#endif
+}
+
+//! @brief Last four lanes.
+static inline F32x4 F32x8Hi(F32x8 a) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_extractf128_ps(a, 1);
+#else
+  return a.hi;
+#endif
+}
+
+//! @brief Lane wise a + b.
+static inline F32x8 F32x8Add(F32x8 a, F32x8 b) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_add_ps(a, b);
+#else
+  return (F32x8){F32x4Add(a.lo, b.lo), F32x4Add(a.hi, b.hi)};
+#endif
+}
+
+//! @brief Lane wise a - b.
+static inline F32x8 F32x8Sub(F32x8 a, F32x8 b) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_sub_ps(a, b);
+#else
+  return (F32x8){F32x4Sub(a.lo, b.lo), F32x4Sub(a.hi, b.hi)};
+#endif
+}
+
+//! @brief Lane wise a * b.
+static inline F32x8 F32x8Mul(F32x8 a, F32x8 b) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_mul_ps(a, b);
+#else
+  return (F32x8){F32x4Mul(a.lo, b.lo), F32x4Mul(a.hi, b.hi)};
+#endif
+}
+
+//! @brief Lane wise a * b + c, fused when the target supports it.
+static inline F32x8 F32x8MulAdd(F32x8 a, F32x8 b, F32x8 c) {
+#if defined(XMATH_SIMD_AVX) && defined(XMATH_SIMD_FMA)
+  return _mm256_fmadd_ps(a, b, c);
+#elif defined(XMATH_SIMD_AVX)
+  return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#else
+  return (F32x8){F32x4MulAdd(a.lo, b.lo, c.lo), F32x4MulAdd(a.hi, b.hi, c.hi)};
+#endif
+}
+
+//! @brief Lane wise maximum, picks a when a > b like FMax.
+static inline F32x8 F32x8Max(F32x8 a, F32x8 b) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_max_ps(a, b);
+#else
+  return (F32x8){F32x4Max(a.lo, b.lo), F32x4Max(a.hi, b.hi)};
+#endif
+}
+
+//! @brief Lane wise minimum, picks a when a < b like FMin.
+static inline F32x8 F32x8Min(F32x8 a, F32x8 b) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_min_ps(a, b);
+#else
+  return (F32x8){F32x4Min(a.lo, b.lo), F32x4Min(a.hi, b.hi)};
+#endif
+}
+
+//! @brief Lane wise a / b.
+static inline F32x8 F32x8Div(F32x8 a, F32x8 b) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_div_ps(a, b);
+#else
+  return (F32x8){F32x4Div(a.lo, b.lo), F32x4Div(a.hi, b.hi)};
+#endif
+}
+
+//! @brief Lane wise square root.
+static inline F32x8 F32x8Sqrt(F32x8 a) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_sqrt_ps(a);
+#else
+  return (F32x8){F32x4Sqrt(a.lo), F32x4Sqrt(a.hi)};
+#endif
+}
+
+//! @brief Lane wise a < b as a mask for F32x8Select.
+static inline F32x8 F32x8Less(F32x8 a, F32x8 b) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+#else
+  return (F32x8){F32x4Less(a.lo, b.lo), F32x4Less(a.hi, b.hi)};
+#endif
+}
+
+//! @brief Lane wise pick of a where mask is set and b elsewhere.
+static inline F32x8 F32x8Select(F32x8 mask, F32x8 a, F32x8 b) {
+#if defined(XMATH_SIMD_AVX)
+  return _mm256_blendv_ps(b, a, mask);
+#else
+  return (F32x8){F32x4Select(mask.lo, a.lo, b.lo),
+                 F32x4Select(mask.hi, a.hi, b.hi)};
+#endif
+}
+
+/**
+ * @brief Broadcast lane i of each half of v into the whole half.
+ *
+ * The index must be a compile time constant between 0 and 3.
+ */
+#if defined(XMATH_SIMD_AVX)
+#define F32x8SplatLane(v, i) _mm256_permute_ps((v), (i) * 0x55)
+#else
+#define F32x8SplatLane(v, i)                  \
+  ((F32x8){F32x4Swizzle((v).lo, i, i, i, i), \
+           F32x4Swizzle((v).hi, i, i, i, i)})
+#endif
+
+#endif /* XMATH_SIMD_H */
@@ -0,0 +1,112 @@
+#include "skinning.h"
+#include <assert.h>
+#include "batch.h"
+#include "dispatch_table.h"
+
+// Skin vertices [first, first + count) against palette, read as floats.
+typedef void (*SkinRangeFn)(const SkinMesh* mesh,
+                            const float* palette,
+                            size_t stride,
+                            size_t first,
+                            size_t count);
+
+// Both matrix palettes are read as rows, entries stride floats apart.
+static void SkinLinearRange(const SkinMesh* mesh,
+                            const float* palette,
+                            size_t stride,
+                            size_t first,
+                            size_t count) {
+  assert(mesh != NULL && palette != NULL);
+  assert(first <= mesh->count && count <= mesh->count - first);
+  const size_t n = XMATH_SKIN_INFLUENCES;
+  const Vec3* normals = mesh->normals;
+  Vec3* outNormals = NULL;
+  if (normals != NULL) {
+    normals += first;
+    outNormals = mesh->outNormals + first;
+  }
+  DispatchSkinLinear(palette, stride, mesh->joints + n * first,
+                     mesh->weights + n * first, mesh->positions + first,
+                     normals, mesh->outPositions + first, outNormals, count);
+}
+
+static void SkinDualQuatRange(const SkinMesh* mesh,
+                              const float* palette,
+                              size_t stride,
+                              size_t first,
+                              size_t count) {
+  // The stride is only there to share SkinRangeFn, dual quaternions are 8.
+  (void)stride;
+  assert(mesh != NULL && palette != NULL && stride == 8);
+  assert(first <= mesh->count && count <= mesh->count - first);
+  const size_t n = XMATH_SKIN_INFLUENCES;
+  const Vec3* normals = mesh->normals;
+  Vec3* outNormals = NULL;
+  if (normals != NULL) {
+    normals += first;
+    outNormals = mesh->outNormals + first;
+  }
+  DispatchSkinDualQuat(palette, mesh->joints + n * first,
+                       mesh->weights + n * first, mesh->positions + first,
+                       normals, mesh->outPositions + first, outNormals, count);
+}
+
+XMATH_API void SkinLinearMat4(const SkinMesh* mesh,
+                              const Mat4* palette,
+                              size_t first,
+                              size_t count) {
+  SkinLinearRange(mesh, (const float*)palette, 16, first, count);
+}
+
+XMATH_API void SkinLinearAffine34(const SkinMesh* mesh,
+                                  const Affine34* palette,
+                                  size_t first,
+                                  size_t count) {
+  SkinLinearRange(mesh, (const float*)palette, 12, first, count);
+}
+
+XMATH_API void SkinDualQuat(const SkinMesh* mesh,
+                            const DualQuat* palette,
+                            size_t first,
+                            size_t count) {
+  SkinDualQuatRange(mesh, (const float*)palette, 8, first, count);
+}
+
+typedef struct {
+  const SkinMesh* mesh;
+  const float* palette;
+  size_t stride;
+  SkinRangeFn range;
+} SkinJob;
+
+static void SkinTask(void* user, size_t first, size_t count) {
+  const SkinJob* job = user;
+  job->range(job->mesh, job->palette, job->stride, first, count);
+}
+
+static void SkinParallel(ThreadPool* pool, const SkinJob* job) {
+  assert(job->mesh != NULL);
+  ThreadPoolFor(pool, job->mesh->count, XMATH_SKIN_GRAIN, SkinTask,
+                (void*)job);
+}
+
+XMATH_API void SkinLinearMat4Parallel(const SkinMesh* mesh,
+                                      const Mat4* palette,
+                                      ThreadPool* pool) {
+  SkinJob job = {mesh, (const float*)palette, 16, SkinLinearRange};
+  SkinParallel(pool, &job);
+}
+
+XMATH_API void SkinLinearAffine34Parallel(const SkinMesh* mesh,
+                                          const Affine34* palette,
+                                          ThreadPool* pool) {
+  SkinJob job = {mesh, (const float*)palette, 12, SkinLinearRange};
+  SkinParallel(pool, &job);
+}
+
+XMATH_API void SkinDualQuatParallel(const SkinMesh* mesh,
+                                    const DualQuat* palette,
+                                    ThreadPool* pool) {
+  SkinJob job = {mesh, (const float*)palette, 8, SkinDualQuatRange};
+  SkinParallel(pool, &job);
+}
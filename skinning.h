@@ -0,0 +1,134 @@
+/**
+ * @file skinning.h
+ * @brief Linear blend and dual quaternion skinning on the CPU.
+ *
+ * Every vertex is bound to XMATH_SKIN_INFLUENCES joints of a palette of
+ * bones. Linear blend skinning maps the position by the weighted sum of the
+ * matrices of its joints and the normal by the linear part of the same sum.
+ * Dual quaternion skinning maps both by DualQuatBlend of the bones instead:
+ * the palette takes half the memory of a Mat4 one and twisted joints keep
+ * their volume, but the bones cannot scale.
+ *
+ * A Mat4 palette uses the layout of TransformToMat4 and of the world
+ * matrices of a Hierarchy: the point is the row (x, y, z, 1) and the
+ * translation is in wx, wy and wz, so those matrices are used as they are. An
+ * Affine34 palette holds the transpose of the first three columns, as given
+ * by TransformToAffine34.
+ *
+ * The functions take a range of vertices, so a mesh can be split in chunks
+ * and skinned from several threads; the Parallel variants do it through a
+ * ThreadPool.
+ */
+#ifndef XMATH_SKINNING_H
+#define XMATH_SKINNING_H
+#include <stddef.h>
+#include <stdint.h>
+#include "affine34.h"
+#include "api.h"
+#include "dualquat.h"
+#include "mat4.h"
+#include "threadpool.h"
+#include "vec3.h"
+
+//! @brief Joints bound to every vertex.
+#define XMATH_SKIN_INFLUENCES 4
+
+//! @brief Vertices per chunk of the Parallel variants.
+#define XMATH_SKIN_GRAIN 1024
+
+/**
+ * @brief Vertex streams of a skinned mesh.
+ *
+ * joints and weights hold XMATH_SKIN_INFLUENCES entries per vertex. Unused
+ * influences take a weight of zero and any valid joint. The weights should
+ * add up to one, they are not normalized.
+ *
+ * normals is NULL to skin positions only, outNormals is then not used. The
+ * outputs can be the inputs; the skinned normals are not normalized.
+ */
+typedef struct {
+  const Vec3* positions;
+  const Vec3* normals;
+  const uint16_t* joints;
+  const float* weights;
+  Vec3* outPositions;
+  Vec3* outNormals;
+  size_t count;
+} SkinMesh;
+
+/**
+ * @brief Skin a range of vertices with a palette of Mat4.
+ * @param mesh vertex streams.
+ * @param palette bone matrices indexed by the joints.
+ * @param first first vertex to skin.
+ * @param count number of vertices, first + count must not pass mesh->count.
+ */
+XMATH_API void SkinLinearMat4(const SkinMesh* mesh,
+                              const Mat4* palette,
+                              size_t first,
+                              size_t count);
+
+/**
+ * @brief Skin a range of vertices with a palette of Affine34.
+ * @param mesh vertex streams.
+ * @param palette bone transforms indexed by the joints.
+ * @param first first vertex to skin.
+ * @param count number of vertices, first + count must not pass mesh->count.
+ */
+XMATH_API void SkinLinearAffine34(const SkinMesh* mesh,
+                                  const Affine34* palette,
+                                  size_t first,
+                                  size_t count);
+
+/**
+ * @brief Skin every vertex of a mesh with a palette of Mat4, in chunks of
+ * XMATH_SKIN_GRAIN vertices spread over a pool.
+ * @param mesh vertex streams.
+ * @param palette bone matrices indexed by the joints.
+ * @param pool pool to run on, NULL skins on the calling thread.
+ */
+XMATH_API void SkinLinearMat4Parallel(const SkinMesh* mesh,
+                                      const Mat4* palette,
+                                      ThreadPool* pool);
+
+/**
+ * @brief Skin every vertex of a mesh with a palette of Affine34, in chunks of
+ * XMATH_SKIN_GRAIN vertices spread over a pool.
+ * @param mesh vertex streams.
+ * @param palette bone transforms indexed by the joints.
+ * @param pool pool to run on, NULL skins on the calling thread.
+ */
+XMATH_API void SkinLinearAffine34Parallel(const SkinMesh* mesh,
+                                          const Affine34* palette,
+                                          ThreadPool* pool);
+
+/**
+ * @brief Skin a range of vertices with a palette of unit DualQuat.
+ *
+ * The weights of every vertex must not add up to zero.
+ * @param mesh vertex streams.
+ * @param palette bone transforms indexed by the joints.
+ * @param first first vertex to skin.
+ * @param count number of vertices, first + count must not pass mesh->count.
+ */
+XMATH_API void SkinDualQuat(const SkinMesh* mesh,
+                            const DualQuat* palette,
+                            size_t first,
+                            size_t count);
+
+/**
+ * @brief Skin every vertex of a mesh with a palette of unit DualQuat, in
+ * chunks of XMATH_SKIN_GRAIN vertices spread over a pool.
+ * @param mesh vertex streams.
+ * @param palette bone transforms indexed by the joints.
+ * @param pool pool to run on, NULL skins on the calling thread.
+ */
+XMATH_API void SkinDualQuatParallel(const SkinMesh* mesh,
+                                    const DualQuat* palette,
+                                    ThreadPool* pool);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "skinning.c"
+#endif
+
+#endif /* XMATH_SKINNING_H */
@@ -0,0 +1,327 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "skinning.h"
+#include "common_testing.h"
+#include "hierarchy.h"
+#include "scalar.h"
+#include "vec4.h"
+
+#define BONES 5
+#define COUNT 23
+
+static Mat4 gMat4s[BONES];
+static Affine34 gAffines[BONES];
+static DualQuat gDualQuats[BONES];
+static Vec3 gPositions[COUNT];
+static Vec3 gNormals[COUNT];
+static uint16_t gJoints[COUNT * XMATH_SKIN_INFLUENCES];
+static float gWeights[COUNT * XMATH_SKIN_INFLUENCES];
+
+static void FillInputs(void) {
+  for (unsigned b = 0; b < BONES; b++) {
+    float f = (float)b;
+    Transform t = {
+        .position = {0.5f * f, -0.25f * f, 1.0f},
+        .rotation = QuatMakeAngleAxis(0.4f * f, Vec3Norm((Vec3){f, 1, 2})),
+        .scale = {1.0f + 0.1f * f, 1.0f, 1.0f - 0.05f * f},
+    };
+    gAffines[b] = TransformToAffine34(t);
+    gMat4s[b] = TransformToMat4(t);
+
+    // Odd bones in the other hemisphere, it must not change the blend.
+    gDualQuats[b] = TransformToDualQuat(t);
+    if (b % 2 == 1) {
+      gDualQuats[b].real = QuatNeg(gDualQuats[b].real);
+      gDualQuats[b].dual = QuatNeg(gDualQuats[b].dual);
+    }
+  }
+
+  for (unsigned i = 0; i < COUNT; i++) {
+    float f = (float)i;
+    gPositions[i] = (Vec3){0.1f * f, 1.0f - 0.05f * f, 0.3f};
+    gNormals[i] = Vec3Norm((Vec3){1.0f, f, -2.0f});
+
+    // Weights add up to one, the last influence is unused on odd vertices.
+    uint16_t* j = gJoints + XMATH_SKIN_INFLUENCES * i;
+    float* w = gWeights + XMATH_SKIN_INFLUENCES * i;
+    float last = (i % 2 == 0) ? 0.1f : 0.0f;
+    for (unsigned k = 0; k < XMATH_SKIN_INFLUENCES; k++) {
+      j[k] = (uint16_t)((i + 2 * k) % BONES);
+    }
+    w[0] = 0.5f;
+    w[1] = 0.3f - last;
+    w[2] = 0.2f;
+    w[3] = last;
+  }
+}
+
+// Row (v, w) times a matrix in the TransformToMat4 layout.
+static Vec4 MapRow(Mat4 m, Vec3 v, float w) {
+  Vec4 r = Vec4Scale(Mat4Row(m, 0), v.x);
+  r = Vec4Add(r, Vec4Scale(Mat4Row(m, 1), v.y));
+  r = Vec4Add(r, Vec4Scale(Mat4Row(m, 2), v.z));
+  return Vec4Add(r, Vec4Scale(Mat4Row(m, 3), w));
+}
+
+// The per vertex loop the skinning functions replace.
+static void ExpectedVertex(Vec3* p, Vec3* n, unsigned i) {
+  Vec4 rp = {0};
+  Vec4 rn = {0};
+  for (unsigned k = 0; k < XMATH_SKIN_INFLUENCES; k++) {
+    Mat4 m = gMat4s[gJoints[XMATH_SKIN_INFLUENCES * i + k]];
+    float w = gWeights[XMATH_SKIN_INFLUENCES * i + k];
+    rp = Vec4Add(rp, Vec4Scale(MapRow(m, gPositions[i], 1.0f), w));
+    rn = Vec4Add(rn, Vec4Scale(MapRow(m, gNormals[i], 0.0f), w));
+  }
+  *p = (Vec3){rp.x, rp.y, rp.z};
+  *n = (Vec3){rn.x, rn.y, rn.z};
+}
+
+static SkinMesh MakeMesh(Vec3* outPositions, Vec3* outNormals) {
+  return (SkinMesh){
+      .positions = gPositions,
+      .normals = gNormals,
+      .joints = gJoints,
+      .weights = gWeights,
+      .outPositions = outPositions,
+      .outNormals = outNormals,
+      .count = COUNT,
+  };
+}
+
+static void AssertSkinned(const Vec3* positions, const Vec3* normals) {
+  for (unsigned i = 0; i < COUNT; i++) {
+    Vec3 p;
+    Vec3 n;
+    ExpectedVertex(&p, &n, i);
+    assert_true(Vec3EqualApprox(positions[i], p));
+    assert_true(Vec3EqualApprox(normals[i], n));
+  }
+}
+
+static void test_SkinLinearMat4(void** state) {
+  UNUSED(state);
+
+  Vec3 positions[COUNT];
+  Vec3 normals[COUNT];
+  FillInputs();
+  SkinMesh mesh = MakeMesh(positions, normals);
+
+  // Chunks of any size cover the mesh.
+  SkinLinearMat4(&mesh, gMat4s, 0, 7);
+  SkinLinearMat4(&mesh, gMat4s, 7, 1);
+  SkinLinearMat4(&mesh, gMat4s, 8, COUNT - 8);
+  AssertSkinned(positions, normals);
+}
+
+static void test_SkinLinearHierarchy(void** state) {
+  UNUSED(state);
+
+  // A chain of bones with uniform scales, so the world transforms are the
+  // same maps as the world matrices used as the palette.
+  Hierarchy h;
+  assert_true(HierarchyMake(&h, BONES));
+  uint32_t parent = XMATH_HIERARCHY_NONE;
+  for (unsigned b = 0; b < BONES; b++) {
+    float f = (float)b;
+    Vec3 axis = Vec3Norm((Vec3){f, 1, 2});
+    Transform t = {
+        .position = {0.5f, -0.25f * f, 0.1f},
+        .rotation = QuatMakeAngleAxis(0.3f + 0.2f * f, axis),
+        .scale = Vec3Scale(Vec3One, 1.0f - 0.05f * f),
+    };
+    parent = HierarchyAdd(&h, parent, t);
+  }
+  HierarchyUpdate(&h);
+
+  Vec3 positions[COUNT];
+  Vec3 normals[COUNT];
+  FillInputs();
+  SkinMesh mesh = MakeMesh(positions, normals);
+  SkinLinearMat4(&mesh, h.worldMatrix, 0, COUNT);
+  for (unsigned i = 0; i < COUNT; i++) {
+    Vec3 p = Vec3Zero;
+    Vec3 n = Vec3Zero;
+    for (unsigned k = 0; k < XMATH_SKIN_INFLUENCES; k++) {
+      Transform t = h.world[gJoints[XMATH_SKIN_INFLUENCES * i + k]];
+      float w = gWeights[XMATH_SKIN_INFLUENCES * i + k];
+      p = Vec3Add(p, Vec3Scale(TransformPoint(t, gPositions[i]), w));
+      n = Vec3Add(n, Vec3Scale(TransformVec3(t, gNormals[i]), w));
+    }
+    assert_true(Vec3EqualApprox(positions[i], p));
+    assert_true(Vec3EqualApprox(normals[i], n));
+  }
+  HierarchyFree(&h);
+}
+
+static void test_SkinLinearAffine34(void** state) {
+  UNUSED(state);
+
+  Vec3 positions[COUNT];
+  Vec3 normals[COUNT];
+  FillInputs();
+  SkinMesh mesh = MakeMesh(positions, normals);
+  SkinLinearAffine34(&mesh, gAffines, 0, COUNT);
+  AssertSkinned(positions, normals);
+}
+
+static void test_SkinLinearNoNormals(void** state) {
+  UNUSED(state);
+
+  Vec3 positions[COUNT];
+  Vec3 normals[COUNT];
+  Vec3 expected[COUNT];
+  FillInputs();
+  SkinMesh mesh = MakeMesh(expected, normals);
+  SkinLinearAffine34(&mesh, gAffines, 0, COUNT);
+
+  // In place, normals untouched.
+  for (unsigned i = 0; i < COUNT; i++) {
+    positions[i] = gPositions[i];
+    normals[i] = Vec3Zero;
+  }
+  mesh.positions = positions;
+  mesh.outPositions = positions;
+  mesh.normals = NULL;
+  SkinLinearMat4(&mesh, gMat4s, 0, COUNT);
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_true(Vec3EqualApprox(positions[i], expected[i]));
+    assert_true(Vec3EqualApprox(normals[i], Vec3Zero));
+  }
+}
+
+static void test_SkinDualQuat(void** state) {
+  UNUSED(state);
+
+  Vec3 positions[COUNT];
+  Vec3 normals[COUNT];
+  FillInputs();
+  SkinMesh mesh = MakeMesh(positions, normals);
+
+  // Chunks that are not whole blocks of four.
+  SkinDualQuat(&mesh, gDualQuats, 0, 5);
+  SkinDualQuat(&mesh, gDualQuats, 5, 10);
+  SkinDualQuat(&mesh, gDualQuats, 15, COUNT - 15);
+  for (unsigned i = 0; i < COUNT; i++) {
+    DualQuat bones[XMATH_SKIN_INFLUENCES];
+    for (unsigned k = 0; k < XMATH_SKIN_INFLUENCES; k++) {
+      bones[k] = gDualQuats[gJoints[XMATH_SKIN_INFLUENCES * i + k]];
+    }
+    DualQuat dq = DualQuatBlend(bones, gWeights + XMATH_SKIN_INFLUENCES * i,
+                                XMATH_SKIN_INFLUENCES);
+    assert_true(Vec3EqualApprox(positions[i],
+                                DualQuatTransformPoint(dq, gPositions[i])));
+    assert_true(
+        Vec3EqualApprox(normals[i], DualQuatTransformVec3(dq, gNormals[i])));
+  }
+
+  // Rigid bones give the same result as linear blend skinning when every
+  // vertex follows a single bone.
+  for (unsigned i = 0; i < COUNT; i++) {
+    float* w = gWeights + XMATH_SKIN_INFLUENCES * i;
+    w[0] = 1.0f;
+    w[1] = 0.0f;
+    w[2] = 0.0f;
+    w[3] = 0.0f;
+  }
+  Vec3 linear[COUNT];
+  Vec3 linearNormals[COUNT];
+  SkinMesh linearMesh = MakeMesh(linear, linearNormals);
+  for (unsigned b = 0; b < BONES; b++) {
+    gMat4s[b] = TransformToMat4(DualQuatToTransform(gDualQuats[b]));
+  }
+  SkinLinearMat4(&linearMesh, gMat4s, 0, COUNT);
+  mesh.normals = NULL;
+  SkinDualQuat(&mesh, gDualQuats, 0, COUNT);
+  for (unsigned i = 0; i < COUNT; i++) {
+    // Both paths round differently, far from the origin too.
+    assert_float_equal(positions[i].x, linear[i].x, 1e-5f);
+    assert_float_equal(positions[i].y, linear[i].y, 1e-5f);
+    assert_float_equal(positions[i].z, linear[i].z, 1e-5f);
+  }
+}
+
+static void test_SkinLinearParallel(void** state) {
+  UNUSED(state);
+
+  // Enough vertices for several chunks, cycling over the sample ones.
+  enum { LARGE = 3 * XMATH_SKIN_GRAIN + 17 };
+  static Vec3 positions[LARGE];
+  static Vec3 normals[LARGE];
+  static Vec3 outPositions[LARGE];
+  static Vec3 outNormals[LARGE];
+  static uint16_t joints[LARGE * XMATH_SKIN_INFLUENCES];
+  static float weights[LARGE * XMATH_SKIN_INFLUENCES];
+  FillInputs();
+  for (unsigned i = 0; i < LARGE; i++) {
+    positions[i] = gPositions[i % COUNT];
+    normals[i] = gNormals[i % COUNT];
+    for (unsigned k = 0; k < XMATH_SKIN_INFLUENCES; k++) {
+      unsigned e = XMATH_SKIN_INFLUENCES * (i % COUNT) + k;
+      joints[XMATH_SKIN_INFLUENCES * i + k] = gJoints[e];
+      weights[XMATH_SKIN_INFLUENCES * i + k] = gWeights[e];
+    }
+  }
+
+  SkinMesh mesh = {
+      .positions = positions,
+      .normals = normals,
+      .joints = joints,
+      .weights = weights,
+      .outPositions = outPositions,
+      .outNormals = outNormals,
+      .count = LARGE,
+  };
+  ThreadPool pool;
+  assert_true(ThreadPoolMake(&pool, 3));
+  SkinLinearMat4Parallel(&mesh, gMat4s, &pool);
+  for (unsigned i = 0; i < LARGE; i++) {
+    Vec3 p;
+    Vec3 n;
+    ExpectedVertex(&p, &n, i % COUNT);
+    assert_true(Vec3EqualApprox(outPositions[i], p));
+    assert_true(Vec3EqualApprox(outNormals[i], n));
+  }
+
+  for (unsigned i = 0; i < LARGE; i++) {
+    outPositions[i] = Vec3Zero;
+  }
+  SkinLinearAffine34Parallel(&mesh, gAffines, NULL);
+  for (unsigned i = 0; i < LARGE; i++) {
+    Vec3 p;
+    Vec3 n;
+    ExpectedVertex(&p, &n, i % COUNT);
+    assert_true(Vec3EqualApprox(outPositions[i], p));
+  }
+
+  Vec3 serial[COUNT];
+  SkinMesh small = MakeMesh(serial, outNormals);
+  SkinDualQuat(&small, gDualQuats, 0, COUNT);
+  SkinDualQuatParallel(&mesh, gDualQuats, &pool);
+  for (unsigned i = 0; i < LARGE; i++) {
+    assert_true(Vec3EqualApprox(outPositions[i], serial[i % COUNT]));
+  }
+  ThreadPoolFree(&pool);
+}
+
+int main() {
+  UNUSED_TYPE(jmp_buf);
+  UNUSED_TYPE(va_list);
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_SkinLinearMat4),
+      cmocka_unit_test(test_SkinLinearHierarchy),
+      cmocka_unit_test(test_SkinLinearAffine34),
+      cmocka_unit_test(test_SkinLinearNoNormals),
+      cmocka_unit_test(test_SkinDualQuat),
+      cmocka_unit_test(test_SkinLinearParallel),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
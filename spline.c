@@ -0,0 +1,190 @@
+#include "spline.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "simd.h"
+
+// Alignment in bytes of the segments, one cache line each.
+#define XMATH_SPLINE_ALIGN 64
+
+static inline size_t SplineRoundUp(size_t count, size_t width) {
+  return (count + width - 1) / width * width;
+}
+
+XMATH_API bool SplineMake(Spline* r, size_t capacity) {
+  assert(r != NULL);
+
+  // The knots follow the segments in the same block.
+  size_t coeffs = capacity * XMATH_SPLINE_STRIDE;
+  size_t knots = SplineRoundUp(capacity + 1, XMATH_SPLINE_STRIDE);
+  size_t size = (coeffs + knots) * sizeof(float);
+#if defined(_MSC_VER)
+  float* block = _aligned_malloc(size, XMATH_SPLINE_ALIGN);
+#else
+  float* block = aligned_alloc(XMATH_SPLINE_ALIGN, size);
+#endif
+  if (block == NULL) {
+    *r = (Spline){0};
+    return false;
+  }
+
+  memset(block, 0, size);
+  r->coeffs = block;
+  r->knots = block + coeffs;
+  r->count = 0;
+  r->capacity = capacity;
+  r->spacing = 0.0f;
+  return true;
+}
+
+XMATH_API void SplineFree(Spline* s) {
+  assert(s != NULL);
+#if defined(_MSC_VER)
+  _aligned_free(s->coeffs);
+#else
+  free(s->coeffs);
+#endif
+  *s = (Spline){0};
+}
+
+// Every kind of segment ends here as its power basis k.
+static inline void SplineAppend(Spline* s, const Vec3 k[4], float duration) {
+  assert(s != NULL);
+  assert(s->count < s->capacity);
+  assert(duration > 0.0f);
+
+  float* dst = s->coeffs + s->count * XMATH_SPLINE_STRIDE;
+  for (unsigned i = 0; i < 4; i++) {
+    dst[4 * i] = k[i].x;
+    dst[4 * i + 1] = k[i].y;
+    dst[4 * i + 2] = k[i].z;
+    dst[4 * i + 3] = 0.0f;
+  }
+
+  // The spacing is kept only while every duration matches the first one.
+  if (s->count == 0) {
+    s->spacing = duration;
+  } else if (duration != s->spacing) {
+    s->spacing = 0.0f;
+  }
+  s->knots[s->count + 1] = s->knots[s->count] + duration;
+  s->count++;
+}
+
+XMATH_API void SplineAppendBeizer(Spline* s,
+                                  BeizerCurve curve,
+                                  float duration) {
+  Vec3 k[4];
+  BeizerPowerBasis(k, curve);
+  SplineAppend(s, k, duration);
+}
+
+XMATH_API void SplineAppendHermit(Spline* s,
+                                  HermitCurve curve,
+                                  float duration) {
+  Vec3 k[4];
+  HermitPowerBasis(k, curve);
+  SplineAppend(s, k, duration);
+}
+
+XMATH_API void SplineAppendCatmullRom(Spline* s,
+                                      const Vec3* points,
+                                      size_t count,
+                                      float duration) {
+  assert(count >= 4);
+  for (size_t i = 1; i + 2 < count; i++) {
+    // A hermit segment with the tangents (next - previous) / 2.
+    HermitCurve curve = {
+        .p1 = points[i],
+        .s1 = Vec3Scale(Vec3Sub(points[i + 1], points[i - 1]), 0.5f),
+        .p2 = points[i + 1],
+        .s2 = Vec3Scale(Vec3Sub(points[i + 2], points[i]), 0.5f),
+    };
+    Vec3 k[4];
+    HermitPowerBasis(k, curve);
+    SplineAppend(s, k, duration);
+  }
+}
+
+XMATH_API float SplineDuration(const Spline* s) {
+  assert(s != NULL);
+  return s->knots[s->count];
+}
+
+// Kept inline, it runs for every evaluated parameter.
+static inline float SplineClamp(float v, float lo, float hi) {
+  v = v > lo ? v : lo;
+  return v < hi ? v : hi;
+}
+
+// Segment of a clamped parameter.
+static inline size_t SplineSegment(const Spline* s, float u) {
+  size_t last = s->count - 1;
+  if (s->spacing > 0.0f) {
+    // The knots are sums of the spacing, so the guess can be off by a
+    // segment near a knot.
+    size_t i = (size_t)(u / s->spacing);
+    i = i < last ? i : last;
+    while (i > 0 && u < s->knots[i]) {
+      i--;
+    }
+    while (i < last && u >= s->knots[i + 1]) {
+      i++;
+    }
+    return i;
+  }
+
+  size_t lo = 0;
+  size_t hi = s->count;
+  while (hi - lo > 1) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (s->knots[mid] <= u) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// Point of segment i at a clamped parameter.
+static inline F32x4 SplineSegmentEvaluate(const Spline* s, size_t i, float u) {
+  float k0 = s->knots[i];
+  float t = (u - k0) / (s->knots[i + 1] - k0);
+  F32x4 f = F32x4Splat(SplineClamp(t, 0.0f, 1.0f));
+
+  const float* c = s->coeffs + i * XMATH_SPLINE_STRIDE;
+  F32x4 p = F32x4MulAdd(F32x4Load(c), f, F32x4Load(c + 4));
+  p = F32x4MulAdd(p, f, F32x4Load(c + 8));
+  return F32x4MulAdd(p, f, F32x4Load(c + 12));
+}
+
+XMATH_API size_t SplineFindSegment(const Spline* s, float u) {
+  assert(s != NULL && s->count > 0);
+  return SplineSegment(s, SplineClamp(u, 0.0f, s->knots[s->count]));
+}
+
+XMATH_API Vec3 SplineEvaluate(const Spline* s, float u) {
+  assert(s != NULL && s->count > 0);
+  u = SplineClamp(u, 0.0f, s->knots[s->count]);
+  Vec3 r;
+  F32x4Store3(&r.x, SplineSegmentEvaluate(s, SplineSegment(s, u), u));
+  return r;
+}
+
+XMATH_API void SplineEvaluateArray(Vec3* out,
+                                   const Spline* s,
+                                   const float* u,
+                                   size_t count) {
+  assert(s != NULL && s->count > 0);
+  size_t last = s->count - 1;
+  size_t i = 0;
+  for (size_t n = 0; n < count; n++) {
+    float v = SplineClamp(u[n], 0.0f, s->knots[s->count]);
+    bool inside = s->knots[i] <= v && (i == last || v < s->knots[i + 1]);
+    if (!inside) {
+      i = SplineSegment(s, v);
+    }
+    F32x4Store3(&out[n].x, SplineSegmentEvaluate(s, i, v));
+  }
+}
@@ -0,0 +1,130 @@
+/**
+ * @file spline.h
+ * @brief Splines made of many cubic segments.
+ *
+ * A Spline chains hermit, beizer and Catmull-Rom segments along a parameter
+ * u: segment i covers [knots[i], knots[i + 1]] and is evaluated at the local
+ * t = (u - knots[i]) / (knots[i + 1] - knots[i]). Every segment is stored as
+ * its power basis a t^3 + b t^2 + c t + d in one cache line, whatever kind it
+ * was appended as (see BeizerPowerBasis), so evaluating any of them is the
+ * same three multiply adds.
+ *
+ * The segment of a parameter is found by binary search on the knots, or
+ * directly from the parameter when every segment has the same duration.
+ */
+#ifndef XMATH_SPLINE_H
+#define XMATH_SPLINE_H
+#include <stdbool.h>
+#include <stddef.h>
+#include "api.h"
+#include "curves.h"
+#include "vec3.h"
+
+//! @brief Floats of every segment: a, b, c and d padded to four floats.
+#define XMATH_SPLINE_STRIDE 16
+
+/**
+ * @brief Chain of cubic segments.
+ *
+ * coeffs holds XMATH_SPLINE_STRIDE floats per segment and knots count + 1
+ * increasing parameters starting at zero. spacing is the duration shared by
+ * every segment, or zero when they differ.
+ */
+typedef struct {
+  float* coeffs;
+  float* knots;
+  size_t count;
+  size_t capacity;
+  float spacing;
+} Spline;
+
+/**
+ * @brief Allocate an empty spline with room for capacity segments.
+ * @param r spline to initialize.
+ * @param capacity maximum number of segments.
+ * @return false if the memory could not be allocated.
+ */
+XMATH_API bool SplineMake(Spline* r, size_t capacity);
+
+/**
+ * @brief Release the memory of a spline made by SplineMake.
+ * @param s spline to release, left empty.
+ */
+XMATH_API void SplineFree(Spline* s);
+
+/**
+ * @brief Append a beizer segment at the end of a spline.
+ * @param s spline with room for one more segment.
+ * @param curve segment to append, it does not need to start at the end of
+ * the spline.
+ * @param duration span of u covered by the segment (greater than zero).
+ */
+XMATH_API void SplineAppendBeizer(Spline* s, BeizerCurve curve, float duration);
+
+/**
+ * @brief Append a hermit segment at the end of a spline.
+ * @param s spline with room for one more segment.
+ * @param curve segment to append, evaluated like HermitInterpolate.
+ * @param duration span of u covered by the segment (greater than zero).
+ */
+XMATH_API void SplineAppendHermit(Spline* s, HermitCurve curve, float duration);
+
+/**
+ * @brief Append Catmull-Rom segments through a list of points.
+ *
+ * Every segment joins two consecutive points with the tangents of a uniform
+ * Catmull-Rom spline, (next - previous) / 2, so count points append count - 3
+ * segments going from points[1] to points[count - 2].
+ * @param s spline with room for count - 3 more segments.
+ * @param points list of count points.
+ * @param count number of points, at least four.
+ * @param duration span of u covered by each segment (greater than zero).
+ */
+XMATH_API void SplineAppendCatmullRom(Spline* s,
+                                      const Vec3* points,
+                                      size_t count,
+                                      float duration);
+
+/**
+ * @brief Get the last parameter of a spline.
+ * @param s spline to measure.
+ * @return the last knot, zero without segments.
+ */
+XMATH_API float SplineDuration(const Spline* s);
+
+/**
+ * @brief Find the segment holding a parameter.
+ * @param s spline with at least one segment.
+ * @param u parameter, clamped to the knots of the spline.
+ * @return the index of the segment, the later one on a shared knot.
+ */
+XMATH_API size_t SplineFindSegment(const Spline* s, float u);
+
+/**
+ * @brief Evaluate a spline at a parameter.
+ * @param s spline with at least one segment.
+ * @param u parameter, clamped to the knots of the spline.
+ * @return the point of the spline at u.
+ */
+XMATH_API Vec3 SplineEvaluate(const Spline* s, float u);
+
+/**
+ * @brief Evaluate a spline at many parameters.
+ *
+ * Parameters in any order are accepted, the segment of the previous one is
+ * tried first so increasing parameters rarely search.
+ * @param out destination of count points.
+ * @param s spline with at least one segment.
+ * @param u list of count parameters, each clamped like SplineEvaluate.
+ * @param count number of parameters.
+ */
+XMATH_API void SplineEvaluateArray(Vec3* out,
+                                   const Spline* s,
+                                   const float* u,
+                                   size_t count);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "spline.c"
+#endif
+
+#endif /* XMATH_SPLINE_H */
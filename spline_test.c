@@ -0,0 +1,173 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "spline.h"
+#include "common_testing.h"
+#include "scalar.h"
+
+static const BeizerCurve gBeizer = {
+    .p1 = {-1.0f, 0.0f, 0.5f},
+    .c1 = {-1.0f, 1.0f, 0.0f},
+    .p2 = {1.0f, 0.0f, -0.5f},
+    .c2 = {1.0f, 1.0f, 0.25f},
+};
+
+static const HermitCurve gHermit = {
+    .p1 = {1.0f, 0.0f, -0.5f},
+    .s1 = {0.0f, -1.0f, 0.5f},
+    .p2 = {0.5f, -0.5f, 0.0f},
+    .s2 = {-1.0f, 0.0f, 0.25f},
+};
+
+#define POINTS 7
+
+static const Vec3 gPoints[POINTS] = {
+    {0.0f, 0.0f, 0.0f},  {0.2f, 0.5f, 0.0f}, {0.6f, 0.4f, 0.1f},
+    {0.9f, -0.2f, 0.3f}, {0.5f, -0.6f, 0.2f}, {0.1f, -0.3f, 0.0f},
+    {-0.2f, 0.1f, -0.1f},
+};
+
+// Segment of u by a linear walk over the knots, the way callers did it.
+static size_t LinearSegment(const Spline* s, float u) {
+  size_t i = 0;
+  while (i + 1 < s->count && s->knots[i + 1] <= u) {
+    i++;
+  }
+  return i;
+}
+
+static void test_SplineMake(void** state) {
+  UNUSED(state);
+
+  Spline s;
+  assert_true(SplineMake(&s, 5));
+  assert_int_equal(s.count, 0);
+  assert_int_equal(s.capacity, 5);
+  assert_int_equal((uintptr_t)s.coeffs % 64, 0);
+  assert_float_equal(SplineDuration(&s), 0.0f, XMATH_EPSILON);
+
+  SplineFree(&s);
+  assert_true(s.coeffs == NULL);
+  assert_int_equal(s.capacity, 0);
+}
+
+static void test_SplineSegments(void** state) {
+  UNUSED(state);
+
+  Spline s;
+  assert_true(SplineMake(&s, 6));
+  SplineAppendBeizer(&s, gBeizer, 0.5f);
+  SplineAppendHermit(&s, gHermit, 1.5f);
+  SplineAppendCatmullRom(&s, gPoints, POINTS, 0.25f);
+  assert_int_equal(s.count, 6);
+  assert_float_equal(SplineDuration(&s), 3.0f, XMATH_EPSILON);
+  assert_float_equal(s.spacing, 0.0f, XMATH_EPSILON);
+
+  // A shared knot belongs to the later segment, so t stops short of one.
+  for (unsigned i = 0; i < 20; i++) {
+    float t = (float)i / 20.0f;
+    Vec3 e = BeizerInterpolate(gBeizer, t);
+    assert_true(Vec3EqualApprox(SplineEvaluate(&s, 0.5f * t), e));
+    e = HermitInterpolate(gHermit, t);
+    assert_true(Vec3EqualApprox(SplineEvaluate(&s, 0.5f + 1.5f * t), e));
+  }
+
+  // Catmull-Rom segments go through the points with the tangents halfway
+  // between the neighbours.
+  for (unsigned k = 0; k < 4; k++) {
+    const Vec3* p = gPoints + k;
+    HermitCurve h = {
+        .p1 = p[1],
+        .s1 = Vec3Scale(Vec3Sub(p[2], p[0]), 0.5f),
+        .p2 = p[2],
+        .s2 = Vec3Scale(Vec3Sub(p[3], p[1]), 0.5f),
+    };
+    float u = 2.0f + 0.25f * (float)k;
+    assert_true(Vec3EqualApprox(SplineEvaluate(&s, u), p[1]));
+    for (unsigned i = 0; i < 10; i++) {
+      float t = (float)i / 10.0f;
+      Vec3 r = SplineEvaluate(&s, u + 0.25f * t);
+      assert_true(Vec3EqualApprox(r, HermitInterpolate(h, t)));
+    }
+  }
+
+  // Parameters out of the knots are clamped.
+  assert_true(Vec3EqualApprox(SplineEvaluate(&s, -1.0f), gBeizer.p1));
+  assert_true(Vec3EqualApprox(SplineEvaluate(&s, 9.0f), gPoints[5]));
+
+  for (unsigned i = 0; i <= 60; i++) {
+    float u = 0.05f * (float)i;
+    assert_int_equal(SplineFindSegment(&s, u), LinearSegment(&s, u));
+  }
+  assert_int_equal(SplineFindSegment(&s, 0.5f), 1);
+  assert_int_equal(SplineFindSegment(&s, -1.0f), 0);
+  assert_int_equal(SplineFindSegment(&s, 9.0f), 5);
+
+  SplineFree(&s);
+}
+
+static void test_SplineUniform(void** state) {
+  UNUSED(state);
+
+  // Many segments of a duration that is not exact in binary, so the knots
+  // drift away from i * spacing.
+  Spline s;
+  assert_true(SplineMake(&s, 200));
+  for (unsigned i = 0; i < 200; i++) {
+    SplineAppendHermit(&s, gHermit, 0.1f);
+  }
+  assert_float_equal(s.spacing, 0.1f, XMATH_EPSILON);
+
+  for (unsigned i = 0; i <= 4000; i++) {
+    float u = 0.005f * (float)i;
+    assert_int_equal(SplineFindSegment(&s, u), LinearSegment(&s, u));
+  }
+  for (unsigned i = 0; i <= 200; i++) {
+    float u = s.knots[i];
+    assert_int_equal(SplineFindSegment(&s, u), LinearSegment(&s, u));
+  }
+
+  SplineFree(&s);
+}
+
+static void test_SplineEvaluateArray(void** state) {
+  UNUSED(state);
+
+  Spline s;
+  assert_true(SplineMake(&s, 5));
+  SplineAppendBeizer(&s, gBeizer, 0.5f);
+  SplineAppendCatmullRom(&s, gPoints, POINTS, 0.75f);
+
+  // Increasing, repeated, decreasing and clamped parameters.
+  float u[] = {0.0f, 0.1f, 0.4f,  0.5f, 0.5f, 1.2f, 3.5f,
+               2.0f, 0.3f, -1.0f, 1.9f, 5.0f, 1.25f};
+  size_t count = sizeof(u) / sizeof(u[0]);
+  Vec3 out[sizeof(u) / sizeof(u[0]) + 1];
+  out[count] = (Vec3){42.0f, 42.0f, 42.0f};
+  SplineEvaluateArray(out, &s, u, count);
+  for (size_t i = 0; i < count; i++) {
+    assert_true(Vec3EqualApprox(out[i], SplineEvaluate(&s, u[i])));
+  }
+  assert_float_equal(out[count].x, 42.0f, XMATH_EPSILON);
+
+  SplineFree(&s);
+}
+
+int main() {
+  UNUSED_TYPE(jmp_buf);
+  UNUSED_TYPE(va_list);
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_SplineMake),
+      cmocka_unit_test(test_SplineSegments),
+      cmocka_unit_test(test_SplineUniform),
+      cmocka_unit_test(test_SplineEvaluateArray),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,284 @@
+#include "threadpool.h"
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <threads.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+// Run of chunks owned by one participant, begin in the low 32 bits and end
+// in the high 32 bits so both move with one compare and swap. Each run sits
+// on its own cache line.
+typedef struct {
+  _Alignas(64) _Atomic uint64_t range;
+} ThreadPoolRun;
+
+typedef struct ThreadPoolState ThreadPoolState;
+
+typedef struct {
+  ThreadPoolState* state;
+  size_t index;
+} ThreadPoolWorker;
+
+struct ThreadPoolState {
+  // Participant 0 is the thread calling ThreadPoolFor.
+  ThreadPoolRun* runs;
+  ThreadPoolWorker* workers;
+  thrd_t* threads;
+  size_t participants;
+
+  // Current job, written under lock before generation changes.
+  ThreadPoolTask task;
+  void* user;
+  size_t count;
+  size_t grain;
+
+  mtx_t lock;
+  cnd_t wake;
+  cnd_t done;
+  size_t generation;
+  size_t running;
+  bool quit;
+};
+
+static inline uint64_t ThreadPoolPack(uint32_t begin, uint32_t end) {
+  return (uint64_t)begin | ((uint64_t)end << 32);
+}
+
+// Take the first chunk of the own run.
+static bool ThreadPoolPop(ThreadPoolRun* run, uint32_t* chunk) {
+  uint64_t r = atomic_load(&run->range);
+  for (;;) {
+    uint32_t begin = (uint32_t)r;
+    uint32_t end = (uint32_t)(r >> 32);
+    if (begin >= end) {
+      return false;
+    }
+    if (atomic_compare_exchange_weak(&run->range, &r,
+                                     ThreadPoolPack(begin + 1, end))) {
+      *chunk = begin;
+      return true;
+    }
+  }
+}
+
+// Move the back half of the run of another participant into the own run
+// (empty at this point) and take its first chunk.
+static bool ThreadPoolSteal(ThreadPoolState* s, size_t self, uint32_t* chunk) {
+  for (size_t k = 1; k < s->participants; k++) {
+    ThreadPoolRun* victim = &s->runs[(self + k) % s->participants];
+    uint64_t r = atomic_load(&victim->range);
+    for (;;) {
+      uint32_t begin = (uint32_t)r;
+      uint32_t end = (uint32_t)(r >> 32);
+      if (begin >= end) {
+        break;
+      }
+
+      uint32_t mid = begin + (end - begin) / 2;
+      if (atomic_compare_exchange_weak(&victim->range, &r,
+                                       ThreadPoolPack(begin, mid))) {
+        atomic_store(&s->runs[self].range, ThreadPoolPack(mid + 1, end));
+        *chunk = mid;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static void ThreadPoolWork(ThreadPoolState* s, size_t self) {
+  uint32_t chunk;
+  while (ThreadPoolPop(&s->runs[self], &chunk) ||
+         ThreadPoolSteal(s, self, &chunk)) {
+    size_t first = (size_t)chunk * s->grain;
+    size_t rest = s->count - first;
+    s->task(s->user, first, rest < s->grain ? rest : s->grain);
+  }
+}
+
+static int ThreadPoolMain(void* arg) {
+  ThreadPoolWorker* w = arg;
+  ThreadPoolState* s = w->state;
+  size_t seen = 0;
+  for (;;) {
+    mtx_lock(&s->lock);
+    while (s->generation == seen && !s->quit) {
+      cnd_wait(&s->wake, &s->lock);
+    }
+    if (s->quit) {
+      mtx_unlock(&s->lock);
+      return 0;
+    }
+    seen = s->generation;
+    mtx_unlock(&s->lock);
+
+    ThreadPoolWork(s, w->index);
+
+    mtx_lock(&s->lock);
+    if (--s->running == 0) {
+      cnd_signal(&s->done);
+    }
+    mtx_unlock(&s->lock);
+  }
+}
+
+XMATH_API size_t ThreadPoolHardwareThreads(void) {
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? (size_t)n : 1;
+#else
+  return 1;
+#endif
+}
+
+static void ThreadPoolRunsFree(ThreadPoolRun* runs) {
+#if defined(_MSC_VER)
+  _aligned_free(runs);
+#else
+  free(runs);
+#endif
+}
+
+XMATH_API bool ThreadPoolMake(ThreadPool* pool, size_t threadCount) {
+  assert(pool != NULL);
+  *pool = (ThreadPool){0};
+
+  ThreadPoolState* s = calloc(1, sizeof(ThreadPoolState));
+  if (s == NULL) {
+    return false;
+  }
+
+  size_t participants = threadCount + 1;
+  s->participants = participants;
+  size_t runsSize = participants * sizeof(ThreadPoolRun);
+#if defined(_MSC_VER)
+  s->runs = _aligned_malloc(runsSize, _Alignof(ThreadPoolRun));
+#else
+  s->runs = aligned_alloc(_Alignof(ThreadPoolRun), runsSize);
+#endif
+  s->workers = calloc(participants, sizeof(ThreadPoolWorker));
+  s->threads = calloc(participants, sizeof(thrd_t));
+  bool lock = s->runs != NULL && s->workers != NULL && s->threads != NULL &&
+              mtx_init(&s->lock, mtx_plain) == thrd_success;
+  bool wake = lock && cnd_init(&s->wake) == thrd_success;
+  bool done = wake && cnd_init(&s->done) == thrd_success;
+  if (!done) {
+    // Only what was initialized before the failure is destroyed.
+    if (wake) {
+      cnd_destroy(&s->wake);
+    }
+    if (lock) {
+      mtx_destroy(&s->lock);
+    }
+    ThreadPoolRunsFree(s->runs);
+    free(s->workers);
+    free(s->threads);
+    free(s);
+    return false;
+  }
+
+  for (size_t i = 0; i < participants; i++) {
+    atomic_init(&s->runs[i].range, 0);
+    s->workers[i] = (ThreadPoolWorker){s, i};
+  }
+
+  // Participant 0 has no thread, a failed start stops the ones running.
+  pool->state = s;
+  for (size_t i = 1; i < participants; i++) {
+    if (thrd_create(&s->threads[i], ThreadPoolMain, &s->workers[i]) !=
+        thrd_success) {
+      pool->threadCount = i - 1;
+      ThreadPoolFree(pool);
+      return false;
+    }
+  }
+  pool->threadCount = threadCount;
+  return true;
+}
+
+XMATH_API void ThreadPoolFree(ThreadPool* pool) {
+  assert(pool != NULL);
+  ThreadPoolState* s = pool->state;
+  if (s == NULL) {
+    return;
+  }
+
+  mtx_lock(&s->lock);
+  s->quit = true;
+  cnd_broadcast(&s->wake);
+  mtx_unlock(&s->lock);
+  for (size_t i = 1; i <= pool->threadCount; i++) {
+    thrd_join(s->threads[i], NULL);
+  }
+
+  cnd_destroy(&s->done);
+  cnd_destroy(&s->wake);
+  mtx_destroy(&s->lock);
+  ThreadPoolRunsFree(s->runs);
+  free(s->workers);
+  free(s->threads);
+  free(s);
+  *pool = (ThreadPool){0};
+}
+
+XMATH_API void ThreadPoolFor(ThreadPool* pool,
+                             size_t count,
+                             size_t grain,
+                             ThreadPoolTask task,
+                             void* user) {
+  assert(task != NULL);
+  if (count == 0) {
+    return;
+  }
+  if (grain == 0) {
+    grain = 1;
+  }
+
+  size_t chunks = (count + grain - 1) / grain;
+  if (pool == NULL || pool->threadCount == 0 || chunks == 1) {
+    for (size_t first = 0; first < count; first += grain) {
+      size_t rest = count - first;
+      task(user, first, rest < grain ? rest : grain);
+    }
+    return;
+  }
+  assert(chunks < UINT32_MAX);
+
+  ThreadPoolState* s = pool->state;
+  mtx_lock(&s->lock);
+  s->task = task;
+  s->user = user;
+  s->count = count;
+  s->grain = grain;
+
+  // Even runs of chunks, the stealing balances the rest.
+  size_t n = s->participants;
+  for (size_t i = 0; i < n; i++) {
+    uint32_t begin = (uint32_t)(chunks * i / n);
+    uint32_t end = (uint32_t)(chunks * (i + 1) / n);
+    atomic_store(&s->runs[i].range, ThreadPoolPack(begin, end));
+  }
+
+  s->running = pool->threadCount;
+  s->generation++;
+  cnd_broadcast(&s->wake);
+  mtx_unlock(&s->lock);
+
+  ThreadPoolWork(s, 0);
+
+  mtx_lock(&s->lock);
+  while (s->running > 0) {
+    cnd_wait(&s->done, &s->lock);
+  }
+  mtx_unlock(&s->lock);
+}
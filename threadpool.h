@@ -0,0 +1,79 @@
+/**
+ * @file threadpool.h
+ * @brief Small work stealing thread pool for parallel loops.
+ *
+ * ThreadPoolFor splits a range of indices in chunks of `grain` indices and
+ * hands every worker (and the calling thread) a contiguous run of chunks.
+ * Each one takes chunks from the front of its own run and, once it is empty,
+ * steals the back half of the run of another worker. The call returns when
+ * every chunk has been processed, so consecutive calls are separated by a
+ * barrier.
+ */
+#ifndef XMATH_THREADPOOL_H
+#define XMATH_THREADPOOL_H
+#include <stdbool.h>
+#include <stddef.h>
+#include "api.h"
+
+/**
+ * @brief Body of a parallel loop.
+ * @param user pointer given to ThreadPoolFor.
+ * @param first first index of the chunk.
+ * @param count number of indices of the chunk, never zero.
+ */
+typedef void (*ThreadPoolTask)(void* user, size_t first, size_t count);
+
+/**
+ * @brief Pool of worker threads.
+ *
+ * threadCount workers are started by ThreadPoolMake, the thread calling
+ * ThreadPoolFor works too. A pool runs one ThreadPoolFor at a time.
+ */
+typedef struct {
+  struct ThreadPoolState* state;
+  size_t threadCount;
+} ThreadPool;
+
+/**
+ * @brief Number of hardware threads available to the process.
+ * @return at least one.
+ */
+XMATH_API size_t ThreadPoolHardwareThreads(void);
+
+/**
+ * @brief Start a pool.
+ * @param pool pool to initialize.
+ * @param threadCount number of workers besides the calling thread, e.g.
+ * `ThreadPoolHardwareThreads() - 1`. Zero runs the loops serially.
+ * @return false if the memory or the threads could not be created.
+ */
+XMATH_API bool ThreadPoolMake(ThreadPool* pool, size_t threadCount);
+
+/**
+ * @brief Stop the workers and release the pool.
+ * @param pool pool made by ThreadPoolMake, left empty.
+ */
+XMATH_API void ThreadPoolFree(ThreadPool* pool);
+
+/**
+ * @brief Run task over [0, count) in parallel and wait for it.
+ *
+ * Chunks are `grain` indices long but the last one. Chunks run in any
+ * order and on any thread, task must be safe to call concurrently.
+ * @param pool pool to run on, NULL runs the loop on the calling thread.
+ * @param count number of indices.
+ * @param grain indices per chunk, zero is taken as one.
+ * @param task body of the loop.
+ * @param user pointer forwarded to task.
+ */
+XMATH_API void ThreadPoolFor(ThreadPool* pool,
+                             size_t count,
+                             size_t grain,
+                             ThreadPoolTask task,
+                             void* user);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "threadpool.c"
+#endif
+
+#endif /* XMATH_THREADPOOL_H */
@@ -0,0 +1,110 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <cmocka.h>
+// clang-format on
+
+#include <stdatomic.h>
+#include "threadpool.h"
+#include "common_testing.h"
+
+#define COUNT 10007
+
+static _Atomic int gVisits[COUNT];
+static _Atomic size_t gChunks;
+// Set by a chunk with a bad range. Visit runs on the workers, where a failed
+// cmocka assertion cannot jump back to the test, so it is checked afterwards.
+static _Atomic bool gBadChunk;
+
+static void Reset(void) {
+  for (size_t i = 0; i < COUNT; i++) {
+    atomic_store(&gVisits[i], 0);
+  }
+  atomic_store(&gChunks, 0);
+  atomic_store(&gBadChunk, false);
+}
+
+static void Visit(void* user, size_t first, size_t count) {
+  size_t grain = *(const size_t*)user;
+  if (count == 0 || count > grain || first % grain != 0 ||
+      first + count > COUNT) {
+    atomic_store(&gBadChunk, true);
+    return;
+  }
+  for (size_t i = first; i < first + count; i++) {
+    atomic_fetch_add(&gVisits[i], 1);
+  }
+  atomic_fetch_add(&gChunks, 1);
+}
+
+// Every index must be visited exactly once.
+static void AssertVisited(size_t count, size_t grain) {
+  assert_false(atomic_load(&gBadChunk));
+  for (size_t i = 0; i < COUNT; i++) {
+    assert_int_equal(atomic_load(&gVisits[i]), i < count ? 1 : 0);
+  }
+  assert_int_equal(atomic_load(&gChunks), (count + grain - 1) / grain);
+}
+
+static void test_ThreadPoolHardwareThreads(void** state) {
+  UNUSED(state);
+  assert_true(ThreadPoolHardwareThreads() >= 1);
+}
+
+static void test_ThreadPoolFor(void** state) {
+  UNUSED(state);
+
+  // More workers than cores on purpose, so the stealing is exercised.
+  ThreadPool pool;
+  assert_true(ThreadPoolMake(&pool, 3));
+  assert_int_equal(pool.threadCount, 3);
+
+  size_t grains[] = {1, 7, 64, 5000, COUNT};
+  for (unsigned k = 0; k < sizeof(grains) / sizeof(grains[0]); k++) {
+    Reset();
+    ThreadPoolFor(&pool, COUNT, grains[k], Visit, &grains[k]);
+    AssertVisited(COUNT, grains[k]);
+  }
+
+  // Reused many times, with partial and empty ranges.
+  size_t grain = 16;
+  for (size_t count = 0; count < 200; count += 13) {
+    Reset();
+    ThreadPoolFor(&pool, count, grain, Visit, &grain);
+    AssertVisited(count, grain);
+  }
+
+  ThreadPoolFree(&pool);
+  assert_true(pool.state == NULL);
+}
+
+static void test_ThreadPoolSerial(void** state) {
+  UNUSED(state);
+
+  size_t grain = 100;
+  Reset();
+  ThreadPoolFor(NULL, COUNT, grain, Visit, &grain);
+  AssertVisited(COUNT, grain);
+
+  ThreadPool pool;
+  assert_true(ThreadPoolMake(&pool, 0));
+  Reset();
+  ThreadPoolFor(&pool, COUNT, grain, Visit, &grain);
+  AssertVisited(COUNT, grain);
+  ThreadPoolFree(&pool);
+}
+
+int main() {
+  UNUSED_TYPE(jmp_buf);
+  UNUSED_TYPE(va_list);
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_ThreadPoolHardwareThreads),
+      cmocka_unit_test(test_ThreadPoolFor),
+      cmocka_unit_test(test_ThreadPoolSerial),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
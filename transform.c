@@ -1,37 +1,53 @@
 #include "transform.h"
+#include <assert.h>
 #include <math.h>
+#include "dispatch_table.h"
 #include "scalar.h"
 
-bool TransformEqualApprox(Transform a, Transform b) {
+XMATH_API bool TransformEqualApprox(Transform a, Transform b) {
   return Vec3EqualApprox(a.position, b.position) &&
          QuatEqualApprox(a.rotation, b.rotation) &&
          Vec3EqualApprox(a.scale, b.scale);
 }
 
-Transform TransformCombine(Transform a, Transform b) {
-  Transform r = {0};
-
-  r.scale = Vec3Cross(a.scale, b.scale);
-  r.rotation = QuatCross(a.rotation, b.rotation);
-  r.position = QuatTransformVec3(a.rotation, Vec3Cross(a.scale, b.position));
-  r.position = Vec3Add(a.position, r.position);
+XMATH_API Transform TransformCombine(Transform a, Transform b) {
+  Transform r;
+  TransformCombineTo(&r, &a, &b);
   return r;
 }
 
-Transform TransformInverse(Transform t) {
-  Transform r = {0};
-
-  r.rotation = QuatInvert(t.rotation);
-  r.scale.x = fabsf(t.scale.x) < XMATH_EPSILON ? 0.0f : 1.0f / t.scale.x;
-  r.scale.y = fabsf(t.scale.y) < XMATH_EPSILON ? 0.0f : 1.0f / t.scale.y;
-  r.scale.z = fabsf(t.scale.z) < XMATH_EPSILON ? 0.0f : 1.0f / t.scale.z;
+XMATH_API void TransformCombineTo(Transform* XMATH_RESTRICT out,
+                                  const Transform* a,
+                                  const Transform* b) {
+  Vec3 p = QuatTransformVec3(a->rotation, Vec3Cross(a->scale, b->position));
+  out->scale = Vec3Cross(a->scale, b->scale);
+  out->rotation = QuatCross(a->rotation, b->rotation);
+  out->position = Vec3Add(a->position, p);
+}
 
-  Vec3 it = Vec3Scale(t.position, -1.0f);
-  r.position = QuatTransformVec3(r.rotation, Vec3InnerMul(r.scale, it));
+XMATH_API Transform TransformInverse(Transform t) {
+  Transform r;
+  TransformInverseTo(&r, &t);
   return r;
 }
 
-Transform TransformLerp(Transform a, Transform b, float t) {
+XMATH_API void TransformInverseTo(Transform* XMATH_RESTRICT out,
+                                  const Transform* t) {
+  Vec3 s = t->scale;
+  Quat q = QuatInvert(t->rotation);
+  Vec3 is = {
+      fabsf(s.x) < XMATH_EPSILON ? 0.0f : 1.0f / s.x,
+      fabsf(s.y) < XMATH_EPSILON ? 0.0f : 1.0f / s.y,
+      fabsf(s.z) < XMATH_EPSILON ? 0.0f : 1.0f / s.z,
+  };
+
+  Vec3 it = Vec3Scale(t->position, -1.0f);
+  out->position = QuatTransformVec3(q, Vec3InnerMul(is, it));
+  out->rotation = q;
+  out->scale = is;
+}
+
+XMATH_API Transform TransformLerp(Transform a, Transform b, float t) {
   Quat rot = b.rotation;
   if (QuatDot(a.rotation, rot) < 0.0f) {
     rot = QuatNeg(rot);
@@ -44,23 +60,29 @@ Transform TransformLerp(Transform a, Transform b, float t) {
   };
 }
 
-Mat4 TransformToMat4(Transform t) {
+XMATH_API Mat4 TransformToMat4(Transform t) {
+  Mat4 r;
+  TransformToMat4To(&r, &t);
+  return r;
+}
+
+XMATH_API void TransformToMat4To(Mat4* XMATH_RESTRICT out, const Transform* t) {
   // Extract the rotation basis of the transform
-  Vec3 x = QuatTransformVec3(t.rotation, Vec3Right);
-  Vec3 y = QuatTransformVec3(t.rotation, Vec3Up);
-  Vec3 z = QuatTransformVec3(t.rotation, Vec3Back);
+  Vec3 x = QuatTransformVec3(t->rotation, Vec3Right);
+  Vec3 y = QuatTransformVec3(t->rotation, Vec3Up);
+  Vec3 z = QuatTransformVec3(t->rotation, Vec3Back);
 
   // Scale the basis vectors
-  x = Vec3Scale(x, t.scale.x);
-  y = Vec3Scale(y, t.scale.y);
-  z = Vec3Scale(z, t.scale.z);
+  x = Vec3Scale(x, t->scale.x);
+  y = Vec3Scale(y, t->scale.y);
+  z = Vec3Scale(z, t->scale.z);
 
   // Extract the position of the transform
-  Vec3 p = t.position;
+  Vec3 p = t->position;
 
   // TODO(cedmundo): Verify if this is the correct order of the matrix.
   // clang-format off
-  return (Mat4){
+  *out = (Mat4){
     x.x, x.y, x.z, 0.0f,
     y.x, y.y, y.z, 0.0f,
     z.x, z.y, z.z, 0.0f,
@@ -69,7 +91,7 @@ Mat4 TransformToMat4(Transform t) {
   // clang-format on
 }
 
-Transform Mat4ToTransform(Mat4 m) {
+XMATH_API Transform Mat4ToTransform(Mat4 m) {
   Transform r = {0};
   Vec3 forward = {-m.zx, -m.zy, -m.zz};
   Vec3 upwards = {m.yx, m.yy, m.yz};
@@ -83,13 +105,83 @@ Transform Mat4ToTransform(Mat4 m) {
   return r;
 }
 
-Vec3 TransformPoint(Transform a, Vec3 b) {
+XMATH_API Vec3 TransformPoint(Transform a, Vec3 b) {
   Vec3 r = QuatTransformVec3(a.rotation, Vec3InnerMul(a.scale, b));
   r = Vec3Add(a.position, r);
   return r;
 }
 
-Vec3 TransformVec3(Transform a, Vec3 b) {
+XMATH_API Vec3 TransformVec3(Transform a, Vec3 b) {
   Vec3 r = QuatTransformVec3(a.rotation, Vec3InnerMul(a.scale, b));
   return r;
 }
+
+XMATH_API void TransformPointStrided(Vec3* out,
+                                     size_t outStride,
+                                     const Transform* a,
+                                     const Vec3* in,
+                                     size_t inStride,
+                                     size_t count) {
+  assert(a != NULL);
+  assert(count == 0 || (in != NULL && out != NULL));
+  float rows[12];
+  BatchAffineRows(rows, &a->rotation.x, a->scale, a->position);
+  DispatchAffineVec3(rows, out, outStride, in, inStride, count);
+}
+
+XMATH_API void TransformVec3Strided(Vec3* out,
+                                    size_t outStride,
+                                    const Transform* a,
+                                    const Vec3* in,
+                                    size_t inStride,
+                                    size_t count) {
+  assert(a != NULL);
+  assert(count == 0 || (in != NULL && out != NULL));
+  float rows[12];
+  BatchAffineRows(rows, &a->rotation.x, a->scale, Vec3Zero);
+  DispatchAffineVec3(rows, out, outStride, in, inStride, count);
+}
+
+XMATH_API void TransformPointArray(Vec3* out,
+                                   const Transform* a,
+                                   const Vec3* in,
+                                   size_t count) {
+  TransformPointStrided(out, sizeof(Vec3), a, in, sizeof(Vec3), count);
+}
+
+XMATH_API void TransformVec3Array(Vec3* out,
+                                  const Transform* a,
+                                  const Vec3* in,
+                                  size_t count) {
+  TransformVec3Strided(out, sizeof(Vec3), a, in, sizeof(Vec3), count);
+}
+
+XMATH_API void TransformPointArrayToSoA(Vec3SoA* r,
+                                        const Transform* a,
+                                        const Vec3* in,
+                                        size_t count) {
+  assert(r != NULL && a != NULL);
+  assert(count <= r->capacity);
+  assert(count == 0 || in != NULL);
+
+  // The capacity is a multiple of XMATH_SOA_WIDTH, so the whole blocks
+  // written by the kernel stay inside the streams.
+  float rows[12];
+  BatchAffineRows(rows, &a->rotation.x, a->scale, a->position);
+  DispatchAffineVec3SoA(rows, r->x, r->y, r->z, in, sizeof(Vec3), count);
+  r->count = count;
+}
+
+XMATH_API void TransformVec3ArrayToSoA(Vec3SoA* r,
+                                       const Transform* a,
+                                       const Vec3* in,
+                                       size_t count) {
+  assert(r != NULL && a != NULL);
+  assert(count <= r->capacity);
+  assert(count == 0 || in != NULL);
+
+  float rows[12];
+  BatchAffineRows(rows, &a->rotation.x, a->scale, Vec3Zero);
+  DispatchAffineVec3SoA(rows, r->x, r->y, r->z, in, sizeof(Vec3), count);
+  r->count = count;
+}
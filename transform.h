@@ -1,13 +1,20 @@
 /**
  * @file transform.h
  * @brief Definitions, functions and utilities for transforms.
+ *
+ * As in mat4.h, the `...To` variants take pointers instead of 40 byte
+ * Transform values and write into an `XMATH_RESTRICT` output that must not
+ * be (or overlap) any input.
  */
 #ifndef XMATH_TRANSFORM_H
 #define XMATH_TRANSFORM_H
 #include <stdbool.h>
+#include <stddef.h>
+#include "api.h"
 #include "mat4.h"
 #include "quat.h"
 #include "vec3.h"
+#include "vec3soa.h"
 
 typedef struct {
   Vec3 position;
@@ -21,7 +28,7 @@ typedef struct {
  * @param b second transform.
  * @return true if they are approximately equal.
  */
-bool TransformEqualApprox(Transform a, Transform b);
+XMATH_API bool TransformEqualApprox(Transform a, Transform b);
 
 /**
  * @brief Combine two transform in right-to-left order.
@@ -29,13 +36,31 @@ bool TransformEqualApprox(Transform a, Transform b);
  * @param b combined space transform.
  * @return a transform with a relative to b.
  */
-Transform TransformCombine(Transform a, Transform b);
+XMATH_API Transform TransformCombine(Transform a, Transform b);
+
+/**
+ * @brief Combine two transform in right-to-left order into out.
+ * @param out a relative to b, must not be a or b.
+ * @param a combining transform.
+ * @param b combined space transform.
+ */
+XMATH_API void TransformCombineTo(Transform* XMATH_RESTRICT out,
+                                  const Transform* a,
+                                  const Transform* b);
 
 /**
  * @brief Get the inverse of a transform.
  * @param t transform to get inverse (unaffected).
  */
-Transform TransformInverse(Transform t);
+XMATH_API Transform TransformInverse(Transform t);
+
+/**
+ * @brief Get the inverse of a transform into out.
+ * @param out inverse of t, must not be t.
+ * @param t transform to get inverse (unaffected).
+ */
+XMATH_API void TransformInverseTo(Transform* XMATH_RESTRICT out,
+                                  const Transform* t);
 
 /**
  * @brief Linear interpolation between two transforms.
@@ -44,21 +69,28 @@ Transform TransformInverse(Transform t);
  * @param t factor of interpolation.
  * @return a transform on the way from a to b by t.
  */
-Transform TransformLerp(Transform a, Transform b, float t);
+XMATH_API Transform TransformLerp(Transform a, Transform b, float t);
 
 /**
  * @brief Convert from a Transform into a Mat4.
  * @param t transform to convert (unaffected).
  * @return a matrix representing the affine transformations of t.
  */
-Mat4 TransformToMat4(Transform t);
+XMATH_API Mat4 TransformToMat4(Transform t);
+
+/**
+ * @brief Convert from a Transform into a Mat4 written into out.
+ * @param out matrix representing the affine transformations of t.
+ * @param t transform to convert (unaffected).
+ */
+XMATH_API void TransformToMat4To(Mat4* XMATH_RESTRICT out, const Transform* t);
 
 /**
  * @brief Convert a transform matrix back into a Transform.
  * @param m matrix to convert (unaffected).
  * @return a Transform with each component equivalent to m transformations.
  */
-Transform Mat4ToTransform(Mat4 m);
+XMATH_API Transform Mat4ToTransform(Mat4 m);
 
 /**
  * @brief Transform a point.
@@ -66,7 +98,7 @@ Transform Mat4ToTransform(Mat4 m);
  * @param b Vec3 representing a point.
  * @return b point in Transform space.
  */
-Vec3 TransformPoint(Transform a, Vec3 b);
+XMATH_API Vec3 TransformPoint(Transform a, Vec3 b);
 
 /**
  * @brief Transform a vector (do not apply translation of a into b).
@@ -74,6 +106,104 @@ Vec3 TransformPoint(Transform a, Vec3 b);
  * @param b Vec3 representing.
  * @return b vec3 in Transform space.
  */
-Vec3 TransformVec3(Transform a, Vec3 b);
+XMATH_API Vec3 TransformVec3(Transform a, Vec3 b);
+
+/**
+ * @brief Transform a strided array of points.
+ *
+ * Element i is read from `(char*)in + i * inStride` and written into
+ * `(char*)out + i * outStride`, so positions inside interleaved vertex
+ * structs can be transformed where they are. out can be the same as in when
+ * both use the same stride.
+ * @param out address of the first destination point.
+ * @param outStride distance in bytes between destination points.
+ * @param a transform to use as basis.
+ * @param in address of the first source point.
+ * @param inStride distance in bytes between source points.
+ * @param count number of points.
+ */
+XMATH_API void TransformPointStrided(Vec3* out,
+                                     size_t outStride,
+                                     const Transform* a,
+                                     const Vec3* in,
+                                     size_t inStride,
+                                     size_t count);
+
+/**
+ * @brief Transform a strided array of vectors (without translation).
+ *
+ * Same layout rules as TransformPointStrided.
+ * @param out address of the first destination vector.
+ * @param outStride distance in bytes between destination vectors.
+ * @param a transform to use as basis.
+ * @param in address of the first source vector.
+ * @param inStride distance in bytes between source vectors.
+ * @param count number of vectors.
+ */
+XMATH_API void TransformVec3Strided(Vec3* out,
+                                    size_t outStride,
+                                    const Transform* a,
+                                    const Vec3* in,
+                                    size_t inStride,
+                                    size_t count);
+
+/**
+ * @brief Transform an array of points.
+ *
+ * The rotation and scale of a are expanded into a 3x4 matrix once, then the
+ * points are streamed through it.
+ * @param out destination of count points, can be the same as in.
+ * @param a transform to use as basis.
+ * @param in source of count points.
+ * @param count number of points.
+ */
+XMATH_API void TransformPointArray(Vec3* out,
+                                   const Transform* a,
+                                   const Vec3* in,
+                                   size_t count);
+
+/**
+ * @brief Transform an array of vectors (without translation).
+ * @param out destination of count vectors, can be the same as in.
+ * @param a transform to use as basis.
+ * @param in source of count vectors.
+ * @param count number of vectors.
+ */
+XMATH_API void TransformVec3Array(Vec3* out,
+                                  const Transform* a,
+                                  const Vec3* in,
+                                  size_t count);
+
+/**
+ * @brief Transform an array of points into a Vec3SoA stream.
+ *
+ * Same as TransformPointArray followed by Vec3SoAFromArray without the
+ * intermediate array.
+ * @param r destination stream, its capacity must fit count vectors.
+ * @param a transform to use as basis.
+ * @param in source of count points.
+ * @param count number of points, becomes the count of r.
+ */
+XMATH_API void TransformPointArrayToSoA(Vec3SoA* r,
+                                        const Transform* a,
+                                        const Vec3* in,
+                                        size_t count);
+
+/**
+ * @brief Transform an array of vectors (without translation) into a Vec3SoA
+ * stream.
+ * @param r destination stream, its capacity must fit count vectors.
+ * @param a transform to use as basis.
+ * @param in source of count vectors.
+ * @param count number of vectors, becomes the count of r.
+ */
+XMATH_API void TransformVec3ArrayToSoA(Vec3SoA* r,
+                                       const Transform* a,
+                                       const Vec3* in,
+                                       size_t count);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "transform.c"
+#endif
 
 #endif /* XMATH_TRANSFORM_H */
@@ -33,6 +33,10 @@ void test_TransformCombine(void** state) {
 
   Transform r = TransformCombine(a, b);
   assert_true(TransformEqualApprox(r, e));
+
+  r = (Transform){0};
+  TransformCombineTo(&r, &a, &b);
+  assert_true(TransformEqualApprox(r, e));
 }
 
 void test_TransformInverse(void** state) {
@@ -52,6 +56,10 @@ void test_TransformInverse(void** state) {
 
   Transform r = TransformInverse(a);
   assert_true(TransformEqualApprox(r, e));
+
+  r = (Transform){0};
+  TransformInverseTo(&r, &a);
+  assert_true(TransformEqualApprox(r, e));
 }
 
 void test_TransformLerp(void** state) {
@@ -100,6 +108,10 @@ void test_TransformToMat4(void** state) {
 
   Mat4 r = TransformToMat4(t);
   assert_true(Mat4EqualApprox(r, e));
+
+  r = Mat4Zero;
+  TransformToMat4To(&r, &t);
+  assert_true(Mat4EqualApprox(r, e));
 }
 
 void test_Mat4ToTransform(void** state) {
@@ -150,6 +162,111 @@ void test_TransformVec3(void** state) {
   assert_true(Vec3EqualApprox(r, e));
 }
 
+typedef struct {
+  Vec3 position;
+  Vec3 normal;
+  float uv[2];
+} Vertex;
+
+void test_TransformPointStrided(void** state) {
+  UNUSED(state);
+
+  Transform a = {
+      .position = {1.0f, -2.0f, 0.5f},
+      .rotation = QuatMakeAngleAxis(FDeg2Rad(30.0f), Vec3Norm(Vec3One)),
+      .scale = {2.0f, 1.0f, 0.5f},
+  };
+
+  Vertex vertices[6];
+  Vertex source[6];
+  for (unsigned i = 0; i < 6; i++) {
+    float f = 0.125f * (float)i;
+    source[i] = (Vertex){{f, 1.0f - f, 0.5f * f}, {0.0f, f, 1.0f}, {f, f}};
+    vertices[i] = source[i];
+  }
+
+  TransformPointStrided(&vertices[0].position, sizeof(Vertex), &a,
+                        &vertices[0].position, sizeof(Vertex), 6);
+  for (unsigned i = 0; i < 6; i++) {
+    Vec3 e = TransformPoint(a, source[i].position);
+    assert_true(Vec3EqualApprox(vertices[i].position, e));
+    assert_true(Vec3EqualApprox(vertices[i].normal, source[i].normal));
+  }
+}
+
+void test_TransformVec3Strided(void** state) {
+  UNUSED(state);
+
+  Transform a = {
+      .position = {1.0f, -2.0f, 0.5f},
+      .rotation = QuatMakeAngleAxis(FDeg2Rad(30.0f), Vec3Norm(Vec3One)),
+      .scale = {2.0f, 1.0f, 0.5f},
+  };
+
+  Vertex vertices[5];
+  Vec3 out[5];
+  for (unsigned i = 0; i < 5; i++) {
+    float f = 0.125f * (float)i;
+    vertices[i] = (Vertex){{f, 1.0f - f, 0.5f * f}, {0.0f, f, 1.0f}, {f, f}};
+  }
+
+  TransformVec3Strided(out, sizeof(Vec3), &a, &vertices[0].normal,
+                       sizeof(Vertex), 5);
+  for (unsigned i = 0; i < 5; i++) {
+    Vec3 e = TransformVec3(a, vertices[i].normal);
+    assert_true(Vec3EqualApprox(out[i], e));
+  }
+}
+
+void test_TransformPointArray(void** state) {
+  UNUSED(state);
+
+  Transform a = {
+      .position = {0.5f, -1.0f, 0.25f},
+      .rotation = QuatMakeAngleAxis(FDeg2Rad(-40.0f), Vec3Norm(Vec3One)),
+      .scale = {1.5f, 0.5f, 1.0f},
+  };
+
+  // Not a multiple of four, so the padded tail is exercised.
+  Vec3 in[9];
+  Vec3 points[9];
+  Vec3 dirs[9];
+  for (unsigned i = 0; i < 9; i++) {
+    float f = 0.125f * (float)i;
+    in[i] = (Vec3){f, 1.0f - f, -0.5f * f};
+  }
+
+  TransformPointArray(points, &a, in, 9);
+  TransformVec3Array(dirs, &a, in, 9);
+  for (unsigned i = 0; i < 9; i++) {
+    assert_true(Vec3EqualApprox(points[i], TransformPoint(a, in[i])));
+    assert_true(Vec3EqualApprox(dirs[i], TransformVec3(a, in[i])));
+  }
+
+  Vec3SoA soa;
+  Vec3 out[9];
+  assert_true(Vec3SoAMake(&soa, 9));
+  TransformPointArrayToSoA(&soa, &a, in, 9);
+  assert_int_equal(soa.count, 9);
+  Vec3SoAToArray(out, &soa);
+  for (unsigned i = 0; i < 9; i++) {
+    assert_true(Vec3EqualApprox(out[i], points[i]));
+  }
+
+  TransformVec3ArrayToSoA(&soa, &a, in, 9);
+  Vec3SoAToArray(out, &soa);
+  for (unsigned i = 0; i < 9; i++) {
+    assert_true(Vec3EqualApprox(out[i], dirs[i]));
+  }
+  Vec3SoAFree(&soa);
+
+  // In place.
+  TransformPointArray(in, &a, in, 9);
+  for (unsigned i = 0; i < 9; i++) {
+    assert_true(Vec3EqualApprox(in[i], points[i]));
+  }
+}
+
 int main() {
   UNUSED_TYPE(jmp_buf);
   UNUSED_TYPE(va_list);
@@ -162,6 +279,9 @@ int main() {
       cmocka_unit_test(test_Mat4ToTransform),
       cmocka_unit_test(test_TransformPoint),
       cmocka_unit_test(test_TransformVec3),
+      cmocka_unit_test(test_TransformPointStrided),
+      cmocka_unit_test(test_TransformVec3Strided),
+      cmocka_unit_test(test_TransformPointArray),
   };
 
   return cmocka_run_group_tests(tests, NULL, NULL);
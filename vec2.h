@@ -5,6 +5,7 @@
 #ifndef XMATH_VEC2_H
 #define XMATH_VEC2_H
 #include <stdbool.h>
+#include "api.h"
 
 /**
  * @brief Vector of two dimensions.
@@ -33,7 +34,7 @@ static const Vec2 Vec2One = {1.0f, 1.0f};
  * @param vec reference of the vector.
  * @return The address of first component.
  */
-float* Vec2Floats(Vec2* vec);
+XMATH_API float* Vec2Floats(Vec2* vec);
 
 /**
  * @brief Compare the components of two vectors and return if they are approx
@@ -42,7 +43,7 @@ float* Vec2Floats(Vec2* vec);
  * @param b second vector.
  * @return true if a components are near b components.
  */
-bool Vec2EqualApprox(Vec2 a, Vec2 b);
+XMATH_API bool Vec2EqualApprox(Vec2 a, Vec2 b);
 
 /**
  * @brief Standard vector addition (component by component).
@@ -50,7 +51,7 @@ bool Vec2EqualApprox(Vec2 a, Vec2 b);
  * @param b right vector.
  * @return always a Vec2 with the sum of each component.
  */
-Vec2 Vec2Add(Vec2 a, Vec2 b);
+XMATH_API Vec2 Vec2Add(Vec2 a, Vec2 b);
 
 /**
  * @brief Standard vector subtraction (component by component).
@@ -58,7 +59,7 @@ Vec2 Vec2Add(Vec2 a, Vec2 b);
  * @param b right vector.
  * @return always a Vec2 with the difference of each component.
  */
-Vec2 Vec2Sub(Vec2 a, Vec2 b);
+XMATH_API Vec2 Vec2Sub(Vec2 a, Vec2 b);
 
 /**
  * @brief Standard vector scale (component by scalar product).
@@ -66,7 +67,7 @@ Vec2 Vec2Sub(Vec2 a, Vec2 b);
  * @param f factor to multiply each component.
  * @return always a scaled Vec2.
  */
-Vec2 Vec2Scale(Vec2 v, float f);
+XMATH_API Vec2 Vec2Scale(Vec2 v, float f);
 
 /**
  * @brief Squared length of a vector.
@@ -76,21 +77,21 @@ Vec2 Vec2Scale(Vec2 v, float f);
  * @param v vector.
  * @return squared vector's length.
  */
-float Vec2SqrLen(Vec2 v);
+XMATH_API float Vec2SqrLen(Vec2 v);
 
 /**
  * @brief Standard length of a vector.
  * @param v vector.
  * @return vector's length.
  */
-float Vec2Len(Vec2 v);
+XMATH_API float Vec2Len(Vec2 v);
 
 /**
  * @brief Normalize a vector (divide each component by its inverse length).
  * @param v vector (unaffected).
  * @return normalized vector.
  */
-Vec2 Vec2Norm(Vec2 v);
+XMATH_API Vec2 Vec2Norm(Vec2 v);
 
 /**
  * @brief Return the greater value of each component of two vectors.
@@ -101,7 +102,7 @@ Vec2 Vec2Norm(Vec2 v);
  * @param b second vector.
  * @return a new vector containing the max values of each vector.
  */
-Vec2 Vec2Max(Vec2 a, Vec2 b);
+XMATH_API Vec2 Vec2Max(Vec2 a, Vec2 b);
 
 /**
  * @brief Return the lesser value of each component of two vectors.
@@ -112,6 +113,10 @@ Vec2 Vec2Max(Vec2 a, Vec2 b);
  * @param b second vector.
  * @return a new vector containing the min values of each vector.
  */
-Vec2 Vec2Min(Vec2 a, Vec2 b);
+XMATH_API Vec2 Vec2Min(Vec2 a, Vec2 b);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "vec2.c"
+#endif
 
 #endif  // XMATH_VEC2_H
@@ -3,40 +3,40 @@
 
 #include <math.h>
 
-float* Vec3Floats(Vec3* vec) {
+XMATH_API float* Vec3Floats(Vec3* vec) {
   return &vec->x;
 }
 
-bool Vec3EqualApprox(Vec3 a, Vec3 b) {
+XMATH_API bool Vec3EqualApprox(Vec3 a, Vec3 b) {
   Vec3 diff = Vec3Sub(a, b);
   return Vec3Len(diff) <= XMATH_EPSILON;
 }
 
-Vec3 Vec3Add(Vec3 a, Vec3 b) {
+XMATH_API Vec3 Vec3Add(Vec3 a, Vec3 b) {
   return (Vec3){a.x + b.x, a.y + b.y, a.z + b.z};
 }
 
-Vec3 Vec3Sub(Vec3 a, Vec3 b) {
+XMATH_API Vec3 Vec3Sub(Vec3 a, Vec3 b) {
   return (Vec3){a.x - b.x, a.y - b.y, a.z - b.z};
 }
 
-Vec3 Vec3InnerMul(Vec3 a, Vec3 b) {
+XMATH_API Vec3 Vec3InnerMul(Vec3 a, Vec3 b) {
   return (Vec3) {a.x * b.x, a.y * b.y, a.z * b.z};
 }
 
-Vec3 Vec3Scale(Vec3 v, float s) {
+XMATH_API Vec3 Vec3Scale(Vec3 v, float s) {
   return (Vec3){v.x * s, v.y * s, v.z * s};
 }
 
-float Vec3SqrLen(Vec3 v) {
+XMATH_API float Vec3SqrLen(Vec3 v) {
   return v.x * v.x + v.y * v.y + v.z * v.z;
 }
 
-float Vec3Len(Vec3 v) {
+XMATH_API float Vec3Len(Vec3 v) {
   return sqrtf(v.x * v.x + v.y * v.y + v.z * v.z);
 }
 
-Vec3 Vec3Norm(Vec3 v) {
+XMATH_API Vec3 Vec3Norm(Vec3 v) {
   float vl = Vec3Len(v);
   if (vl < XMATH_EPSILON) {
     return v;
@@ -46,11 +46,11 @@ Vec3 Vec3Norm(Vec3 v) {
   return Vec3Scale(v, k);
 }
 
-Vec3 Vec3Orthonormalize(Vec3 a, Vec3 b) {
+XMATH_API Vec3 Vec3Orthonormalize(Vec3 a, Vec3 b) {
   return Vec3Norm(Vec3Sub(a, Vec3Scale(b, Vec3Dot(b, a))));
 }
 
-Vec3 Vec3Max(Vec3 a, Vec3 b) {
+XMATH_API Vec3 Vec3Max(Vec3 a, Vec3 b) {
   Vec3 r = {0};
   r.x = FMax(a.x, b.x);
   r.y = FMax(a.y, b.y);
@@ -58,7 +58,7 @@ Vec3 Vec3Max(Vec3 a, Vec3 b) {
   return r;
 }
 
-Vec3 Vec3Min(Vec3 a, Vec3 b) {
+XMATH_API Vec3 Vec3Min(Vec3 a, Vec3 b) {
   Vec3 r = {0};
   r.x = FMin(a.x, b.x);
   r.y = FMin(a.y, b.y);
@@ -66,7 +66,7 @@ Vec3 Vec3Min(Vec3 a, Vec3 b) {
   return r;
 }
 
-float Vec3Angle(Vec3 a, Vec3 b) {
+XMATH_API float Vec3Angle(Vec3 a, Vec3 b) {
   float aSqrLen = Vec3SqrLen(a);
   float bSqrLen = Vec3SqrLen(b);
   if (aSqrLen < XMATH_EPSILON || bSqrLen < XMATH_EPSILON) {
@@ -77,11 +77,11 @@ float Vec3Angle(Vec3 a, Vec3 b) {
   return acosf(dot / (sqrtf(aSqrLen) * sqrtf(bSqrLen)));
 }
 
-float Vec3Dot(Vec3 a, Vec3 b) {
+XMATH_API float Vec3Dot(Vec3 a, Vec3 b) {
   return a.x * b.x + a.y * b.y + a.z * b.z;
 }
 
-Vec3 Vec3Cross(Vec3 l, Vec3 r) {
+XMATH_API Vec3 Vec3Cross(Vec3 l, Vec3 r) {
   return (Vec3){
       l.y * r.z - l.z * r.y,
       l.z * r.x - l.x * r.z,
@@ -89,7 +89,7 @@ Vec3 Vec3Cross(Vec3 l, Vec3 r) {
   };
 }
 
-Vec3 Vec3Project(Vec3 a, Vec3 b) {
+XMATH_API Vec3 Vec3Project(Vec3 a, Vec3 b) {
   float bSqrLen = Vec3SqrLen(b);
   if (bSqrLen < XMATH_EPSILON) {
     return Vec3Zero;
@@ -99,18 +99,18 @@ Vec3 Vec3Project(Vec3 a, Vec3 b) {
   return Vec3Scale(b, scale);
 }
 
-Vec3 Vec3Reject(Vec3 a, Vec3 b) {
+XMATH_API Vec3 Vec3Reject(Vec3 a, Vec3 b) {
   Vec3 p = Vec3Project(a, b);
   return Vec3Sub(a, p);
 }
 
-Vec3 Vec3Reflect(Vec3 a, Vec3 b) {
+XMATH_API Vec3 Vec3Reflect(Vec3 a, Vec3 b) {
   Vec3 n = Vec3Norm(b);
   Vec3 r = Vec3Sub(a, Vec3Scale(n, 2 * Vec3Dot(a, n)));
   return r;
 }
 
-Vec3 Vec3Lerp(Vec3 a, Vec3 b, float f) {
+XMATH_API Vec3 Vec3Lerp(Vec3 a, Vec3 b, float f) {
   return (Vec3){
       a.x + (b.x - a.x) * f,
       a.y + (b.y - a.y) * f,
@@ -118,7 +118,7 @@ Vec3 Vec3Lerp(Vec3 a, Vec3 b, float f) {
   };
 }
 
-Vec3 Vec3Slerp(Vec3 a, Vec3 b, float f) {
+XMATH_API Vec3 Vec3Slerp(Vec3 a, Vec3 b, float f) {
   if (f < 0.01f) {
     return Vec3Lerp(a, b, f);
   }
@@ -134,7 +134,7 @@ Vec3 Vec3Slerp(Vec3 a, Vec3 b, float f) {
   return Vec3Add(Vec3Scale(from, fa), Vec3Scale(to, fb));
 }
 
-Vec3 Vec3Nlerp(Vec3 a, Vec3 b, float f) {
+XMATH_API Vec3 Vec3Nlerp(Vec3 a, Vec3 b, float f) {
   Vec3 r = (Vec3){
       a.x + (b.x - a.x) * f,
       a.y + (b.y - a.y) * f,
@@ -5,6 +5,7 @@
 #ifndef XMATH_VEC3_H
 #define XMATH_VEC3_H
 #include <stdbool.h>
+#include "api.h"
 
 /**
  * @brief Vector of three dimensions.
@@ -48,7 +49,7 @@ static const Vec3 Vec3Back = {0.0f, 0.0f, 1.0f};
  * @param vec reference of the vector.
  * @return The address of first component.
  */
-float* Vec3Floats(Vec3* vec);
+XMATH_API float* Vec3Floats(Vec3* vec);
 
 /**
  * @brief Compare the components of two vectors and return if they are approx
@@ -57,7 +58,7 @@ float* Vec3Floats(Vec3* vec);
  * @param b second vector.
  * @return true if a components are near b components.
  */
-bool Vec3EqualApprox(Vec3 a, Vec3 b);
+XMATH_API bool Vec3EqualApprox(Vec3 a, Vec3 b);
 
 /**
  * @brief Standard 3d vector addition.
@@ -65,7 +66,7 @@ bool Vec3EqualApprox(Vec3 a, Vec3 b);
  * @param b second element.
  * @return the sum of each element's components.
  */
-Vec3 Vec3Add(Vec3 a, Vec3 b);
+XMATH_API Vec3 Vec3Add(Vec3 a, Vec3 b);
 
 /**
  * @brief Standard 3d vector subtraction.
@@ -73,7 +74,7 @@ Vec3 Vec3Add(Vec3 a, Vec3 b);
  * @param b second element.
  * @return the difference of each element's components.
  */
-Vec3 Vec3Sub(Vec3 a, Vec3 b);
+XMATH_API Vec3 Vec3Sub(Vec3 a, Vec3 b);
 
 /**
  * @brief Multiply each component of a with its equivalent in b.
@@ -81,7 +82,7 @@ Vec3 Vec3Sub(Vec3 a, Vec3 b);
  * @param b scale value (unaffected).
  * @return inner multiplication of both a and b components.
  */
-Vec3 Vec3InnerMul(Vec3 a, Vec3 b);
+XMATH_API Vec3 Vec3InnerMul(Vec3 a, Vec3 b);
 
 /**
  * @brief Standard 3d vector scale.
@@ -89,7 +90,7 @@ Vec3 Vec3InnerMul(Vec3 a, Vec3 b);
  * @param s a scale.
  * @return a vector containing v components with s scale.
  */
-Vec3 Vec3Scale(Vec3 v, float s);
+XMATH_API Vec3 Vec3Scale(Vec3 v, float s);
 
 /**
  * @brief Squared length of a 3d vector.
@@ -99,21 +100,21 @@ Vec3 Vec3Scale(Vec3 v, float s);
  * @param v a vector (unaffected).
  * @return squared vector length.
  */
-float Vec3SqrLen(Vec3 v);
+XMATH_API float Vec3SqrLen(Vec3 v);
 
 /**
  * @brief Standard length of a 3d vector.
  * @param v a vector (unaffected).
  * @return vector's length.
  */
-float Vec3Len(Vec3 v);
+XMATH_API float Vec3Len(Vec3 v);
 
 /**
  * @brief Normalize a vector (divide each component by its inverse length).
  * @param v vector (unaffected).
  * @return normalized vector.
  */
-Vec3 Vec3Norm(Vec3 v);
+XMATH_API Vec3 Vec3Norm(Vec3 v);
 
 /**
  * @brief Orthonormalization of a vector.
@@ -121,7 +122,7 @@ Vec3 Vec3Norm(Vec3 v);
  * @param b vector (unaffected).
  * @return orthonormalization between a and b.
  */
-Vec3 Vec3Orthonormalize(Vec3 a, Vec3 b);
+XMATH_API Vec3 Vec3Orthonormalize(Vec3 a, Vec3 b);
 
 /**
  * @brief Return the greater value of each component of two vectors.
@@ -132,7 +133,7 @@ Vec3 Vec3Orthonormalize(Vec3 a, Vec3 b);
  * @param b second vector.
  * @return a new vector containing the max values of each vector.
  */
-Vec3 Vec3Max(Vec3 a, Vec3 b);
+XMATH_API Vec3 Vec3Max(Vec3 a, Vec3 b);
 
 /**
  * @brief Return the lesser value of each component of two vectors.
@@ -143,7 +144,7 @@ Vec3 Vec3Max(Vec3 a, Vec3 b);
  * @param b second vector.
  * @return a new vector containing the min values of each vector.
  */
-Vec3 Vec3Min(Vec3 a, Vec3 b);
+XMATH_API Vec3 Vec3Min(Vec3 a, Vec3 b);
 
 /**
  * @brief Angle between two vectors.
@@ -151,7 +152,7 @@ Vec3 Vec3Min(Vec3 a, Vec3 b);
  * @param b any vector.
  * @return angle in radians.
  */
-float Vec3Angle(Vec3 a, Vec3 b);
+XMATH_API float Vec3Angle(Vec3 a, Vec3 b);
 
 /**
  * @brief Dot product of two vector.
@@ -159,7 +160,7 @@ float Vec3Angle(Vec3 a, Vec3 b);
  * @param b any vector.
  * @return standard dot result.
  */
-float Vec3Dot(Vec3 a, Vec3 b);
+XMATH_API float Vec3Dot(Vec3 a, Vec3 b);
 
 /**
  * @brief Cross product of two vectors.
@@ -167,7 +168,7 @@ float Vec3Dot(Vec3 a, Vec3 b);
  * @param r any vector.
  * @return standard cross product.
  */
-Vec3 Vec3Cross(Vec3 l, Vec3 r);
+XMATH_API Vec3 Vec3Cross(Vec3 l, Vec3 r);
 
 /**
  * @brief Projects a vector into another.
@@ -175,7 +176,7 @@ Vec3 Vec3Cross(Vec3 l, Vec3 r);
  * @param b projected into vector.
  * @return the vector within b that's a projection of a.
  */
-Vec3 Vec3Project(Vec3 a, Vec3 b);
+XMATH_API Vec3 Vec3Project(Vec3 a, Vec3 b);
 
 /**
  * @brief Rejection of a vector into another.
@@ -183,7 +184,7 @@ Vec3 Vec3Project(Vec3 a, Vec3 b);
  * @param b rejected into vector.
  * @return the subtraction between rejecting vector and a and b's projection.
  */
-Vec3 Vec3Reject(Vec3 a, Vec3 b);
+XMATH_API Vec3 Vec3Reject(Vec3 a, Vec3 b);
 
 /**
  * @brief Reflection of a vector into another.
@@ -191,7 +192,7 @@ Vec3 Vec3Reject(Vec3 a, Vec3 b);
  * @param b
  * @return
  */
-Vec3 Vec3Reflect(Vec3 a, Vec3 b);
+XMATH_API Vec3 Vec3Reflect(Vec3 a, Vec3 b);
 
 /**
  * @brief Linear interpolation of a into b by factor f.
@@ -200,7 +201,7 @@ Vec3 Vec3Reflect(Vec3 a, Vec3 b);
  * @param f factor (between 0 and 1).
  * @return a linearly interpolated vector.
  */
-Vec3 Vec3Lerp(Vec3 a, Vec3 b, float f);
+XMATH_API Vec3 Vec3Lerp(Vec3 a, Vec3 b, float f);
 
 /**
  * @brief Spherical linear interpolation of a into b by factor f.
@@ -209,7 +210,7 @@ Vec3 Vec3Lerp(Vec3 a, Vec3 b, float f);
  * @param f factor (between 0 and 1).
  * @return a spherical linearly interpolated vector.
  */
-Vec3 Vec3Slerp(Vec3 a, Vec3 b, float f);
+XMATH_API Vec3 Vec3Slerp(Vec3 a, Vec3 b, float f);
 
 /**
  * @brief Normalized linear interpolation of a into b by factor f.
@@ -218,6 +219,10 @@ Vec3 Vec3Slerp(Vec3 a, Vec3 b, float f);
  * @param f factor (between 0 and 1).
  * @return a normalized linearly interpolated vector.
  */
-Vec3 Vec3Nlerp(Vec3 a, Vec3 b, float f);
+XMATH_API Vec3 Vec3Nlerp(Vec3 a, Vec3 b, float f);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "vec3.c"
+#endif
 
 #endif /* XMATH_VEC3_H */
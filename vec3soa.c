@@ -0,0 +1,181 @@
+#include "vec3soa.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "scalar.h"
+#include "simd.h"
+
+// Lanes processed by every step of the batch loops.
+#define XMATH_SOA_STEP 8
+
+static inline size_t Vec3SoARoundUp(size_t count, size_t width) {
+  return (count + width - 1) / width * width;
+}
+
+// Prepare r to receive count vectors, padding included.
+static inline void Vec3SoAResize(Vec3SoA* r, size_t count) {
+  assert(r != NULL);
+  assert(Vec3SoARoundUp(count, XMATH_SOA_STEP) <= r->capacity);
+  r->count = count;
+}
+
+XMATH_API bool Vec3SoAMake(Vec3SoA* r, size_t count) {
+  assert(r != NULL);
+
+  size_t capacity = Vec3SoARoundUp(count, XMATH_SOA_WIDTH);
+  if (capacity == 0) {
+    capacity = XMATH_SOA_WIDTH;
+  }
+
+  // One block holds the three streams, each one stays aligned because the
+  // capacity is a multiple of the alignment.
+  size_t size = 3 * capacity * sizeof(float);
+#if defined(_MSC_VER)
+  float* block = _aligned_malloc(size, XMATH_SOA_ALIGN);
+#else
+  float* block = aligned_alloc(XMATH_SOA_ALIGN, size);
+#endif
+  if (block == NULL) {
+    *r = (Vec3SoA){0};
+    return false;
+  }
+
+  memset(block, 0, size);
+  r->x = block;
+  r->y = block + capacity;
+  r->z = block + 2 * capacity;
+  r->count = count;
+  r->capacity = capacity;
+  return true;
+}
+
+XMATH_API void Vec3SoAFree(Vec3SoA* v) {
+  assert(v != NULL);
+#if defined(_MSC_VER)
+  _aligned_free(v->x);
+#else
+  free(v->x);
+#endif
+  *v = (Vec3SoA){0};
+}
+
+XMATH_API void Vec3SoAFromArray(Vec3SoA* r, const Vec3* in, size_t count) {
+  Vec3SoAResize(r, count);
+  for (size_t i = 0; i < count; i++) {
+    r->x[i] = in[i].x;
+    r->y[i] = in[i].y;
+    r->z[i] = in[i].z;
+  }
+
+  size_t padded = Vec3SoARoundUp(count, XMATH_SOA_STEP);
+  for (size_t i = count; i < padded; i++) {
+    r->x[i] = 0.0f;
+    r->y[i] = 0.0f;
+    r->z[i] = 0.0f;
+  }
+}
+
+XMATH_API void Vec3SoAToArray(Vec3* out, const Vec3SoA* v) {
+  for (size_t i = 0; i < v->count; i++) {
+    out[i] = (Vec3){v->x[i], v->y[i], v->z[i]};
+  }
+}
+
+XMATH_API void Vec3SoAAdd(Vec3SoA* r, const Vec3SoA* a, const Vec3SoA* b) {
+  assert(a->count == b->count);
+  Vec3SoAResize(r, a->count);
+  for (size_t i = 0; i < a->count; i += XMATH_SOA_STEP) {
+    F32x8 x = F32x8Add(F32x8Load(a->x + i), F32x8Load(b->x + i));
+    F32x8 y = F32x8Add(F32x8Load(a->y + i), F32x8Load(b->y + i));
+    F32x8 z = F32x8Add(F32x8Load(a->z + i), F32x8Load(b->z + i));
+    F32x8Store(r->x + i, x);
+    F32x8Store(r->y + i, y);
+    F32x8Store(r->z + i, z);
+  }
+}
+
+XMATH_API void Vec3SoAScale(Vec3SoA* r, const Vec3SoA* a, float s) {
+  Vec3SoAResize(r, a->count);
+  F32x8 k = F32x8Splat(s);
+  for (size_t i = 0; i < a->count; i += XMATH_SOA_STEP) {
+    F32x8Store(r->x + i, F32x8Mul(F32x8Load(a->x + i), k));
+    F32x8Store(r->y + i, F32x8Mul(F32x8Load(a->y + i), k));
+    F32x8Store(r->z + i, F32x8Mul(F32x8Load(a->z + i), k));
+  }
+}
+
+XMATH_API void Vec3SoADot(float* out, const Vec3SoA* a, const Vec3SoA* b) {
+  assert(a->count == b->count);
+  size_t count = a->count;
+  for (size_t i = 0; i < count; i += XMATH_SOA_STEP) {
+    F32x8 d = F32x8Mul(F32x8Load(a->x + i), F32x8Load(b->x + i));
+    d = F32x8MulAdd(F32x8Load(a->y + i), F32x8Load(b->y + i), d);
+    d = F32x8MulAdd(F32x8Load(a->z + i), F32x8Load(b->z + i), d);
+
+    // out has no padding, the last step only writes what is left.
+    if (i + XMATH_SOA_STEP <= count) {
+      F32x8Store(out + i, d);
+    } else {
+      float rest[XMATH_SOA_STEP];
+      F32x8Store(rest, d);
+      memcpy(out + i, rest, (count - i) * sizeof(float));
+    }
+  }
+}
+
+XMATH_API void Vec3SoACross(Vec3SoA* r, const Vec3SoA* a, const Vec3SoA* b) {
+  assert(a->count == b->count);
+  Vec3SoAResize(r, a->count);
+  for (size_t i = 0; i < a->count; i += XMATH_SOA_STEP) {
+    F32x8 ax = F32x8Load(a->x + i);
+    F32x8 ay = F32x8Load(a->y + i);
+    F32x8 az = F32x8Load(a->z + i);
+    F32x8 bx = F32x8Load(b->x + i);
+    F32x8 by = F32x8Load(b->y + i);
+    F32x8 bz = F32x8Load(b->z + i);
+    F32x8Store(r->x + i, F32x8Sub(F32x8Mul(ay, bz), F32x8Mul(az, by)));
+    F32x8Store(r->y + i, F32x8Sub(F32x8Mul(az, bx), F32x8Mul(ax, bz)));
+    F32x8Store(r->z + i, F32x8Sub(F32x8Mul(ax, by), F32x8Mul(ay, bx)));
+  }
+}
+
+XMATH_API void Vec3SoANorm(Vec3SoA* r, const Vec3SoA* a) {
+  Vec3SoAResize(r, a->count);
+  F32x8 one = F32x8Splat(1.0f);
+  F32x8 eps = F32x8Splat(XMATH_EPSILON);
+  for (size_t i = 0; i < a->count; i += XMATH_SOA_STEP) {
+    F32x8 x = F32x8Load(a->x + i);
+    F32x8 y = F32x8Load(a->y + i);
+    F32x8 z = F32x8Load(a->z + i);
+    F32x8 sqr = F32x8Mul(x, x);
+    sqr = F32x8MulAdd(y, y, sqr);
+    sqr = F32x8MulAdd(z, z, sqr);
+
+    // Short vectors keep a factor of one, as Vec3Norm returns them as is.
+    F32x8 len = F32x8Sqrt(sqr);
+    F32x8 k = F32x8Select(F32x8Less(len, eps), one, F32x8Div(one, len));
+    F32x8Store(r->x + i, F32x8Mul(x, k));
+    F32x8Store(r->y + i, F32x8Mul(y, k));
+    F32x8Store(r->z + i, F32x8Mul(z, k));
+  }
+}
+
+XMATH_API void Vec3SoALerp(Vec3SoA* r,
+                           const Vec3SoA* a,
+                           const Vec3SoA* b,
+                           float f) {
+  assert(a->count == b->count);
+  Vec3SoAResize(r, a->count);
+  F32x8 t = F32x8Splat(f);
+  for (size_t i = 0; i < a->count; i += XMATH_SOA_STEP) {
+    F32x8 ax = F32x8Load(a->x + i);
+    F32x8 ay = F32x8Load(a->y + i);
+    F32x8 az = F32x8Load(a->z + i);
+    F32x8 dx = F32x8Sub(F32x8Load(b->x + i), ax);
+    F32x8 dy = F32x8Sub(F32x8Load(b->y + i), ay);
+    F32x8 dz = F32x8Sub(F32x8Load(b->z + i), az);
+    F32x8Store(r->x + i, F32x8MulAdd(dx, t, ax));
+    F32x8Store(r->y + i, F32x8MulAdd(dy, t, ay));
+    F32x8Store(r->z + i, F32x8MulAdd(dz, t, az));
+  }
+}
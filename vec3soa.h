@@ -0,0 +1,121 @@
+/**
+ * @file vec3soa.h
+ * @brief Structure of arrays streams of 3d vectors.
+ */
+#ifndef XMATH_VEC3SOA_H
+#define XMATH_VEC3SOA_H
+#include <stdbool.h>
+#include <stddef.h>
+#include "api.h"
+#include "vec3.h"
+
+//! @brief Number of floats every Vec3SoA stream is padded to.
+#define XMATH_SOA_WIDTH 16
+
+//! @brief Alignment in bytes of the Vec3SoA streams.
+#define XMATH_SOA_ALIGN 64
+
+/**
+ * @brief Stream of 3d vectors stored as separate x, y and z arrays.
+ *
+ * Each array is aligned to XMATH_SOA_ALIGN bytes and has room for capacity
+ * floats, a multiple of XMATH_SOA_WIDTH. The batch functions work on whole
+ * vector registers, so the lanes past count are padding: they are zero after
+ * Vec3SoAMake and Vec3SoAFromArray and hold unspecified values after any
+ * other function writes the stream.
+ */
+typedef struct {
+  float* x;
+  float* y;
+  float* z;
+  size_t count;
+  size_t capacity;
+} Vec3SoA;
+
+/**
+ * @brief Allocate a zeroed stream of count vectors.
+ * @param r stream to initialize.
+ * @param count number of vectors.
+ * @return false if the memory could not be allocated.
+ */
+XMATH_API bool Vec3SoAMake(Vec3SoA* r, size_t count);
+
+/**
+ * @brief Release the memory of a stream made by Vec3SoAMake.
+ * @param v stream to release, left empty.
+ */
+XMATH_API void Vec3SoAFree(Vec3SoA* v);
+
+/**
+ * @brief Copy an array of Vec3 into a stream.
+ * @param r destination stream, its capacity must fit count vectors.
+ * @param in source of count vectors.
+ * @param count number of vectors, becomes the count of r.
+ */
+XMATH_API void Vec3SoAFromArray(Vec3SoA* r, const Vec3* in, size_t count);
+
+/**
+ * @brief Copy a stream into an array of Vec3.
+ * @param out destination with room for v->count vectors.
+ * @param v source stream (unaffected).
+ */
+XMATH_API void Vec3SoAToArray(Vec3* out, const Vec3SoA* v);
+
+/**
+ * @brief Add two streams element by element.
+ * @param r destination stream, can be a or b.
+ * @param a first stream.
+ * @param b second stream, same count as a.
+ */
+XMATH_API void Vec3SoAAdd(Vec3SoA* r, const Vec3SoA* a, const Vec3SoA* b);
+
+/**
+ * @brief Scale every vector of a stream.
+ * @param r destination stream, can be a.
+ * @param a source stream.
+ * @param s scalar factor.
+ */
+XMATH_API void Vec3SoAScale(Vec3SoA* r, const Vec3SoA* a, float s);
+
+/**
+ * @brief Dot product of two streams element by element.
+ * @param out destination with room for a->count floats.
+ * @param a first stream.
+ * @param b second stream, same count as a.
+ */
+XMATH_API void Vec3SoADot(float* out, const Vec3SoA* a, const Vec3SoA* b);
+
+/**
+ * @brief Cross product of two streams element by element.
+ * @param r destination stream, can be a or b.
+ * @param a left stream.
+ * @param b right stream, same count as a.
+ */
+XMATH_API void Vec3SoACross(Vec3SoA* r, const Vec3SoA* a, const Vec3SoA* b);
+
+/**
+ * @brief Normalize every vector of a stream.
+ *
+ * Vectors shorter than XMATH_EPSILON are copied unchanged, like Vec3Norm.
+ * @param r destination stream, can be a.
+ * @param a source stream.
+ */
+XMATH_API void Vec3SoANorm(Vec3SoA* r, const Vec3SoA* a);
+
+/**
+ * @brief Linear interpolation between two streams element by element.
+ * @param r destination stream, can be a or b.
+ * @param a initial stream.
+ * @param b final stream, same count as a.
+ * @param f factor (between 0 and 1).
+ */
+XMATH_API void Vec3SoALerp(Vec3SoA* r,
+                           const Vec3SoA* a,
+                           const Vec3SoA* b,
+                           float f);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "vec3soa.c"
+#endif
+
+#endif /* XMATH_VEC3SOA_H */
@@ -0,0 +1,143 @@
+// clang-format off
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <cmocka.h>
+// clang-format on
+
+#include "vec3soa.h"
+#include "common_testing.h"
+#include "scalar.h"
+
+// Not a multiple of the vector width, so the padding lanes are exercised.
+#define COUNT 11
+
+static Vec3 gA[COUNT];
+static Vec3 gB[COUNT];
+
+static void FillInputs(void) {
+  for (unsigned i = 0; i < COUNT; i++) {
+    float f = 0.1f * (float)i;
+    gA[i] = (Vec3){f, 1.0f - f, 0.5f * f};
+    gB[i] = (Vec3){-f, 0.25f, f * f};
+  }
+
+  // A short vector must be left as is by Vec3SoANorm.
+  gA[3] = (Vec3){0.0f, 0.0f, 0.0f};
+}
+
+static void test_Vec3SoAMake(void** state) {
+  UNUSED(state);
+
+  Vec3SoA v;
+  assert_true(Vec3SoAMake(&v, COUNT));
+  assert_int_equal(v.count, COUNT);
+  assert_true(v.capacity >= COUNT);
+  assert_int_equal(v.capacity % XMATH_SOA_WIDTH, 0);
+  assert_int_equal((uintptr_t)v.x % XMATH_SOA_ALIGN, 0);
+  assert_int_equal((uintptr_t)v.y % XMATH_SOA_ALIGN, 0);
+  assert_int_equal((uintptr_t)v.z % XMATH_SOA_ALIGN, 0);
+  for (size_t i = 0; i < v.capacity; i++) {
+    assert_float_equal(v.x[i], 0.0f, XMATH_EPSILON);
+  }
+
+  Vec3SoAFree(&v);
+  assert_true(v.x == NULL);
+  assert_int_equal(v.count, 0);
+}
+
+static void test_Vec3SoAConvert(void** state) {
+  UNUSED(state);
+
+  Vec3SoA v;
+  Vec3 out[COUNT];
+  FillInputs();
+  assert_true(Vec3SoAMake(&v, COUNT));
+  Vec3SoAFromArray(&v, gA, COUNT);
+  Vec3SoAToArray(out, &v);
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_true(Vec3EqualApprox(out[i], gA[i]));
+    assert_float_equal(v.y[i], gA[i].y, XMATH_EPSILON);
+  }
+
+  Vec3SoAFree(&v);
+}
+
+static void test_Vec3SoAOps(void** state) {
+  UNUSED(state);
+
+  Vec3SoA a;
+  Vec3SoA b;
+  Vec3SoA r;
+  Vec3 out[COUNT];
+  float dots[COUNT + 1];
+  FillInputs();
+  assert_true(Vec3SoAMake(&a, COUNT));
+  assert_true(Vec3SoAMake(&b, COUNT));
+  assert_true(Vec3SoAMake(&r, COUNT));
+  Vec3SoAFromArray(&a, gA, COUNT);
+  Vec3SoAFromArray(&b, gB, COUNT);
+
+  Vec3SoAAdd(&r, &a, &b);
+  Vec3SoAToArray(out, &r);
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_true(Vec3EqualApprox(out[i], Vec3Add(gA[i], gB[i])));
+  }
+
+  Vec3SoAScale(&r, &a, -2.0f);
+  Vec3SoAToArray(out, &r);
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_true(Vec3EqualApprox(out[i], Vec3Scale(gA[i], -2.0f)));
+  }
+
+  // Nothing is written past the last element.
+  dots[COUNT] = 42.0f;
+  Vec3SoADot(dots, &a, &b);
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_float_equal(dots[i], Vec3Dot(gA[i], gB[i]), XMATH_EPSILON);
+  }
+  assert_float_equal(dots[COUNT], 42.0f, XMATH_EPSILON);
+
+  Vec3SoACross(&r, &a, &b);
+  Vec3SoAToArray(out, &r);
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_true(Vec3EqualApprox(out[i], Vec3Cross(gA[i], gB[i])));
+  }
+
+  Vec3SoANorm(&r, &a);
+  Vec3SoAToArray(out, &r);
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_true(Vec3EqualApprox(out[i], Vec3Norm(gA[i])));
+  }
+
+  Vec3SoALerp(&r, &a, &b, 0.3f);
+  Vec3SoAToArray(out, &r);
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_true(Vec3EqualApprox(out[i], Vec3Lerp(gA[i], gB[i], 0.3f)));
+  }
+
+  // In place.
+  Vec3SoAAdd(&a, &a, &b);
+  Vec3SoAToArray(out, &a);
+  for (unsigned i = 0; i < COUNT; i++) {
+    assert_true(Vec3EqualApprox(out[i], Vec3Add(gA[i], gB[i])));
+  }
+
+  Vec3SoAFree(&a);
+  Vec3SoAFree(&b);
+  Vec3SoAFree(&r);
+}
+
+int main() {
+  UNUSED_TYPE(jmp_buf);
+  UNUSED_TYPE(va_list);
+
+  const struct CMUnitTest tests[] = {
+      cmocka_unit_test(test_Vec3SoAMake),
+      cmocka_unit_test(test_Vec3SoAConvert),
+      cmocka_unit_test(test_Vec3SoAOps),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -1,38 +1,51 @@
 #include "vec4.h"
 #include "scalar.h"
+#include "simd.h"
 
 #include <math.h>
 
-float* Vec4Floats(Vec4* vec) {
+static inline F32x4 Vec4ToF32x4(Vec4 v) {
+  return F32x4LoadHalves(&v.x);
+}
+
+static inline Vec4 F32x4ToVec4(F32x4 a) {
+  Vec4 r;
+  F32x4Store(&r.x, a);
+  return r;
+}
+
+XMATH_API float* Vec4Floats(Vec4* vec) {
   return &vec->x;
 }
 
-bool Vec4EqualApprox(Vec4 a, Vec4 b) {
+XMATH_API bool Vec4EqualApprox(Vec4 a, Vec4 b) {
   Vec4 diff = Vec4Sub(a, b);
   return Vec4Len(diff) <= XMATH_EPSILON;
 }
 
-Vec4 Vec4Add(Vec4 a, Vec4 b) {
-  return (Vec4){a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w};
+XMATH_API Vec4 Vec4Add(Vec4 a, Vec4 b) {
+  return F32x4ToVec4(F32x4Add(Vec4ToF32x4(a), Vec4ToF32x4(b)));
 }
 
-Vec4 Vec4Sub(Vec4 a, Vec4 b) {
-  return (Vec4){a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w};
+XMATH_API Vec4 Vec4Sub(Vec4 a, Vec4 b) {
+  return F32x4ToVec4(F32x4Sub(Vec4ToF32x4(a), Vec4ToF32x4(b)));
 }
 
-Vec4 Vec4Scale(Vec4 v, float s) {
-  return (Vec4){v.x * s, v.y * s, v.z * s, v.w * s};
+XMATH_API Vec4 Vec4Scale(Vec4 v, float s) {
+  return F32x4ToVec4(F32x4Mul(Vec4ToF32x4(v), F32x4Splat(s)));
 }
 
-float Vec4SqrLen(Vec4 v) {
-  return v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w;
+XMATH_API float Vec4SqrLen(Vec4 v) {
+  F32x4 a = Vec4ToF32x4(v);
+  return F32x4Dot(a, a);
 }
 
-float Vec4Len(Vec4 v) {
-  return sqrtf(v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w);
+XMATH_API float Vec4Len(Vec4 v) {
+  F32x4 a = Vec4ToF32x4(v);
+  return sqrtf(F32x4Dot(a, a));
 }
 
-Vec4 Vec4Norm(Vec4 v) {
+XMATH_API Vec4 Vec4Norm(Vec4 v) {
   float vl = Vec4Len(v);
   if (vl < XMATH_EPSILON) {
     return v;
@@ -42,25 +55,15 @@ Vec4 Vec4Norm(Vec4 v) {
   return Vec4Scale(v, k);
 }
 
-Vec4 Vec4Max(Vec4 a, Vec4 b) {
-  Vec4 r = {0};
-  r.x = FMax(a.x, b.x);
-  r.y = FMax(a.y, b.y);
-  r.z = FMax(a.z, b.z);
-  r.w = FMax(a.w, b.w);
-  return r;
+XMATH_API Vec4 Vec4Max(Vec4 a, Vec4 b) {
+  return F32x4ToVec4(F32x4Max(Vec4ToF32x4(a), Vec4ToF32x4(b)));
 }
 
-Vec4 Vec4Min(Vec4 a, Vec4 b) {
-  Vec4 r = {0};
-  r.x = FMin(a.x, b.x);
-  r.y = FMin(a.y, b.y);
-  r.z = FMin(a.z, b.z);
-  r.w = FMin(a.w, b.w);
-  return r;
+XMATH_API Vec4 Vec4Min(Vec4 a, Vec4 b) {
+  return F32x4ToVec4(F32x4Min(Vec4ToF32x4(a), Vec4ToF32x4(b)));
 }
 
-float Vec4Angle(Vec4 a, Vec4 b) {
+XMATH_API float Vec4Angle(Vec4 a, Vec4 b) {
   float aSqrLen = Vec4SqrLen(a);
   float bSqrLen = Vec4SqrLen(b);
   if (aSqrLen < XMATH_EPSILON || bSqrLen < XMATH_EPSILON) {
@@ -71,11 +74,11 @@ float Vec4Angle(Vec4 a, Vec4 b) {
   return acosf(dot / (sqrtf(aSqrLen) * sqrtf(bSqrLen)));
 }
 
-float Vec4Dot(Vec4 a, Vec4 b) {
-  return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+XMATH_API float Vec4Dot(Vec4 a, Vec4 b) {
+  return F32x4Dot(Vec4ToF32x4(a), Vec4ToF32x4(b));
 }
 
-Vec4 Vec4Project(Vec4 a, Vec4 b) {
+XMATH_API Vec4 Vec4Project(Vec4 a, Vec4 b) {
   float bSqrLen = Vec4SqrLen(b);
   if (bSqrLen < XMATH_EPSILON) {
     return Vec4Zero;
@@ -85,28 +88,25 @@ Vec4 Vec4Project(Vec4 a, Vec4 b) {
   return Vec4Scale(b, scale);
 }
 
-Vec4 Vec4Reject(Vec4 a, Vec4 b) {
+XMATH_API Vec4 Vec4Reject(Vec4 a, Vec4 b) {
   Vec4 p = Vec4Project(a, b);
   return Vec4Sub(a, p);
 }
 
-Vec4 Vec4Reflect(Vec4 a, Vec4 b) {
+XMATH_API Vec4 Vec4Reflect(Vec4 a, Vec4 b) {
   Vec4 n = Vec4Norm(b);
   Vec4 r = Vec4Sub(a, Vec4Scale(n, 2 * Vec4Dot(a, n)));
   return r;
 }
 
-Vec4 Vec4Lerp(Vec4 a, Vec4 b, float f) {
+XMATH_API Vec4 Vec4Lerp(Vec4 a, Vec4 b, float f) {
   // TODO: handle imprecision
-  return (Vec4){
-      a.x + (b.x - a.x) * f,
-      a.y + (b.y - a.y) * f,
-      a.z + (b.z - a.z) * f,
-      a.w + (b.w - a.w) * f,
-  };
+  F32x4 from = Vec4ToF32x4(a);
+  F32x4 diff = F32x4Sub(Vec4ToF32x4(b), from);
+  return F32x4ToVec4(F32x4MulAdd(diff, F32x4Splat(f), from));
 }
 
-Vec4 Vec4Slerp(Vec4 a, Vec4 b, float f) {
+XMATH_API Vec4 Vec4Slerp(Vec4 a, Vec4 b, float f) {
   if (f < 0.01f) {
     return Vec4Lerp(a, b, f);
   }
@@ -122,12 +122,6 @@ Vec4 Vec4Slerp(Vec4 a, Vec4 b, float f) {
   return Vec4Add(Vec4Scale(from, fa), Vec4Scale(to, fb));
 }
 
-Vec4 Vec4Nlerp(Vec4 a, Vec4 b, float f) {
-  Vec4 r = (Vec4){
-      a.x + (b.x - a.x) * f,
-      a.y + (b.y - a.y) * f,
-      a.z + (b.z - a.z) * f,
-      a.w + (b.w - a.w) * f,
-  };
-  return Vec4Norm(r);
+XMATH_API Vec4 Vec4Nlerp(Vec4 a, Vec4 b, float f) {
+  return Vec4Norm(Vec4Lerp(a, b, f));
 }
@@ -5,6 +5,7 @@
 #ifndef XMATH_VEC4_H
 #define XMATH_VEC4_H
 #include <stdbool.h>
+#include "api.h"
 
 /**
  * @brief Vector of four dimensions.
@@ -31,7 +32,7 @@ static const Vec4 Vec4One = {1.0f, 1.0f, 1.0f, 1.0f};
  * @param vec reference of the vector.
  * @return The address of first component.
  */
-float* Vec4Floats(Vec4* vec);
+XMATH_API float* Vec4Floats(Vec4* vec);
 
 /**
  * @brief Compare the components of two vectors and return if they are approx
@@ -40,7 +41,7 @@ float* Vec4Floats(Vec4* vec);
  * @param b second vector.
  * @return true if a components are near b components.
  */
-bool Vec4EqualApprox(Vec4 a, Vec4 b);
+XMATH_API bool Vec4EqualApprox(Vec4 a, Vec4 b);
 
 /**
  * @brief Standard 4d vector addition.
@@ -48,7 +49,7 @@ bool Vec4EqualApprox(Vec4 a, Vec4 b);
  * @param b second element.
  * @return the sum of each element's components.
  */
-Vec4 Vec4Add(Vec4 a, Vec4 b);
+XMATH_API Vec4 Vec4Add(Vec4 a, Vec4 b);
 
 /**
  * @brief Standard 4d vector subtraction.
@@ -56,7 +57,7 @@ Vec4 Vec4Add(Vec4 a, Vec4 b);
  * @param b second element.
  * @return the difference of each element's components.
  */
-Vec4 Vec4Sub(Vec4 a, Vec4 b);
+XMATH_API Vec4 Vec4Sub(Vec4 a, Vec4 b);
 
 /**
  * @brief Standard 4d vector scale.
@@ -64,7 +65,7 @@ Vec4 Vec4Sub(Vec4 a, Vec4 b);
  * @param s a scale.
  * @return a vector containing v components with s scale.
  */
-Vec4 Vec4Scale(Vec4 v, float s);
+XMATH_API Vec4 Vec4Scale(Vec4 v, float s);
 
 /**
  * @brief Squared length of a 4d vector.
@@ -74,21 +75,21 @@ Vec4 Vec4Scale(Vec4 v, float s);
  * @param v a vector (unaffected).
  * @return squared vector length.
  */
-float Vec4SqrLen(Vec4 v);
+XMATH_API float Vec4SqrLen(Vec4 v);
 
 /**
  * @brief Standard length of a 4d vector.
  * @param v a vector (unaffected).
  * @return vector's length.
  */
-float Vec4Len(Vec4 v);
+XMATH_API float Vec4Len(Vec4 v);
 
 /**
  * @brief Normalize a vector (divide each component by its inverse length).
  * @param v vector (unaffected).
  * @return normalized vector.
  */
-Vec4 Vec4Norm(Vec4 v);
+XMATH_API Vec4 Vec4Norm(Vec4 v);
 
 /**
  * @brief Return the greater value of each component of two vectors.
@@ -99,7 +100,7 @@ Vec4 Vec4Norm(Vec4 v);
  * @param b second vector.
  * @return a new vector containing the max values of each vector.
  */
-Vec4 Vec4Max(Vec4 a, Vec4 b);
+XMATH_API Vec4 Vec4Max(Vec4 a, Vec4 b);
 
 /**
  * @brief Return the lesser value of each component of two vectors.
@@ -110,7 +111,7 @@ Vec4 Vec4Max(Vec4 a, Vec4 b);
  * @param b second vector.
  * @return a new vector containing the min values of each vector.
  */
-Vec4 Vec4Min(Vec4 a, Vec4 b);
+XMATH_API Vec4 Vec4Min(Vec4 a, Vec4 b);
 
 /**
  * @brief Angle between two vectors.
@@ -118,7 +119,7 @@ Vec4 Vec4Min(Vec4 a, Vec4 b);
  * @param b any vector.
  * @return angle in radians.
  */
-float Vec4Angle(Vec4 a, Vec4 b);
+XMATH_API float Vec4Angle(Vec4 a, Vec4 b);
 
 /**
  * @brief Dot product of two vector.
@@ -126,7 +127,7 @@ float Vec4Angle(Vec4 a, Vec4 b);
  * @param b any vector.
  * @return standard dot result.
  */
-float Vec4Dot(Vec4 a, Vec4 b);
+XMATH_API float Vec4Dot(Vec4 a, Vec4 b);
 
 /**
  * @brief Projects a vector into another.
@@ -134,7 +135,7 @@ float Vec4Dot(Vec4 a, Vec4 b);
  * @param b projected into vector.
  * @return the vector within b that's a projection of a.
  */
-Vec4 Vec4Project(Vec4 a, Vec4 b);
+XMATH_API Vec4 Vec4Project(Vec4 a, Vec4 b);
 
 /**
  * @brief Rejection of a vector into another.
@@ -142,7 +143,7 @@ Vec4 Vec4Project(Vec4 a, Vec4 b);
  * @param b rejected into vector.
  * @return the subtraction between rejecting vector and a and b's projection.
  */
-Vec4 Vec4Reject(Vec4 a, Vec4 b);
+XMATH_API Vec4 Vec4Reject(Vec4 a, Vec4 b);
 
 /**
  * @brief Reflection of a vector into another.
@@ -150,7 +151,7 @@ Vec4 Vec4Reject(Vec4 a, Vec4 b);
  * @param b
  * @return
  */
-Vec4 Vec4Reflect(Vec4 a, Vec4 b);
+XMATH_API Vec4 Vec4Reflect(Vec4 a, Vec4 b);
 
 /**
  * @brief Linear interpolation of a into b by factor f.
@@ -159,7 +160,7 @@ Vec4 Vec4Reflect(Vec4 a, Vec4 b);
  * @param f factor (between 0 and 1).
  * @return a linearly interpolated vector.
  */
-Vec4 Vec4Lerp(Vec4 a, Vec4 b, float f);
+XMATH_API Vec4 Vec4Lerp(Vec4 a, Vec4 b, float f);
 
 /**
  * @brief Spherical linear interpolation of a into b by factor f.
@@ -168,7 +169,7 @@ Vec4 Vec4Lerp(Vec4 a, Vec4 b, float f);
  * @param f factor (between 0 and 1).
  * @return a spherical linearly interpolated vector.
  */
-Vec4 Vec4Slerp(Vec4 a, Vec4 b, float f);
+XMATH_API Vec4 Vec4Slerp(Vec4 a, Vec4 b, float f);
 
 /**
  * @brief Normalized linear interpolation of a into b by factor f.
@@ -177,6 +178,10 @@ Vec4 Vec4Slerp(Vec4 a, Vec4 b, float f);
  * @param f factor (between 0 and 1).
  * @return a normalized linearly interpolated vector.
  */
-Vec4 Vec4Nlerp(Vec4 a, Vec4 b, float f);
+XMATH_API Vec4 Vec4Nlerp(Vec4 a, Vec4 b, float f);
+
+#if defined(XMATH_HEADER_ONLY)
+#include "vec4.c"
+#endif
 
 #endif  // XMATH_VEC4_H
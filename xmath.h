@@ -9,11 +9,24 @@
 #include "vec2.h"
 #include "vec3.h"
 #include "vec4.h"
+#include "vec3soa.h"
 
+#include "mat3.h"
 #include "mat4.h"
 #include "quat.h"
 #include "transform.h"
+#include "affine34.h"
+#include "dualquat.h"
+#include "animation.h"
+#include "pose.h"
+#include "hierarchy.h"
+#include "threadpool.h"
+#include "skinning.h"
+#include "packet.h"
 
 #include "curves.h"
+#include "spline.h"
+
+#include "dispatch.h"
 
 #endif /* XMATH_H */
@@ -0,0 +1,1306 @@
+/**
+ * @file xmath_bench.c
+ * @brief Micro benchmarks for the public xmath functions.
+ *
+ * Every function is measured in two forms:
+ *  - scalar: one call at a time, each result is written into a volatile sink
+ *    so the call can not be folded away (call overhead included).
+ *  - batch: the function is applied over a pool of inputs writing into an
+ *    output array, which shows the attainable throughput.
+ *
+ * Usage: xmath_bench [--json] [--filter text] [--min-time ms] [--repeats n]
+ */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define XMATH_BENCH_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define XMATH_BENCH_HAS_TSC 1
+#else
+#define XMATH_BENCH_HAS_TSC 0
+#endif
+
+#include "simd.h"
+#include "xmath.h"
+
+#ifndef XMATH_BENCH_VERSION
+#define XMATH_BENCH_VERSION "unknown"
+#endif
+
+// Size of the input pools, must be a power of two.
+#define BENCH_POOL_SIZE 1024
+#define BENCH_POOL_MASK (BENCH_POOL_SIZE - 1)
+
+typedef float* FloatPtr;
+
+static float gFloatA[BENCH_POOL_SIZE];
+static float gFloatB[BENCH_POOL_SIZE];
+static float gFactor[BENCH_POOL_SIZE];
+static Vec2 gVec2A[BENCH_POOL_SIZE];
+static Vec2 gVec2B[BENCH_POOL_SIZE];
+static Vec3 gVec3A[BENCH_POOL_SIZE];
+static Vec3 gVec3B[BENCH_POOL_SIZE];
+static Vec3 gVec3C[BENCH_POOL_SIZE];
+static Vec4 gVec4A[BENCH_POOL_SIZE];
+static Vec4 gVec4B[BENCH_POOL_SIZE];
+static Quat gQuatA[BENCH_POOL_SIZE];
+static Quat gQuatB[BENCH_POOL_SIZE];
+static Mat4 gMat4A[BENCH_POOL_SIZE];
+static Mat4 gMat4B[BENCH_POOL_SIZE];
+static Transform gTransformA[BENCH_POOL_SIZE];
+static Transform gTransformB[BENCH_POOL_SIZE];
+static Mat3 gMat3A[BENCH_POOL_SIZE];
+static Mat3 gMat3B[BENCH_POOL_SIZE];
+static Affine34 gAffineA[BENCH_POOL_SIZE];
+static Affine34 gAffineB[BENCH_POOL_SIZE];
+static DualQuat gDualQuatA[BENCH_POOL_SIZE];
+static DualQuat gDualQuatB[BENCH_POOL_SIZE];
+static BeizerCurve gBeizer[BENCH_POOL_SIZE];
+static HermitCurve gHermit[BENCH_POOL_SIZE];
+static Vec3 gCurvePoints[BENCH_POOL_SIZE];
+static BeizerArcTable gArcTables[BENCH_POOL_SIZE];
+static float gArcDistances[BENCH_POOL_SIZE];
+static float gArcParams[BENCH_POOL_SIZE];
+
+// Segments of random durations, so the lookup has to search.
+#define BENCH_SEGMENTS 64
+static HermitCurve gSplineCurves[BENCH_SEGMENTS];
+static float gSplineKnots[BENCH_SEGMENTS + 1];
+static float gSplineParams[BENCH_POOL_SIZE];
+static Spline gSpline;
+static Mat4 gMat4Out;
+static Vec3SoA gSoAA;
+static Vec3SoA gSoAB;
+static Vec3SoA gSoAR;
+static Hierarchy gHierarchy;
+static ThreadPool gPool;
+static float gSoADot[BENCH_POOL_SIZE];
+
+#define BENCH_BONES 64
+static uint16_t gJoints[BENCH_POOL_SIZE * XMATH_SKIN_INFLUENCES];
+static float gWeights[BENCH_POOL_SIZE * XMATH_SKIN_INFLUENCES];
+static Vec3 gSkinPositions[BENCH_POOL_SIZE];
+static Vec3 gSkinNormals[BENCH_POOL_SIZE];
+static SkinMesh gSkinMesh;
+
+// One track per pool element, keys 1/30 s apart.
+#define BENCH_KEYS 32
+static float gClipTimes[BENCH_KEYS];
+static Transform gClipKeys[BENCH_POOL_SIZE][BENCH_KEYS];
+static ClipTrack gClipTracks[BENCH_POOL_SIZE];
+static Clip gClip;
+static ClipCursor gClipCursor;
+static Transform gPose[BENCH_POOL_SIZE];
+
+#define BENCH_LAYERS 4
+static PoseSoA gPoseIn[BENCH_LAYERS];
+static PoseSoA gPoseOut;
+static PoseLayer gPoseLayers[BENCH_LAYERS];
+
+#define BENCH_PACKETS (BENCH_POOL_SIZE / XMATH_PACKET_WIDTH)
+static Vec3x8 gVec3x8A[BENCH_PACKETS];
+static Vec3x8 gVec3x8B[BENCH_PACKETS];
+static Vec4x8 gVec4x8[BENCH_PACKETS];
+static Quatx8 gQuatx8A[BENCH_PACKETS];
+static Quatx8 gQuatx8B[BENCH_PACKETS];
+static Mat4x8 gMat4x8[BENCH_PACKETS];
+
+// Published address of the last written batch, keeps the stores alive.
+static void* volatile gEscape;
+
+static uint32_t gRandomState = 0x9E3779B9u;
+
+// xorshift32, deterministic so every run works on the same inputs.
+static float BenchRandom(float lo, float hi) {
+  uint32_t x = gRandomState;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  gRandomState = x;
+  return lo + (hi - lo) * ((float)(x >> 8) / 16777216.0f);
+}
+
+static Vec3 BenchRandomVec3(float lo, float hi) {
+  return (Vec3){BenchRandom(lo, hi), BenchRandom(lo, hi), BenchRandom(lo, hi)};
+}
+
+static Transform BenchRandomTransform(void) {
+  Vec3 axis = BenchRandomVec3(-1.0f, 1.0f);
+  return (Transform){
+      .position = BenchRandomVec3(-10.0f, 10.0f),
+      .rotation = QuatMakeAngleAxis(BenchRandom(0.0f, XMATH_PI), axis),
+      .scale = BenchRandomVec3(0.5f, 2.0f),
+  };
+}
+
+// View of count elements of a stream starting at element i.
+static Vec3SoA BenchSoAView(const Vec3SoA* v, size_t i, size_t count) {
+  return (Vec3SoA){v->x + i, v->y + i, v->z + i, count, v->capacity - i};
+}
+
+static bool BenchSetup(void) {
+  for (size_t i = 0; i < BENCH_POOL_SIZE; i++) {
+    gFloatA[i] = BenchRandom(-10.0f, 10.0f);
+    gFloatB[i] = BenchRandom(-10.0f, 10.0f);
+    gFactor[i] = BenchRandom(0.0f, 1.0f);
+    gVec2A[i] = (Vec2){BenchRandom(-1.0f, 1.0f), BenchRandom(-1.0f, 1.0f)};
+    gVec2B[i] = (Vec2){BenchRandom(-1.0f, 1.0f), BenchRandom(-1.0f, 1.0f)};
+    gVec3A[i] = BenchRandomVec3(-1.0f, 1.0f);
+    gVec3B[i] = BenchRandomVec3(-1.0f, 1.0f);
+    gVec3C[i] = Vec3Norm(BenchRandomVec3(-1.0f, 1.0f));
+    gVec4A[i] = (Vec4){BenchRandom(-1.0f, 1.0f), BenchRandom(-1.0f, 1.0f),
+                       BenchRandom(-1.0f, 1.0f), BenchRandom(-1.0f, 1.0f)};
+    gVec4B[i] = (Vec4){BenchRandom(-1.0f, 1.0f), BenchRandom(-1.0f, 1.0f),
+                       BenchRandom(-1.0f, 1.0f), BenchRandom(-1.0f, 1.0f)};
+    gTransformA[i] = BenchRandomTransform();
+    gTransformB[i] = BenchRandomTransform();
+    gQuatA[i] = gTransformA[i].rotation;
+    gQuatB[i] = gTransformB[i].rotation;
+    gMat4A[i] = TransformToMat4(gTransformA[i]);
+    gMat4B[i] = TransformToMat4(gTransformB[i]);
+    gMat3A[i] = Mat4ToMat3(gMat4A[i]);
+    gMat3B[i] = Mat4ToMat3(gMat4B[i]);
+    gAffineA[i] = TransformToAffine34(gTransformA[i]);
+    gAffineB[i] = TransformToAffine34(gTransformB[i]);
+    gDualQuatA[i] = TransformToDualQuat(gTransformA[i]);
+    gDualQuatB[i] = TransformToDualQuat(gTransformB[i]);
+    gBeizer[i] = (BeizerCurve){
+        .p1 = BenchRandomVec3(-10.0f, 10.0f),
+        .c1 = BenchRandomVec3(-10.0f, 10.0f),
+        .p2 = BenchRandomVec3(-10.0f, 10.0f),
+        .c2 = BenchRandomVec3(-10.0f, 10.0f),
+    };
+    gHermit[i] = (HermitCurve){
+        .p1 = BenchRandomVec3(-10.0f, 10.0f),
+        .s1 = BenchRandomVec3(-10.0f, 10.0f),
+        .p2 = BenchRandomVec3(-10.0f, 10.0f),
+        .s2 = BenchRandomVec3(-10.0f, 10.0f),
+    };
+    BeizerArcTableMake(&gArcTables[i], gBeizer[i]);
+    gArcDistances[i] = gFactor[i] * BeizerArcLength(&gArcTables[i]);
+  }
+
+  if (!Vec3SoAMake(&gSoAA, BENCH_POOL_SIZE) ||
+      !Vec3SoAMake(&gSoAB, BENCH_POOL_SIZE) ||
+      !Vec3SoAMake(&gSoAR, BENCH_POOL_SIZE)) {
+    return false;
+  }
+  Vec3SoAFromArray(&gSoAA, gVec3A, BENCH_POOL_SIZE);
+  Vec3SoAFromArray(&gSoAB, gVec3B, BENCH_POOL_SIZE);
+
+  // Random bones of the first BENCH_BONES matrices, weights add up to one.
+  for (size_t i = 0; i < BENCH_POOL_SIZE * XMATH_SKIN_INFLUENCES; i++) {
+    gJoints[i] = (uint16_t)BenchRandom(0.0f, (float)BENCH_BONES);
+    gWeights[i] = BenchRandom(0.0f, 1.0f);
+  }
+  for (size_t i = 0; i < BENCH_POOL_SIZE; i++) {
+    float* w = gWeights + i * XMATH_SKIN_INFLUENCES;
+    float sum = w[0] + w[1] + w[2] + w[3];
+    for (size_t k = 0; k < XMATH_SKIN_INFLUENCES; k++) {
+      w[k] /= sum;
+    }
+  }
+  gSkinMesh = (SkinMesh){
+      .positions = gVec3A,
+      .normals = gVec3C,
+      .joints = gJoints,
+      .weights = gWeights,
+      .outPositions = gSkinPositions,
+      .outNormals = gSkinNormals,
+      .count = BENCH_POOL_SIZE,
+  };
+
+  for (size_t k = 0; k < BENCH_KEYS; k++) {
+    gClipTimes[k] = (float)k / 30.0f;
+  }
+  for (size_t i = 0; i < BENCH_POOL_SIZE; i++) {
+    for (size_t k = 0; k < BENCH_KEYS; k++) {
+      gClipKeys[i][k] = BenchRandomTransform();
+    }
+    gClipTracks[i] = (ClipTrack){gClipTimes, gClipKeys[i], BENCH_KEYS};
+  }
+  gClip = (Clip){gClipTracks, BENCH_POOL_SIZE};
+  if (!ClipCursorMake(&gClipCursor, BENCH_POOL_SIZE)) {
+    return false;
+  }
+
+  // Layers alternate the A and B transforms, weights add up to one.
+  for (size_t l = 0; l < BENCH_LAYERS; l++) {
+    if (!PoseSoAMake(&gPoseIn[l], BENCH_POOL_SIZE)) {
+      return false;
+    }
+    PoseSoAFromArray(&gPoseIn[l], l % 2 == 0 ? gTransformA : gTransformB,
+                     BENCH_POOL_SIZE);
+    gPoseLayers[l] = (PoseLayer){&gPoseIn[l], NULL, 0.1f * (float)(l + 1)};
+  }
+  if (!PoseSoAMake(&gPoseOut, BENCH_POOL_SIZE)) {
+    return false;
+  }
+
+  // Four children per node, node 0 is the only root.
+  if (!HierarchyMake(&gHierarchy, BENCH_POOL_SIZE)) {
+    return false;
+  }
+  for (size_t i = 0; i < BENCH_POOL_SIZE; i++) {
+    uint32_t parent = i == 0 ? XMATH_HIERARCHY_NONE : (uint32_t)(i - 1) / 4;
+    HierarchyAdd(&gHierarchy, parent, gTransformA[i]);
+  }
+  if (!ThreadPoolMake(&gPool, ThreadPoolHardwareThreads() - 1)) {
+    return false;
+  }
+
+  if (!SplineMake(&gSpline, BENCH_SEGMENTS)) {
+    return false;
+  }
+  for (size_t i = 0; i < BENCH_SEGMENTS; i++) {
+    float duration = BenchRandom(0.5f, 2.0f);
+    gSplineCurves[i] = gHermit[i];
+    gSplineKnots[i + 1] = gSplineKnots[i] + duration;
+    SplineAppendHermit(&gSpline, gSplineCurves[i], duration);
+  }
+  for (size_t i = 0; i < BENCH_POOL_SIZE; i++) {
+    gSplineParams[i] = gFactor[i] * SplineDuration(&gSpline);
+  }
+
+  for (size_t i = 0; i < BENCH_PACKETS; i++) {
+    size_t first = i * XMATH_PACKET_WIDTH;
+    Vec3x8Load(&gVec3x8A[i], gVec3A + first);
+    Vec3x8Load(&gVec3x8B[i], gVec3B + first);
+    Vec4x8Load(&gVec4x8[i], gVec4A + first);
+    Quatx8Load(&gQuatx8A[i], gQuatA + first);
+    Quatx8Load(&gQuatx8B[i], gQuatB + first);
+    Mat4x8Load(&gMat4x8[i], gMat4A + first);
+  }
+  return true;
+}
+
+/**
+ * Defines the scalar and batch runners of a benchmark, expr is evaluated with
+ * `i` as the index of the current input within the pools.
+ */
+#define BENCH(name, type, expr)                           \
+  static volatile type gSink_##name;                      \
+  static void BenchScalar_##name(size_t iters) {          \
+    for (size_t n = 0; n < iters; n++) {                  \
+      size_t i = n & BENCH_POOL_MASK;                     \
+      gSink_##name = (expr);                              \
+    }                                                     \
+  }                                                       \
+  static void BenchBatch_##name(size_t iters) {           \
+    static type out[BENCH_POOL_SIZE];                     \
+    for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) { \
+      for (size_t i = 0; i < BENCH_POOL_SIZE; i++) {      \
+        out[i] = (expr);                                  \
+      }                                                   \
+      gEscape = out;                                      \
+    }                                                     \
+  }
+
+/**
+ * Defines the runners of a benchmark over a `...To` API, call is evaluated
+ * with `i` as the index of the current input and `out` as its output slot.
+ */
+#define BENCH_TO(name, type, call)                        \
+  static type gOut_##name[BENCH_POOL_SIZE];               \
+  static void BenchScalar_##name(size_t iters) {          \
+    for (size_t n = 0; n < iters; n++) {                  \
+      size_t i = n & BENCH_POOL_MASK;                     \
+      type* out = &gOut_##name[i];                        \
+      call;                                               \
+    }                                                     \
+    gEscape = gOut_##name;                                \
+  }                                                       \
+  static void BenchBatch_##name(size_t iters) {           \
+    for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) { \
+      for (size_t i = 0; i < BENCH_POOL_SIZE; i++) {      \
+        type* out = &gOut_##name[i];                      \
+        call;                                             \
+      }                                                   \
+      gEscape = gOut_##name;                              \
+    }                                                     \
+  }
+
+/**
+ * Defines the runners of a benchmark over an array API, call is evaluated with
+ * `out` as the output pool, `i` as the first element and `c` as the count.
+ * The scalar form passes one element per call, the batch form the whole pool.
+ */
+#define BENCH_ARRAY(name, type, call)                     \
+  static type gOut_##name[BENCH_POOL_SIZE];               \
+  static void BenchScalar_##name(size_t iters) {          \
+    type* out = gOut_##name;                              \
+    size_t c = 1;                                         \
+    for (size_t n = 0; n < iters; n++) {                  \
+      size_t i = n & BENCH_POOL_MASK;                     \
+      call;                                               \
+    }                                                     \
+    gEscape = out;                                        \
+  }                                                       \
+  static void BenchBatch_##name(size_t iters) {           \
+    type* out = gOut_##name;                              \
+    size_t c = BENCH_POOL_SIZE;                           \
+    for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) { \
+      size_t i = 0;                                       \
+      call;                                               \
+      gEscape = out;                                      \
+    }                                                     \
+  }
+
+/**
+ * Defines the runners of a benchmark over Vec3SoA streams, call is evaluated
+ * with `a`, `b` and `r` as views of the stream pools and `dots` as a float
+ * output. The scalar form passes views of one element, the batch form views
+ * of the whole pool.
+ */
+#define BENCH_SOA(name, call)                                          \
+  static void BenchScalar_##name(size_t iters) {                       \
+    for (size_t n = 0; n < iters; n++) {                               \
+      size_t i = n & BENCH_POOL_MASK & ~(size_t)(XMATH_SOA_WIDTH - 1); \
+      Vec3SoA a = BenchSoAView(&gSoAA, i, 1);                          \
+      Vec3SoA b = BenchSoAView(&gSoAB, i, 1);                          \
+      Vec3SoA r = BenchSoAView(&gSoAR, i, 1);                          \
+      float* dots = gSoADot + i;                                       \
+      (void)a, (void)b, (void)r, (void)dots;                           \
+      call;                                                            \
+    }                                                                  \
+    gEscape = gSoAR.x;                                                 \
+  }                                                                    \
+  static void BenchBatch_##name(size_t iters) {                        \
+    for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) {              \
+      Vec3SoA a = BenchSoAView(&gSoAA, 0, BENCH_POOL_SIZE);            \
+      Vec3SoA b = BenchSoAView(&gSoAB, 0, BENCH_POOL_SIZE);            \
+      Vec3SoA r = BenchSoAView(&gSoAR, 0, BENCH_POOL_SIZE);            \
+      float* dots = gSoADot;                                           \
+      (void)a, (void)b, (void)r, (void)dots;                           \
+      call;                                                            \
+      gEscape = gSoAR.x;                                               \
+    }                                                                  \
+  }
+
+/**
+ * Defines the runners of a benchmark over packets, call is evaluated with
+ * `out` as the output packets and `i` as the index of the current packet.
+ * Every packet counts as XMATH_PACKET_WIDTH operations. The scalar form
+ * walks the packets in a single loop, the batch form in passes over the pool.
+ */
+#define BENCH_PACKET(name, type, call)                            \
+  static type gOut_##name[BENCH_PACKETS];                         \
+  static void BenchScalar_##name(size_t iters) {                  \
+    type* out = gOut_##name;                                      \
+    for (size_t n = 0; n < iters; n += XMATH_PACKET_WIDTH) {      \
+      size_t i = (n / XMATH_PACKET_WIDTH) & (BENCH_PACKETS - 1);  \
+      call;                                                       \
+    }                                                             \
+    gEscape = out;                                                \
+  }                                                               \
+  static void BenchBatch_##name(size_t iters) {                   \
+    type* out = gOut_##name;                                      \
+    for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) {         \
+      for (size_t i = 0; i < BENCH_PACKETS; i++) {                \
+        call;                                                     \
+      }                                                           \
+      gEscape = out;                                              \
+    }                                                             \
+  }
+
+// scalar.h
+BENCH(FEqualApprox, bool, FEqualApprox(gFloatA[i], gFloatB[i]))
+BENCH(FMax, float, FMax(gFloatA[i], gFloatB[i]))
+BENCH(FMin, float, FMin(gFloatA[i], gFloatB[i]))
+BENCH(FLerp, float, FLerp(gFloatA[i], gFloatB[i], gFactor[i]))
+BENCH(FRemap, float, FRemap(gFloatA[i], -10.0f, 10.0f, 0.0f, 1.0f))
+BENCH(FRad2Deg, float, FRad2Deg(gFloatA[i]))
+BENCH(FDeg2Rad, float, FDeg2Rad(gFloatA[i]))
+
+// vec2.h
+BENCH(Vec2Floats, FloatPtr, Vec2Floats(&gVec2A[i]))
+BENCH(Vec2EqualApprox, bool, Vec2EqualApprox(gVec2A[i], gVec2B[i]))
+BENCH(Vec2Add, Vec2, Vec2Add(gVec2A[i], gVec2B[i]))
+BENCH(Vec2Sub, Vec2, Vec2Sub(gVec2A[i], gVec2B[i]))
+BENCH(Vec2Scale, Vec2, Vec2Scale(gVec2A[i], gFloatA[i]))
+BENCH(Vec2SqrLen, float, Vec2SqrLen(gVec2A[i]))
+BENCH(Vec2Len, float, Vec2Len(gVec2A[i]))
+BENCH(Vec2Norm, Vec2, Vec2Norm(gVec2A[i]))
+BENCH(Vec2Max, Vec2, Vec2Max(gVec2A[i], gVec2B[i]))
+BENCH(Vec2Min, Vec2, Vec2Min(gVec2A[i], gVec2B[i]))
+
+// vec3.h
+BENCH(Vec3Floats, FloatPtr, Vec3Floats(&gVec3A[i]))
+BENCH(Vec3EqualApprox, bool, Vec3EqualApprox(gVec3A[i], gVec3B[i]))
+BENCH(Vec3Add, Vec3, Vec3Add(gVec3A[i], gVec3B[i]))
+BENCH(Vec3Sub, Vec3, Vec3Sub(gVec3A[i], gVec3B[i]))
+BENCH(Vec3InnerMul, Vec3, Vec3InnerMul(gVec3A[i], gVec3B[i]))
+BENCH(Vec3Scale, Vec3, Vec3Scale(gVec3A[i], gFloatA[i]))
+BENCH(Vec3SqrLen, float, Vec3SqrLen(gVec3A[i]))
+BENCH(Vec3Len, float, Vec3Len(gVec3A[i]))
+BENCH(Vec3Norm, Vec3, Vec3Norm(gVec3A[i]))
+BENCH(Vec3Orthonormalize, Vec3, Vec3Orthonormalize(gVec3A[i], gVec3C[i]))
+BENCH(Vec3Max, Vec3, Vec3Max(gVec3A[i], gVec3B[i]))
+BENCH(Vec3Min, Vec3, Vec3Min(gVec3A[i], gVec3B[i]))
+BENCH(Vec3Angle, float, Vec3Angle(gVec3A[i], gVec3B[i]))
+BENCH(Vec3Dot, float, Vec3Dot(gVec3A[i], gVec3B[i]))
+BENCH(Vec3Cross, Vec3, Vec3Cross(gVec3A[i], gVec3B[i]))
+BENCH(Vec3Project, Vec3, Vec3Project(gVec3A[i], gVec3B[i]))
+BENCH(Vec3Reject, Vec3, Vec3Reject(gVec3A[i], gVec3B[i]))
+BENCH(Vec3Reflect, Vec3, Vec3Reflect(gVec3A[i], gVec3B[i]))
+BENCH(Vec3Lerp, Vec3, Vec3Lerp(gVec3A[i], gVec3B[i], gFactor[i]))
+BENCH(Vec3Slerp, Vec3, Vec3Slerp(gVec3A[i], gVec3B[i], gFactor[i]))
+BENCH(Vec3Nlerp, Vec3, Vec3Nlerp(gVec3A[i], gVec3B[i], gFactor[i]))
+
+// vec4.h
+BENCH(Vec4Floats, FloatPtr, Vec4Floats(&gVec4A[i]))
+BENCH(Vec4EqualApprox, bool, Vec4EqualApprox(gVec4A[i], gVec4B[i]))
+BENCH(Vec4Add, Vec4, Vec4Add(gVec4A[i], gVec4B[i]))
+BENCH(Vec4Sub, Vec4, Vec4Sub(gVec4A[i], gVec4B[i]))
+BENCH(Vec4Scale, Vec4, Vec4Scale(gVec4A[i], gFloatA[i]))
+BENCH(Vec4SqrLen, float, Vec4SqrLen(gVec4A[i]))
+BENCH(Vec4Len, float, Vec4Len(gVec4A[i]))
+BENCH(Vec4Norm, Vec4, Vec4Norm(gVec4A[i]))
+BENCH(Vec4Max, Vec4, Vec4Max(gVec4A[i], gVec4B[i]))
+BENCH(Vec4Min, Vec4, Vec4Min(gVec4A[i], gVec4B[i]))
+BENCH(Vec4Angle, float, Vec4Angle(gVec4A[i], gVec4B[i]))
+BENCH(Vec4Dot, float, Vec4Dot(gVec4A[i], gVec4B[i]))
+BENCH(Vec4Project, Vec4, Vec4Project(gVec4A[i], gVec4B[i]))
+BENCH(Vec4Reject, Vec4, Vec4Reject(gVec4A[i], gVec4B[i]))
+BENCH(Vec4Reflect, Vec4, Vec4Reflect(gVec4A[i], gVec4B[i]))
+BENCH(Vec4Lerp, Vec4, Vec4Lerp(gVec4A[i], gVec4B[i], gFactor[i]))
+BENCH(Vec4Slerp, Vec4, Vec4Slerp(gVec4A[i], gVec4B[i], gFactor[i]))
+BENCH(Vec4Nlerp, Vec4, Vec4Nlerp(gVec4A[i], gVec4B[i], gFactor[i]))
+
+// vec3soa.h
+BENCH_SOA(Vec3SoAAdd, Vec3SoAAdd(&r, &a, &b))
+BENCH_SOA(Vec3SoAScale, Vec3SoAScale(&r, &a, 2.0f))
+BENCH_SOA(Vec3SoADot, Vec3SoADot(dots, &a, &b))
+BENCH_SOA(Vec3SoACross, Vec3SoACross(&r, &a, &b))
+BENCH_SOA(Vec3SoANorm, Vec3SoANorm(&r, &a))
+BENCH_SOA(Vec3SoALerp, Vec3SoALerp(&r, &a, &b, 0.25f))
+
+// mat4.h
+BENCH(Mat4Floats, FloatPtr, Mat4Floats(&gMat4A[i]))
+BENCH(Mat4EqualApprox, bool, Mat4EqualApprox(gMat4A[i], gMat4B[i]))
+BENCH(Mat4Row, Vec4, Mat4Row(gMat4A[i], (unsigned)(i & 3)))
+BENCH(Mat4Col, Vec4, Mat4Col(gMat4A[i], (unsigned)(i & 3)))
+BENCH(Mat4Transpose, Mat4, Mat4Transpose(gMat4A[i]))
+BENCH_TO(Mat4TransposeTo, Mat4, Mat4TransposeTo(out, &gMat4A[i]))
+BENCH(Mat4Invert, bool, Mat4Invert(&gMat4Out, gMat4A[i]))
+BENCH(Mat4Classify, Mat4Class, Mat4Classify(&gMat4A[i]))
+BENCH_TO(Mat4InvertAffine, Mat4, Mat4InvertAffine(out, &gMat4A[i]))
+BENCH_TO(Mat4InvertRigid, Mat4, Mat4InvertRigid(out, &gMat4A[i]))
+BENCH_TO(Mat4InvertFast, Mat4, Mat4InvertFast(out, &gMat4A[i]))
+BENCH_ARRAY(Mat4InvertArray,
+            Mat4,
+            Mat4InvertArray(out + i, gMat4A + i, NULL, c))
+BENCH(Mat4Add, Mat4, Mat4Add(gMat4A[i], gMat4B[i]))
+BENCH_TO(Mat4AddTo, Mat4, Mat4AddTo(out, &gMat4A[i], &gMat4B[i]))
+BENCH(Mat4Sub, Mat4, Mat4Sub(gMat4A[i], gMat4B[i]))
+BENCH_TO(Mat4SubTo, Mat4, Mat4SubTo(out, &gMat4A[i], &gMat4B[i]))
+BENCH(Mat4Scale, Mat4, Mat4Scale(gMat4A[i], gFloatA[i]))
+BENCH_TO(Mat4ScaleTo, Mat4, Mat4ScaleTo(out, &gMat4A[i], gFloatA[i]))
+BENCH(Mat4Mul, Mat4, Mat4Mul(gMat4A[i], gMat4B[i]))
+BENCH_TO(Mat4MulTo, Mat4, Mat4MulTo(out, &gMat4A[i], &gMat4B[i]))
+BENCH(Mat4MulVec4, Vec4, Mat4MulVec4(gMat4A[i], gVec4A[i]))
+BENCH_TO(Mat4MulVec4To, Vec4, Mat4MulVec4To(out, &gMat4A[i], &gVec4A[i]))
+BENCH_ARRAY(Mat4MulVec4Array,
+            Vec4,
+            Mat4MulVec4Array(out + i, &gMat4A[0], gVec4A + i, c))
+BENCH_ARRAY(Mat4MulPoint3Array,
+            Vec3,
+            Mat4MulPoint3Array(out + i, &gMat4A[0], gVec3A + i, c))
+BENCH_ARRAY(Mat4MulDir3Array,
+            Vec3,
+            Mat4MulDir3Array(out + i, &gMat4A[0], gVec3A + i, c))
+BENCH_ARRAY(Mat4MulVec4Strided,
+            Vec4,
+            Mat4MulVec4Strided(out + i, sizeof(Vec4), &gMat4A[0], gVec4A + i,
+                               sizeof(Vec4), c))
+BENCH(Mat4MakeOrtho,
+      Mat4,
+      Mat4MakeOrtho(-1.0f, 1.0f, -1.0f, 1.0f, 0.1f, 100.0f + gFactor[i]))
+BENCH(Mat4MakePerspective,
+      Mat4,
+      Mat4MakePerspective(60.0f + gFactor[i], 1.77f, 0.1f, 100.0f))
+BENCH(Mat4LookAt, Mat4, Mat4LookAt(gVec3A[i], gVec3B[i], Vec3Up))
+
+// quat.h
+BENCH(QuatFloats, FloatPtr, QuatFloats(&gQuatA[i]))
+BENCH(QuatMakeAngleAxis, Quat, QuatMakeAngleAxis(gFloatA[i], gVec3A[i]))
+BENCH(QuatMakeFromTo, Quat, QuatMakeFromTo(gVec3C[i], gVec3C[i ^ 1]))
+BENCH(QuatGetAxis, Vec3, QuatGetAxis(gQuatA[i]))
+BENCH(QuatGetAngle, float, QuatGetAngle(gQuatA[i]))
+BENCH(QuatGetImgPart, Vec3, QuatGetImgPart(gQuatA[i]))
+BENCH(QuatGetRealPart, float, QuatGetRealPart(gQuatA[i]))
+BENCH(QuatEqualApprox, bool, QuatEqualApprox(gQuatA[i], gQuatB[i]))
+BENCH(QuatAdd, Quat, QuatAdd(gQuatA[i], gQuatB[i]))
+BENCH(QuatSub, Quat, QuatSub(gQuatA[i], gQuatB[i]))
+BENCH(QuatScale, Quat, QuatScale(gQuatA[i], gFloatA[i]))
+BENCH(QuatNeg, Quat, QuatNeg(gQuatA[i]))
+BENCH(QuatSameOrientation, bool, QuatSameOrientation(gQuatA[i], gQuatB[i]))
+BENCH(QuatDot, float, QuatDot(gQuatA[i], gQuatB[i]))
+BENCH(QuatSqrLen, float, QuatSqrLen(gQuatA[i]))
+BENCH(QuatLen, float, QuatLen(gQuatA[i]))
+BENCH(QuatNorm, Quat, QuatNorm(gQuatA[i]))
+BENCH(QuatConjugate, Quat, QuatConjugate(gQuatA[i]))
+BENCH(QuatInvert, Quat, QuatInvert(gQuatA[i]))
+BENCH(QuatCross, Quat, QuatCross(gQuatA[i], gQuatB[i]))
+BENCH(QuatTransformVec3, Vec3, QuatTransformVec3(gQuatA[i], gVec3A[i]))
+BENCH_ARRAY(QuatTransformVec3Strided,
+            Vec3,
+            QuatTransformVec3Strided(out + i, sizeof(Vec3), gQuatA[0],
+                                     gVec3A + i, sizeof(Vec3), c))
+BENCH_ARRAY(QuatTransformVec3Array,
+            Vec3,
+            QuatTransformVec3Array(out + i, gQuatA[0], gVec3A + i, c))
+BENCH_ARRAY(QuatTransformVec3Pairwise,
+            Vec3,
+            QuatTransformVec3Pairwise(out + i, gQuatA + i, gVec3A + i, c))
+BENCH(QuatLerp, Quat, QuatLerp(gQuatA[i], gQuatB[i], gFactor[i]))
+BENCH(QuatNLerp, Quat, QuatNLerp(gQuatA[i], gQuatB[i], gFactor[i]))
+BENCH(QuatSLerp, Quat, QuatSLerp(gQuatA[i], gQuatB[i], gFactor[i]))
+BENCH(QuatLookRotation, Quat, QuatLookRotation(gVec3C[i], Vec3Up))
+BENCH(QuatToMat4, Mat4, QuatToMat4(gQuatA[i]))
+BENCH(Mat4ToQuat, Quat, Mat4ToQuat(gMat4A[i]))
+
+// transform.h
+BENCH(TransformEqualApprox,
+      bool,
+      TransformEqualApprox(gTransformA[i], gTransformB[i]))
+BENCH(TransformCombine,
+      Transform,
+      TransformCombine(gTransformA[i], gTransformB[i]))
+BENCH_TO(TransformCombineTo,
+         Transform,
+         TransformCombineTo(out, &gTransformA[i], &gTransformB[i]))
+BENCH(TransformInverse, Transform, TransformInverse(gTransformA[i]))
+BENCH_TO(TransformInverseTo,
+         Transform,
+         TransformInverseTo(out, &gTransformA[i]))
+BENCH(TransformLerp,
+      Transform,
+      TransformLerp(gTransformA[i], gTransformB[i], gFactor[i]))
+BENCH(TransformToMat4, Mat4, TransformToMat4(gTransformA[i]))
+BENCH_TO(TransformToMat4To, Mat4, TransformToMat4To(out, &gTransformA[i]))
+BENCH(Mat4ToTransform, Transform, Mat4ToTransform(gMat4A[i]))
+BENCH(TransformPoint, Vec3, TransformPoint(gTransformA[i], gVec3A[i]))
+BENCH(TransformVec3, Vec3, TransformVec3(gTransformA[i], gVec3A[i]))
+BENCH_ARRAY(TransformPointStrided,
+            Vec3,
+            TransformPointStrided(out + i, sizeof(Vec3), &gTransformA[0],
+                                  gVec3A + i, sizeof(Vec3), c))
+BENCH_ARRAY(TransformVec3Strided,
+            Vec3,
+            TransformVec3Strided(out + i, sizeof(Vec3), &gTransformA[0],
+                                 gVec3A + i, sizeof(Vec3), c))
+BENCH_ARRAY(TransformPointArray,
+            Vec3,
+            TransformPointArray(out + i, &gTransformA[0], gVec3A + i, c))
+BENCH_ARRAY(TransformVec3Array,
+            Vec3,
+            TransformVec3Array(out + i, &gTransformA[0], gVec3A + i, c))
+BENCH_SOA(TransformPointArrayToSoA,
+          TransformPointArrayToSoA(&r, &gTransformA[0], gVec3A, r.count))
+
+// mat3.h
+BENCH(Mat3Invert, bool, Mat3Invert(&gMat3B[i], gMat3A[i]))
+BENCH(Mat3Mul, Mat3, Mat3Mul(gMat3A[i], gMat3B[i]))
+BENCH_TO(Mat3MulTo, Mat3, Mat3MulTo(out, &gMat3A[i], &gMat3B[i]))
+BENCH(Mat3TransformVec3, Vec3, Mat3TransformVec3(gMat3A[i], gVec3A[i]))
+BENCH_ARRAY(Mat3TransformVec3Array,
+            Vec3,
+            Mat3TransformVec3Array(out + i, &gMat3A[0], gVec3A + i, c))
+BENCH(QuatToMat3, Mat3, QuatToMat3(gQuatA[i]))
+
+// affine34.h
+BENCH(Affine34Mul, Affine34, Affine34Mul(gAffineA[i], gAffineB[i]))
+BENCH_TO(Affine34MulTo,
+         Affine34,
+         Affine34MulTo(out, &gAffineA[i], &gAffineB[i]))
+BENCH_TO(Affine34Invert, Affine34, Affine34Invert(out, &gAffineA[i]))
+BENCH(Affine34TransformPoint,
+      Vec3,
+      Affine34TransformPoint(gAffineA[i], gVec3A[i]))
+BENCH_ARRAY(Affine34TransformPointArray,
+            Vec3,
+            Affine34TransformPointArray(out + i, &gAffineA[0], gVec3A + i, c))
+BENCH(TransformToAffine34, Affine34, TransformToAffine34(gTransformA[i]))
+BENCH_ARRAY(TransformToAffine34Array,
+            Affine34,
+            TransformToAffine34Array(out + i, gTransformA + i, c))
+
+// dualquat.h
+BENCH(DualQuatMul, DualQuat, DualQuatMul(gDualQuatA[i], gDualQuatB[i]))
+BENCH(DualQuatNorm, DualQuat, DualQuatNorm(gDualQuatA[i]))
+BENCH(DualQuatBlend,
+      DualQuat,
+      DualQuatBlend(gDualQuatA + (i & ~(size_t)3), gFactor + (i & ~(size_t)3),
+                    4))
+BENCH(DualQuatTransformPoint,
+      Vec3,
+      DualQuatTransformPoint(gDualQuatA[i], gVec3A[i]))
+
+// packet.h
+BENCH_PACKET(Vec3x8Cross,
+             Vec3x8,
+             Vec3x8Cross(out + i, &gVec3x8A[i], &gVec3x8B[i]))
+BENCH_PACKET(Quatx8Cross,
+             Quatx8,
+             Quatx8Cross(out + i, &gQuatx8A[i], &gQuatx8B[i]))
+BENCH_PACKET(Quatx8TransformVec3x8,
+             Vec3x8,
+             Quatx8TransformVec3x8(out + i, &gQuatx8A[i], &gVec3x8A[i]))
+BENCH_PACKET(Mat4x8MulVec4x8,
+             Vec4x8,
+             Mat4x8MulVec4x8(out + i, &gMat4x8[i], &gVec4x8[i]))
+
+// hierarchy.h
+// The scalar form moves one node per update, the batch form the root so the
+// whole pool is recomputed.
+static void BenchScalar_HierarchyUpdate(size_t iters) {
+  for (size_t n = 0; n < iters; n++) {
+    HierarchyMarkDirty(&gHierarchy, (uint32_t)(n & BENCH_POOL_MASK));
+    HierarchyUpdate(&gHierarchy);
+  }
+  gEscape = gHierarchy.worldMatrix;
+}
+
+static void BenchBatch_HierarchyUpdate(size_t iters) {
+  for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) {
+    HierarchyMarkDirty(&gHierarchy, 0);
+    HierarchyUpdate(&gHierarchy);
+    gEscape = gHierarchy.worldMatrix;
+  }
+}
+
+static void BenchScalar_HierarchyUpdateParallel(size_t iters) {
+  for (size_t n = 0; n < iters; n++) {
+    HierarchyMarkDirty(&gHierarchy, (uint32_t)(n & BENCH_POOL_MASK));
+    HierarchyUpdateParallel(&gHierarchy, &gPool);
+  }
+  gEscape = gHierarchy.worldMatrix;
+}
+
+static void BenchBatch_HierarchyUpdateParallel(size_t iters) {
+  for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) {
+    HierarchyMarkDirty(&gHierarchy, 0);
+    HierarchyUpdateParallel(&gHierarchy, &gPool);
+    gEscape = gHierarchy.worldMatrix;
+  }
+}
+
+// skinning.h
+// The scalar form is the per influence loop over the rows of the matrices,
+// one vertex at a time; the batch forms skin the whole pool.
+static void BenchScalar_SkinLinearMat4(size_t iters) {
+  for (size_t n = 0; n < iters; n++) {
+    size_t i = n & BENCH_POOL_MASK;
+    Vec3 p = gVec3A[i];
+    Vec3 u = gVec3C[i];
+    Vec4 rp = {0};
+    Vec4 rn = {0};
+    for (size_t k = 0; k < XMATH_SKIN_INFLUENCES; k++) {
+      const Mat4* m = &gMat4A[gJoints[i * XMATH_SKIN_INFLUENCES + k]];
+      float w = gWeights[i * XMATH_SKIN_INFLUENCES + k];
+      Vec4 x = {m->xx, m->xy, m->xz, m->xw};
+      Vec4 y = {m->yx, m->yy, m->yz, m->yw};
+      Vec4 z = {m->zx, m->zy, m->zz, m->zw};
+      Vec4 t = {m->wx, m->wy, m->wz, m->ww};
+      Vec4 mp = Vec4Add(Vec4Add(Vec4Scale(x, p.x), Vec4Scale(y, p.y)),
+                        Vec4Add(Vec4Scale(z, p.z), t));
+      Vec4 mn = Vec4Add(Vec4Add(Vec4Scale(x, u.x), Vec4Scale(y, u.y)),
+                        Vec4Scale(z, u.z));
+      rp = Vec4Add(rp, Vec4Scale(mp, w));
+      rn = Vec4Add(rn, Vec4Scale(mn, w));
+    }
+    gSkinPositions[i] = (Vec3){rp.x, rp.y, rp.z};
+    gSkinNormals[i] = (Vec3){rn.x, rn.y, rn.z};
+  }
+  gEscape = gSkinPositions;
+}
+
+static void BenchBatch_SkinLinearMat4(size_t iters) {
+  for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) {
+    SkinLinearMat4(&gSkinMesh, gMat4A, 0, BENCH_POOL_SIZE);
+    gEscape = gSkinPositions;
+  }
+}
+
+static void BenchScalar_SkinLinearAffine34(size_t iters) {
+  BenchScalar_SkinLinearMat4(iters);
+}
+
+static void BenchBatch_SkinLinearAffine34(size_t iters) {
+  for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) {
+    SkinLinearAffine34(&gSkinMesh, gAffineA, 0, BENCH_POOL_SIZE);
+    gEscape = gSkinPositions;
+  }
+}
+
+// The scalar form blends and maps one vertex at a time.
+static void BenchScalar_SkinDualQuat(size_t iters) {
+  for (size_t n = 0; n < iters; n++) {
+    size_t i = n & BENCH_POOL_MASK;
+    DualQuat bones[XMATH_SKIN_INFLUENCES];
+    for (size_t k = 0; k < XMATH_SKIN_INFLUENCES; k++) {
+      bones[k] = gDualQuatA[gJoints[i * XMATH_SKIN_INFLUENCES + k]];
+    }
+    DualQuat dq = DualQuatBlend(bones, gWeights + i * XMATH_SKIN_INFLUENCES,
+                                XMATH_SKIN_INFLUENCES);
+    gSkinPositions[i] = DualQuatTransformPoint(dq, gVec3A[i]);
+    gSkinNormals[i] = DualQuatTransformVec3(dq, gVec3C[i]);
+  }
+  gEscape = gSkinPositions;
+}
+
+static void BenchBatch_SkinDualQuat(size_t iters) {
+  for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) {
+    SkinDualQuat(&gSkinMesh, gDualQuatA, 0, BENCH_POOL_SIZE);
+    gEscape = gSkinPositions;
+  }
+}
+
+// animation.h
+// Both forms play the clip at 60 Hz, looping; the scalar form finds the keys
+// of each joint with a binary search and calls TransformLerp.
+static float BenchClipTime(size_t frame) {
+  return (float)(frame % (2 * (BENCH_KEYS - 1))) / 60.0f;
+}
+
+static void BenchScalar_ClipSample(size_t iters) {
+  for (size_t n = 0; n < iters; n++) {
+    size_t j = n & BENCH_POOL_MASK;
+    float time = BenchClipTime(n / BENCH_POOL_SIZE);
+    const ClipTrack* track = &gClipTracks[j];
+    uint32_t lo = 0;
+    uint32_t hi = track->count;
+    while (hi - lo > 1) {
+      uint32_t mid = (lo + hi) / 2;
+      if (track->times[mid] <= time) {
+        lo = mid;
+      } else {
+        hi = mid;
+      }
+    }
+    uint32_t next = lo + 1 < track->count ? lo + 1 : lo;
+    float f = next == lo ? 0.0f
+                         : (time - track->times[lo]) /
+                               (track->times[next] - track->times[lo]);
+    gPose[j] = TransformLerp(track->keys[lo], track->keys[next], f);
+  }
+  gEscape = gPose;
+}
+
+static void BenchBatch_ClipSample(size_t iters) {
+  for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) {
+    ClipSample(&gClip, &gClipCursor, BenchClipTime(n / BENCH_POOL_SIZE),
+               gPose);
+    gEscape = gPose;
+  }
+}
+
+// pose.h
+// The scalar form blends the layers of a joint with TransformLerp, folding
+// one layer at a time with its share of the weight so far.
+static void BenchScalar_PoseSoAMix(size_t iters) {
+  for (size_t n = 0; n < iters; n++) {
+    size_t i = n & BENCH_POOL_MASK;
+    Transform r = gTransformA[i];
+    float sum = gPoseLayers[0].weight;
+    for (size_t l = 1; l < BENCH_LAYERS; l++) {
+      float w = gPoseLayers[l].weight;
+      const Transform* in = l % 2 == 0 ? gTransformA : gTransformB;
+      sum += w;
+      r = TransformLerp(r, in[i], w / sum);
+    }
+    gPose[i] = r;
+  }
+  gEscape = gPose;
+}
+
+static void BenchBatch_PoseSoAMix(size_t iters) {
+  for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) {
+    PoseSoAMix(&gPoseOut, gPoseLayers, BENCH_LAYERS, NULL, 0);
+    gEscape = gPoseOut.px;
+  }
+}
+
+// curves.h
+BENCH(BeizerInterpolate, Vec3, BeizerInterpolate(gBeizer[i], gFactor[i]))
+BENCH(HermitInterpolate, Vec3, HermitInterpolate(gHermit[i], gFactor[i]))
+BENCH_ARRAY(BeizerInterpolateArray,
+            Vec3,
+            BeizerInterpolateArray(out + i, gBeizer + i, gFactor + i, c))
+BENCH_ARRAY(HermitInterpolateArray,
+            Vec3,
+            HermitInterpolateArray(out + i, gHermit + i, gFactor + i, c))
+
+// Both forms write one point of a curve per operation, the scalar form calls
+// the interpolation at every uniform step.
+static void BenchScalar_BeizerTessellate(size_t iters) {
+  float h = 1.0f / (float)(BENCH_POOL_SIZE - 1);
+  for (size_t n = 0; n < iters; n++) {
+    size_t i = n & BENCH_POOL_MASK;
+    gCurvePoints[i] = BeizerInterpolate(gBeizer[0], (float)i * h);
+  }
+  gEscape = gCurvePoints;
+}
+
+static void BenchBatch_BeizerTessellate(size_t iters) {
+  for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) {
+    BeizerTessellate(gCurvePoints, gBeizer[0], BENCH_POOL_SIZE);
+    gEscape = gCurvePoints;
+  }
+}
+
+static void BenchScalar_HermitTessellate(size_t iters) {
+  float h = 1.0f / (float)(BENCH_POOL_SIZE - 1);
+  for (size_t n = 0; n < iters; n++) {
+    size_t i = n & BENCH_POOL_MASK;
+    gCurvePoints[i] = HermitInterpolate(gHermit[0], (float)i * h);
+  }
+  gEscape = gCurvePoints;
+}
+
+static void BenchBatch_HermitTessellate(size_t iters) {
+  for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) {
+    HermitTessellate(gCurvePoints, gHermit[0], BENCH_POOL_SIZE);
+    gEscape = gCurvePoints;
+  }
+}
+
+// The scalar form walks a polyline of BENCH_ARC_SAMPLES points of the curve
+// until it covers the distance, as done without a table.
+#define BENCH_ARC_SAMPLES 64
+
+static void BenchScalar_BeizerArcParameter(size_t iters) {
+  for (size_t n = 0; n < iters; n++) {
+    size_t i = n & BENCH_POOL_MASK;
+    float left = gArcDistances[i];
+    float t = 1.0f;
+    Vec3 prev = gBeizer[i].p1;
+    for (unsigned k = 1; k <= BENCH_ARC_SAMPLES; k++) {
+      float tk = (float)k / (float)BENCH_ARC_SAMPLES;
+      Vec3 next = BeizerInterpolate(gBeizer[i], tk);
+      float len = Vec3Len(Vec3Sub(next, prev));
+      if (len >= left) {
+        t = tk - (1.0f - left / len) / (float)BENCH_ARC_SAMPLES;
+        break;
+      }
+      left -= len;
+      prev = next;
+    }
+    gArcParams[i] = t;
+  }
+  gEscape = gArcParams;
+}
+
+static void BenchBatch_BeizerArcParameter(size_t iters) {
+  for (size_t n = 0; n < iters; n++) {
+    size_t i = n & BENCH_POOL_MASK;
+    gArcParams[i] = BeizerArcParameter(&gArcTables[i], gBeizer[i],
+                                    gArcDistances[i]);
+  }
+  gEscape = gArcParams;
+}
+
+// spline.h
+// The scalar form walks the knots to the segment and calls HermitInterpolate,
+// the parameters are in random order so the batch form searches every time.
+static void BenchScalar_SplineEvaluate(size_t iters) {
+  for (size_t n = 0; n < iters; n++) {
+    size_t i = n & BENCH_POOL_MASK;
+    float u = gSplineParams[i];
+    size_t k = 0;
+    while (k + 1 < BENCH_SEGMENTS && gSplineKnots[k + 1] <= u) {
+      k++;
+    }
+    float t = (u - gSplineKnots[k]) / (gSplineKnots[k + 1] - gSplineKnots[k]);
+    gCurvePoints[i] = HermitInterpolate(gSplineCurves[k], t);
+  }
+  gEscape = gCurvePoints;
+}
+
+static void BenchBatch_SplineEvaluate(size_t iters) {
+  for (size_t n = 0; n < iters; n += BENCH_POOL_SIZE) {
+    SplineEvaluateArray(gCurvePoints, &gSpline, gSplineParams, BENCH_POOL_SIZE);
+    gEscape = gCurvePoints;
+  }
+}
+
+typedef void (*BenchFn)(size_t iters);
+
+typedef struct {
+  const char* name;
+  BenchFn scalar;
+  BenchFn batch;
+} BenchCase;
+
+#define BENCH_CASE(name) {#name, BenchScalar_##name, BenchBatch_##name}
+
+static const BenchCase gCases[] = {
+    BENCH_CASE(FEqualApprox),
+    BENCH_CASE(FMax),
+    BENCH_CASE(FMin),
+    BENCH_CASE(FLerp),
+    BENCH_CASE(FRemap),
+    BENCH_CASE(FRad2Deg),
+    BENCH_CASE(FDeg2Rad),
+    BENCH_CASE(Vec2Floats),
+    BENCH_CASE(Vec2EqualApprox),
+    BENCH_CASE(Vec2Add),
+    BENCH_CASE(Vec2Sub),
+    BENCH_CASE(Vec2Scale),
+    BENCH_CASE(Vec2SqrLen),
+    BENCH_CASE(Vec2Len),
+    BENCH_CASE(Vec2Norm),
+    BENCH_CASE(Vec2Max),
+    BENCH_CASE(Vec2Min),
+    BENCH_CASE(Vec3Floats),
+    BENCH_CASE(Vec3EqualApprox),
+    BENCH_CASE(Vec3Add),
+    BENCH_CASE(Vec3Sub),
+    BENCH_CASE(Vec3InnerMul),
+    BENCH_CASE(Vec3Scale),
+    BENCH_CASE(Vec3SqrLen),
+    BENCH_CASE(Vec3Len),
+    BENCH_CASE(Vec3Norm),
+    BENCH_CASE(Vec3Orthonormalize),
+    BENCH_CASE(Vec3Max),
+    BENCH_CASE(Vec3Min),
+    BENCH_CASE(Vec3Angle),
+    BENCH_CASE(Vec3Dot),
+    BENCH_CASE(Vec3Cross),
+    BENCH_CASE(Vec3Project),
+    BENCH_CASE(Vec3Reject),
+    BENCH_CASE(Vec3Reflect),
+    BENCH_CASE(Vec3Lerp),
+    BENCH_CASE(Vec3Slerp),
+    BENCH_CASE(Vec3Nlerp),
+    BENCH_CASE(Vec4Floats),
+    BENCH_CASE(Vec4EqualApprox),
+    BENCH_CASE(Vec4Add),
+    BENCH_CASE(Vec4Sub),
+    BENCH_CASE(Vec4Scale),
+    BENCH_CASE(Vec4SqrLen),
+    BENCH_CASE(Vec4Len),
+    BENCH_CASE(Vec4Norm),
+    BENCH_CASE(Vec4Max),
+    BENCH_CASE(Vec4Min),
+    BENCH_CASE(Vec4Angle),
+    BENCH_CASE(Vec4Dot),
+    BENCH_CASE(Vec4Project),
+    BENCH_CASE(Vec4Reject),
+    BENCH_CASE(Vec4Reflect),
+    BENCH_CASE(Vec4Lerp),
+    BENCH_CASE(Vec4Slerp),
+    BENCH_CASE(Vec4Nlerp),
+    BENCH_CASE(Vec3SoAAdd),
+    BENCH_CASE(Vec3SoAScale),
+    BENCH_CASE(Vec3SoADot),
+    BENCH_CASE(Vec3SoACross),
+    BENCH_CASE(Vec3SoANorm),
+    BENCH_CASE(Vec3SoALerp),
+    BENCH_CASE(Mat4Floats),
+    BENCH_CASE(Mat4EqualApprox),
+    BENCH_CASE(Mat4Row),
+    BENCH_CASE(Mat4Col),
+    BENCH_CASE(Mat4Transpose),
+    BENCH_CASE(Mat4TransposeTo),
+    BENCH_CASE(Mat4Invert),
+    BENCH_CASE(Mat4Classify),
+    BENCH_CASE(Mat4InvertAffine),
+    BENCH_CASE(Mat4InvertRigid),
+    BENCH_CASE(Mat4InvertFast),
+    BENCH_CASE(Mat4InvertArray),
+    BENCH_CASE(Mat4Add),
+    BENCH_CASE(Mat4AddTo),
+    BENCH_CASE(Mat4Sub),
+    BENCH_CASE(Mat4SubTo),
+    BENCH_CASE(Mat4Scale),
+    BENCH_CASE(Mat4ScaleTo),
+    BENCH_CASE(Mat4Mul),
+    BENCH_CASE(Mat4MulTo),
+    BENCH_CASE(Mat4MulVec4),
+    BENCH_CASE(Mat4MulVec4To),
+    BENCH_CASE(Mat4MulVec4Array),
+    BENCH_CASE(Mat4MulPoint3Array),
+    BENCH_CASE(Mat4MulDir3Array),
+    BENCH_CASE(Mat4MulVec4Strided),
+    BENCH_CASE(Mat4MakeOrtho),
+    BENCH_CASE(Mat4MakePerspective),
+    BENCH_CASE(Mat4LookAt),
+    BENCH_CASE(QuatFloats),
+    BENCH_CASE(QuatMakeAngleAxis),
+    BENCH_CASE(QuatMakeFromTo),
+    BENCH_CASE(QuatGetAxis),
+    BENCH_CASE(QuatGetAngle),
+    BENCH_CASE(QuatGetImgPart),
+    BENCH_CASE(QuatGetRealPart),
+    BENCH_CASE(QuatEqualApprox),
+    BENCH_CASE(QuatAdd),
+    BENCH_CASE(QuatSub),
+    BENCH_CASE(QuatScale),
+    BENCH_CASE(QuatNeg),
+    BENCH_CASE(QuatSameOrientation),
+    BENCH_CASE(QuatDot),
+    BENCH_CASE(QuatSqrLen),
+    BENCH_CASE(QuatLen),
+    BENCH_CASE(QuatNorm),
+    BENCH_CASE(QuatConjugate),
+    BENCH_CASE(QuatInvert),
+    BENCH_CASE(QuatCross),
+    BENCH_CASE(QuatTransformVec3),
+    BENCH_CASE(QuatTransformVec3Strided),
+    BENCH_CASE(QuatTransformVec3Array),
+    BENCH_CASE(QuatTransformVec3Pairwise),
+    BENCH_CASE(QuatLerp),
+    BENCH_CASE(QuatNLerp),
+    BENCH_CASE(QuatSLerp),
+    BENCH_CASE(QuatLookRotation),
+    BENCH_CASE(QuatToMat4),
+    BENCH_CASE(Mat4ToQuat),
+    BENCH_CASE(TransformEqualApprox),
+    BENCH_CASE(TransformCombine),
+    BENCH_CASE(TransformCombineTo),
+    BENCH_CASE(TransformInverse),
+    BENCH_CASE(TransformInverseTo),
+    BENCH_CASE(TransformLerp),
+    BENCH_CASE(TransformToMat4),
+    BENCH_CASE(TransformToMat4To),
+    BENCH_CASE(Mat4ToTransform),
+    BENCH_CASE(TransformPoint),
+    BENCH_CASE(TransformVec3),
+    BENCH_CASE(TransformPointStrided),
+    BENCH_CASE(TransformVec3Strided),
+    BENCH_CASE(TransformPointArray),
+    BENCH_CASE(TransformVec3Array),
+    BENCH_CASE(TransformPointArrayToSoA),
+    BENCH_CASE(Mat3Invert),
+    BENCH_CASE(Mat3Mul),
+    BENCH_CASE(Mat3MulTo),
+    BENCH_CASE(Mat3TransformVec3),
+    BENCH_CASE(Mat3TransformVec3Array),
+    BENCH_CASE(QuatToMat3),
+    BENCH_CASE(Affine34Mul),
+    BENCH_CASE(Affine34MulTo),
+    BENCH_CASE(Affine34Invert),
+    BENCH_CASE(Affine34TransformPoint),
+    BENCH_CASE(Affine34TransformPointArray),
+    BENCH_CASE(TransformToAffine34),
+    BENCH_CASE(TransformToAffine34Array),
+    BENCH_CASE(DualQuatMul),
+    BENCH_CASE(DualQuatNorm),
+    BENCH_CASE(DualQuatBlend),
+    BENCH_CASE(DualQuatTransformPoint),
+    BENCH_CASE(Vec3x8Cross),
+    BENCH_CASE(Quatx8Cross),
+    BENCH_CASE(Quatx8TransformVec3x8),
+    BENCH_CASE(Mat4x8MulVec4x8),
+    BENCH_CASE(HierarchyUpdate),
+    BENCH_CASE(HierarchyUpdateParallel),
+    BENCH_CASE(SkinLinearMat4),
+    BENCH_CASE(SkinLinearAffine34),
+    BENCH_CASE(SkinDualQuat),
+    BENCH_CASE(ClipSample),
+    BENCH_CASE(PoseSoAMix),
+    BENCH_CASE(BeizerInterpolate),
+    BENCH_CASE(HermitInterpolate),
+    BENCH_CASE(BeizerInterpolateArray),
+    BENCH_CASE(HermitInterpolateArray),
+    BENCH_CASE(BeizerTessellate),
+    BENCH_CASE(HermitTessellate),
+    BENCH_CASE(BeizerArcParameter),
+    BENCH_CASE(SplineEvaluate),
+};
+
+typedef struct {
+  bool json;
+  const char* filter;
+  double minTime;
+  unsigned repeats;
+} BenchOptions;
+
+typedef struct {
+  double nsPerOp;
+  double opsPerSec;
+  double cyclesPerOp;
+} BenchResult;
+
+// Monotonic clock in seconds.
+static double BenchNow(void) {
+#if defined(_WIN32)
+  LARGE_INTEGER freq;
+  LARGE_INTEGER now;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&now);
+  return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Time stamp counter, zero when the platform does not expose one.
+static uint64_t BenchCycles(void) {
+#if XMATH_BENCH_HAS_TSC
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+static BenchResult BenchMeasure(BenchFn fn, const BenchOptions* options) {
+  // Grow the iteration count until a single run takes a tenth of min time.
+  size_t iters = BENCH_POOL_SIZE;
+  for (;;) {
+    double start = BenchNow();
+    fn(iters);
+    double elapsed = BenchNow() - start;
+    if (elapsed >= options->minTime / 10.0 || iters >= ((size_t)1 << 40)) {
+      double target = options->minTime / (elapsed > 0.0 ? elapsed : 1e-9);
+      size_t scaled = (size_t)((double)iters * target);
+      iters = scaled > iters ? scaled : iters;
+      break;
+    }
+    iters *= 2;
+  }
+  iters = (iters + BENCH_POOL_MASK) & ~(size_t)BENCH_POOL_MASK;
+
+  BenchResult best = {0};
+  for (unsigned r = 0; r < options->repeats; r++) {
+    uint64_t c0 = BenchCycles();
+    double t0 = BenchNow();
+    fn(iters);
+    double t1 = BenchNow();
+    uint64_t c1 = BenchCycles();
+
+    double ns = (t1 - t0) * 1e9 / (double)iters;
+    if (r == 0 || ns < best.nsPerOp) {
+      best.nsPerOp = ns;
+      best.opsPerSec = ns > 0.0 ? 1e9 / ns : 0.0;
+      best.cyclesPerOp = (double)(c1 - c0) / (double)iters;
+    }
+  }
+
+  return best;
+}
+
+static void BenchPrintUsage(const char* program) {
+  fprintf(stderr,
+          "usage: %s [--json] [--filter text] [--min-time ms] [--repeats n]\n"
+          "  --json          emit results as JSON\n"
+          "  --filter text   only run functions whose name contains text\n"
+          "  --min-time ms   minimum measured time per run (default 50)\n"
+          "  --repeats n     runs per benchmark, best is reported (default "
+          "3)\n",
+          program);
+}
+
+static bool BenchParseOptions(int argc, char** argv, BenchOptions* options) {
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (strcmp(arg, "--json") == 0) {
+      options->json = true;
+    } else if (strcmp(arg, "--filter") == 0 && hasValue) {
+      options->filter = argv[++i];
+    } else if (strcmp(arg, "--min-time") == 0 && hasValue) {
+      options->minTime = atof(argv[++i]) / 1000.0;
+    } else if (strcmp(arg, "--repeats") == 0 && hasValue) {
+      options->repeats = (unsigned)strtoul(argv[++i], NULL, 10);
+    } else {
+      return false;
+    }
+  }
+
+  return options->minTime > 0.0 && options->repeats > 0;
+}
+
+static void BenchReport(const BenchOptions* options,
+                        const char* name,
+                        const char* form,
+                        BenchResult result,
+                        bool first) {
+  if (options->json) {
+    printf("%s\n    {\"name\": \"%s\", \"form\": \"%s\", "
+           "\"ns_per_op\": %.4f, \"ops_per_sec\": %.1f, ",
+           first ? "" : ",", name, form, result.nsPerOp, result.opsPerSec);
+    if (XMATH_BENCH_HAS_TSC) {
+      printf("\"cycles_per_op\": %.3f}", result.cyclesPerOp);
+    } else {
+      printf("\"cycles_per_op\": null}");
+    }
+    return;
+  }
+
+  printf("%-24s %-7s %12.3f %16.0f", name, form, result.nsPerOp,
+         result.opsPerSec);
+  if (XMATH_BENCH_HAS_TSC) {
+    printf(" %12.2f\n", result.cyclesPerOp);
+  } else {
+    printf(" %12s\n", "-");
+  }
+}
+
+int main(int argc, char** argv) {
+  BenchOptions options = {
+      .json = false,
+      .filter = NULL,
+      .minTime = 0.05,
+      .repeats = 3,
+  };
+  if (!BenchParseOptions(argc, argv, &options)) {
+    BenchPrintUsage(argv[0]);
+    return 1;
+  }
+
+  if (!BenchSetup()) {
+    fprintf(stderr, "%s: could not allocate the input pools\n", argv[0]);
+    return 1;
+  }
+  if (options.json) {
+    printf("{\n  \"library\": \"xmath\",\n  \"version\": \"%s\",\n"
+           "  \"simd\": \"%s\",\n  \"tier\": \"%s\",\n"
+           "  \"results\": [",
+           XMATH_BENCH_VERSION, XMATH_SIMD_NAME,
+           CpuTierName(CpuTierActive()));
+  } else {
+    printf("%-24s %-7s %12s %16s %12s\n", "function", "form", "ns/op",
+           "ops/sec", "cycles/op");
+  }
+
+  bool first = true;
+  size_t count = sizeof(gCases) / sizeof(gCases[0]);
+  for (size_t i = 0; i < count; i++) {
+    const BenchCase* c = &gCases[i];
+    if (options.filter != NULL && strstr(c->name, options.filter) == NULL) {
+      continue;
+    }
+
+    BenchReport(&options, c->name, "scalar",
+                BenchMeasure(c->scalar, &options), first);
+    first = false;
+    BenchReport(&options, c->name, "batch", BenchMeasure(c->batch, &options),
+                first);
+    fflush(stdout);
+  }
+
+  if (options.json) {
+    printf("\n  ]\n}\n");
+  }
+
+  return 0;
+}